@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Dijkstra.h"
+#include "Graph.h"
+#include "Partition.h"
+
+// Arc-flags (Lauther; Möhring et al.). Vertices are split into regions and
+// every arc carries one bit per region, set when the arc starts a shortest
+// path into that region. A query relaxes only arcs flagged for the target's
+// region. Flags are filled from a backward shortest-path tree per boundary
+// vertex (one with an arc entering its region from outside), plus every arc
+// whose head lies in the region.
+class ArcFlags {
+public:
+    // Flags share the arc's padding word, so at most 32 regions.
+    static constexpr std::size_t kMaxRegions = 32;
+
+    ArcFlags() = default;
+
+    // Backward trees run on `queue`; the partition is seeded from `seed`.
+    static ArcFlags build(const Graph& graph, std::size_t regions, PartitionMethod method, DijkstraQueue& queue,
+                          std::uint32_t seed);
+
+    // Dijkstra from source over arcs flagged for target's region, stopping
+    // when target is settled. Reuses internal scratch, so one instance must
+    // not be queried from two threads at once.
+    PointToPointResult query(int source, int target, DijkstraQueue& queue) const;
+
+    std::size_t node_count() const { return region_.size(); }
+    std::size_t region_count() const { return region_count_; }
+    std::size_t boundary_count() const { return boundary_count_; }
+    int region(int vertex) const { return region_[static_cast<std::size_t>(vertex)]; }
+    // Mean fraction of regions flagged per arc.
+    double flag_density() const;
+
+private:
+    // Same 16 bytes as GraphEdge: the flags fill its padding.
+    struct Arc {
+        int to = -1;
+        std::uint32_t flags = 0;
+        long long weight = 0;
+    };
+
+    std::vector<std::uint8_t> region_;
+    std::size_t region_count_ = 0;
+    std::size_t boundary_count_ = 0;
+    std::vector<std::size_t> offsets_;
+    std::vector<Arc> arcs_;
+    mutable std::vector<long long> distances_;
+    mutable std::vector<int> parents_;
+    mutable std::vector<int> touched_;
+};
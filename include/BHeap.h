@@ -0,0 +1,305 @@
+#pragma once
+
+#include "HeapHandle.h"
+#include "HeapStats.h"
+#include "PriorityQueue.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// std::allocator replacement that aligns every array to Alignment bytes.
+template <typename T, std::size_t Alignment>
+struct AlignedArrayAllocator {
+    using value_type = T;
+    template <typename U>
+    struct rebind {
+        using other = AlignedArrayAllocator<U, Alignment>;
+    };
+
+    AlignedArrayAllocator() = default;
+    template <typename U>
+    AlignedArrayAllocator(const AlignedArrayAllocator<U, Alignment>&) {}
+
+    T* allocate(std::size_t count) {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{Alignment}));
+    }
+    void deallocate(T* p, std::size_t) { ::operator delete(p, std::align_val_t{Alignment}); }
+
+    template <typename U>
+    bool operator==(const AlignedArrayAllocator<U, Alignment>&) const { return true; }
+    template <typename U>
+    bool operator!=(const AlignedArrayAllocator<U, Alignment>&) const { return false; }
+};
+
+// Binary heap in B-heap layout: nodes are stored inline and the tree is cut
+// into subtrees of height kBlockHeight, each packed into one BlockBytes block
+// (a page by default; 64 gives cache-line blocks). A root-to-leaf path then
+// crosses one block per kBlockHeight levels instead of a new page per level
+// once the heap outgrows the cache. Each block's bottom level has two child
+// blocks per node, so the blocks themselves form a 2^kBlockHeight-ary tree
+// filled in order; the last slot of every block is padding.
+template <typename Key = long long, typename Value = int, typename Compare = std::less<Key>,
+          typename Stats = FullStats, std::size_t BlockBytes = 4096>
+class BHeap : public PriorityQueue<Key, Value, Compare>
+{
+public:
+    using Base = PriorityQueue<Key, Value, Compare>;
+    using Position = std::uint32_t;
+    static_assert((BlockBytes & (BlockBytes - 1)) == 0, "BlockBytes must be a power of two");
+
+    struct Node {
+        Key key;
+        Value value;
+        std::uint32_t slot;
+    };
+
+    // Largest power-of-two node count that fits in a block.
+    static constexpr std::size_t block_height() {
+        std::size_t height = 1;
+        while ((std::size_t{2} << height) * sizeof(Node) <= BlockBytes) ++height;
+        return height;
+    }
+
+    static constexpr std::size_t kBlockHeight = block_height();
+    static constexpr std::size_t kBlockSlots = std::size_t{1} << kBlockHeight;
+    static constexpr std::size_t kBlockNodes = kBlockSlots - 1;
+    static constexpr Position kFirstBlockLeaf = static_cast<Position>(kBlockSlots / 2 - 1);
+    static constexpr std::size_t kAlignment = std::max<std::size_t>(BlockBytes, alignof(Node));
+
+    // Node plus its handle-table entry.
+    static constexpr std::size_t kNodeBytes = sizeof(Node) + sizeof(Position);
+
+    BHeap();
+    explicit BHeap(const Compare& compare);
+
+    HeapHandle insert(Key key, Value value) override;
+    std::pair<Key, Value> extract_min() override;
+    std::pair<Key, Value> peek_min() const override;
+    void decrease_key(HeapHandle handle, Key new_key) override;
+    void merge(Base& other) override;
+    bool is_empty() const override;
+    void clear() override;
+    const HeapStructureStats& structure_stats() const { return stats_.stats(); }
+    const AllocationStats& allocation_stats() const { return alloc_stats_; }
+
+private:
+    static constexpr Position kNone = HeapHandle::kInvalidSlot;
+
+    // Position of the index-th node in fill order.
+    static Position position_of(std::size_t index) {
+        return static_cast<Position>((index / kBlockNodes) * kBlockSlots + index % kBlockNodes);
+    }
+    static Position parent(Position p);
+    static Position first_child(Position p);
+    static Position second_child(Position p);
+    bool occupied(Position p) const {
+        return (p / kBlockSlots) * kBlockNodes + p % kBlockSlots < size_;
+    }
+
+    void place(Position p, const Node& node);
+    void sift_up(Position p);
+    void sift_down(Position p);
+    void ensure_slot(Position p);
+    std::size_t depth_of(Position p) const;
+    void update_size_metrics();
+
+    std::vector<Node, AlignedArrayAllocator<Node, kAlignment>> nodes_;
+    std::size_t size_ = 0;
+    HandleSlots<Position> positions_; // handle slot -> position in nodes_
+    Stats stats_;
+    AllocationStats alloc_stats_{};
+    Compare compare_;
+};
+
+template <typename Key, typename Value, typename Compare, typename Stats, std::size_t BlockBytes>
+BHeap<Key, Value, Compare, Stats, BlockBytes>::BHeap() : BHeap(Compare()) {}
+
+template <typename Key, typename Value, typename Compare, typename Stats, std::size_t BlockBytes>
+BHeap<Key, Value, Compare, Stats, BlockBytes>::BHeap(const Compare& compare) : compare_(compare) {}
+
+template <typename Key, typename Value, typename Compare, typename Stats, std::size_t BlockBytes>
+auto BHeap<Key, Value, Compare, Stats, BlockBytes>::parent(Position p) -> Position {
+    const Position local = p % kBlockSlots;
+    const Position block = p / kBlockSlots;
+    if (local > 0) return block * kBlockSlots + (local - 1) / 2;
+    if (block == 0) return kNone;
+    const Position parent_block = (block - 1) / kBlockSlots;
+    const Position child_rank = (block - 1) % kBlockSlots;
+    return parent_block * kBlockSlots + kFirstBlockLeaf + child_rank / 2;
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats, std::size_t BlockBytes>
+auto BHeap<Key, Value, Compare, Stats, BlockBytes>::first_child(Position p) -> Position {
+    const Position local = p % kBlockSlots;
+    const Position block = p / kBlockSlots;
+    if (local < kFirstBlockLeaf) return block * kBlockSlots + 2 * local + 1;
+    const Position child_block = block * kBlockSlots + 1 + 2 * (local - kFirstBlockLeaf);
+    return child_block * kBlockSlots;
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats, std::size_t BlockBytes>
+auto BHeap<Key, Value, Compare, Stats, BlockBytes>::second_child(Position p) -> Position {
+    const Position local = p % kBlockSlots;
+    if (local < kFirstBlockLeaf) return first_child(p) + 1;
+    return first_child(p) + kBlockSlots;
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats, std::size_t BlockBytes>
+bool BHeap<Key, Value, Compare, Stats, BlockBytes>::is_empty() const {
+    return size_ == 0;
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats, std::size_t BlockBytes>
+void BHeap<Key, Value, Compare, Stats, BlockBytes>::clear() {
+    nodes_.clear();
+    size_ = 0;
+    positions_.clear();
+    stats_.reset();
+    alloc_stats_.allocations = alloc_stats_.deallocations = alloc_stats_.system_allocations = 0;
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats, std::size_t BlockBytes>
+void BHeap<Key, Value, Compare, Stats, BlockBytes>::ensure_slot(Position p) {
+    if (p < nodes_.size()) return;
+    // Whole blocks at a time, so every block starts on a block boundary.
+    const std::size_t needed = (static_cast<std::size_t>(p) / kBlockSlots + 1) * kBlockSlots;
+    if (needed > nodes_.capacity()) {
+        alloc_stats_.system_allocations++;
+        nodes_.reserve(std::max(needed, nodes_.capacity() * 2));
+        alloc_stats_.reserved_bytes = nodes_.capacity() * sizeof(Node);
+        alloc_stats_.max_reserved_bytes = std::max(alloc_stats_.max_reserved_bytes, alloc_stats_.reserved_bytes);
+    }
+    nodes_.resize(needed);
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats, std::size_t BlockBytes>
+void BHeap<Key, Value, Compare, Stats, BlockBytes>::place(Position p, const Node& node) {
+    nodes_[p] = node;
+    positions_[node.slot] = p;
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats, std::size_t BlockBytes>
+HeapHandle BHeap<Key, Value, Compare, Stats, BlockBytes>::insert(Key key, Value value) {
+    const Position p = position_of(size_);
+    ensure_slot(p);
+    const HeapHandle handle = positions_.acquire(p);
+    nodes_[p] = Node{key, value, handle.slot};
+    size_++;
+    alloc_stats_.allocations++;
+    sift_up(p);
+    update_size_metrics();
+    return handle;
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats, std::size_t BlockBytes>
+std::pair<Key, Value> BHeap<Key, Value, Compare, Stats, BlockBytes>::extract_min() {
+    if (size_ == 0) throw std::runtime_error("extract_min from empty BHeap");
+    const Node root = nodes_[0];
+    positions_.release(root.slot);
+    alloc_stats_.deallocations++;
+
+    const Position last = position_of(--size_);
+    if (size_ > 0) {
+        place(0, nodes_[last]);
+        sift_down(0);
+    }
+    update_size_metrics();
+    return {root.key, root.value};
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats, std::size_t BlockBytes>
+std::pair<Key, Value> BHeap<Key, Value, Compare, Stats, BlockBytes>::peek_min() const {
+    if (size_ == 0) throw std::runtime_error("peek_min from empty BHeap");
+    return {nodes_[0].key, nodes_[0].value};
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats, std::size_t BlockBytes>
+void BHeap<Key, Value, Compare, Stats, BlockBytes>::decrease_key(HeapHandle handle, Key new_key) {
+    const Position p = positions_.resolve(handle);
+    if (compare_(nodes_[p].key, new_key)) throw std::invalid_argument("new_key is greater than current key");
+    nodes_[p].key = new_key;
+    sift_up(p);
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats, std::size_t BlockBytes>
+void BHeap<Key, Value, Compare, Stats, BlockBytes>::sift_up(Position p) {
+    const Node node = nodes_[p];
+    while (p > 0) {
+        const Position up = parent(p);
+        if (!compare_(node.key, nodes_[up].key)) break;
+        place(p, nodes_[up]);
+        stats_.on_link();
+        p = up;
+    }
+    place(p, node);
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats, std::size_t BlockBytes>
+void BHeap<Key, Value, Compare, Stats, BlockBytes>::sift_down(Position p) {
+    const Node node = nodes_[p];
+    bool rearranged = false;
+    while (true) {
+        const Position left = first_child(p);
+        if (!occupied(left)) break;
+        Position smallest = left;
+        const Position right = second_child(p);
+        if (occupied(right) && compare_(nodes_[right].key, nodes_[left].key)) smallest = right;
+        if (!compare_(nodes_[smallest].key, node.key)) break;
+        place(p, nodes_[smallest]);
+        stats_.on_link();
+        p = smallest;
+        rearranged = true;
+    }
+    place(p, node);
+    if (rearranged) {
+        stats_.on_consolidation();
+    }
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats, std::size_t BlockBytes>
+void BHeap<Key, Value, Compare, Stats, BlockBytes>::merge(Base& other_base) {
+    auto* other = dynamic_cast<BHeap*>(&other_base);
+    if (!other) throw std::invalid_argument("merge requires another BHeap");
+    if (other == this || other->size_ == 0) return;
+
+    const std::uint32_t slot_offset = positions_.absorb(other->positions_);
+    for (std::size_t i = 0; i < other->size_; ++i) {
+        Node node = other->nodes_[position_of(i)];
+        node.slot += slot_offset;
+        const Position p = position_of(size_);
+        ensure_slot(p);
+        place(p, node);
+        size_++;
+    }
+    alloc_stats_.allocations += other->size_;
+    other->clear();
+
+    for (std::size_t i = size_; i-- > 0;) {
+        sift_down(position_of(i));
+    }
+    update_size_metrics();
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats, std::size_t BlockBytes>
+std::size_t BHeap<Key, Value, Compare, Stats, BlockBytes>::depth_of(Position p) const {
+    std::size_t depth = 1;
+    for (; p != 0; p = parent(p)) ++depth;
+    return depth;
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats, std::size_t BlockBytes>
+void BHeap<Key, Value, Compare, Stats, BlockBytes>::update_size_metrics() {
+    if (!stats_.should_sample()) return;
+    stats_.on_size(size_, nodes_.capacity() * sizeof(Node) + positions_.capacity_bytes());
+    stats_.on_height(size_ > 0 ? depth_of(position_of(size_ - 1)) : 0);
+    stats_.on_roots(size_ > 0 ? 1u : 0u);
+}
+
+// The instantiations used by the driver are compiled once in BHeap.cpp.
+extern template class BHeap<long long, int>;
+extern template class BHeap<std::uint32_t, int>;
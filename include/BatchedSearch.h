@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Dijkstra.h"
+#include "Graph.h"
+
+// Most sources one batched search runs at once.
+constexpr std::size_t kMaxBatchSources = 16;
+
+// Distances from every source of a batch, vertex-major: the lanes of one
+// vertex are adjacent, so a relaxation touches one or two cache lines.
+struct BatchedResult {
+    std::size_t lanes = 0;           // 8 or 16; lanes past the sources stay unreached
+    std::vector<long long> distances; // distances[v * lanes + i] from the i-th source
+    std::size_t scans = 0;           // vertices scanned, rescans included
+    QueueMetrics metrics;
+    HeapStructureStats structure;
+    AllocationStats allocation;
+};
+
+// Label-correcting search from up to kMaxBatchSources sources over one
+// shared frontier. A vertex is queued once for all the lanes it improved,
+// keyed by the smallest of them, and a scan relaxes every lane of an arc
+// with vector adds and mins (AVX2 when the CPU has it), so the adjacency is
+// streamed once per scan rather than once per source. Nearby sources share
+// most scans; a vertex is rescanned when a lane improves after its scan.
+// The queue only ever sees push, and superseded entries are skipped, so any
+// heap works except the adaptive queue, which decreases on push. result
+// keeps its capacity across calls. No parents are recorded.
+void run_batched_dijkstra(const Graph& graph, const int* sources, std::size_t count, DijkstraQueue& queue,
+                          BatchedResult& result);
+
+// Whether the lane updates run on AVX2 on this CPU.
+bool batched_search_uses_simd();
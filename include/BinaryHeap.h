@@ -1,36 +1,54 @@
 #pragma once
+#include "HeapAllocators.h"
 #include "HeapStats.h"
 #include "PriorityQueue.h"
 #include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <vector>
 #include <utility>
 #include <stdexcept>
 
-// Node handle type used by BinaryHeap and exposed to clients for decrease_key
+// Element of a BinaryHeap. Clients hold its handle slot; the slot table maps
+// the slot to the node's current position in the heap array.
+template <typename Key = long long, typename Value = int>
 struct BinaryHeapNode {
-    long long key;
-    int value;
-    int index; // position in heap array
+    Key key;
+    Value value;
+    std::uint32_t slot;
 };
 
-class BinaryHeap : public PriorityQueue<BinaryHeapNode>
+template <typename Key = long long, typename Value = int, typename Compare = std::less<Key>,
+          typename Alloc = NewDeleteAllocator, typename Stats = FullStats>
+class BinaryHeap : public PriorityQueue<Key, Value, Compare>
 {
 public:
+    using Node = BinaryHeapNode<Key, Value>;
+    using Base = PriorityQueue<Key, Value, Compare>;
+
+    // Node plus its handle-table entry.
+    static constexpr std::size_t kNodeBytes = sizeof(Node) + sizeof(int);
+
     BinaryHeap();
+    explicit BinaryHeap(const Compare& compare);
     ~BinaryHeap() override;
 
-    BinaryHeapNode* insert(long long key, int value) override;
-    std::pair<long long, int> extract_min() override;
-    std::pair<long long, int> peek_min() const override;
-    void decrease_key(BinaryHeapNode* node, long long new_key) override;
-    void merge(PriorityQueue& other) override;
+    HeapHandle insert(Key key, Value value) override;
+    std::pair<Key, Value> extract_min() override;
+    std::pair<Key, Value> peek_min() const override;
+    void decrease_key(HeapHandle handle, Key new_key) override;
+    void merge(Base& other) override;
     bool is_empty() const override;
-    const HeapStructureStats& structure_stats() const { return stats_; }
+    void clear() override;
+    const HeapStructureStats& structure_stats() const { return stats_.stats(); }
+    const AllocationStats& allocation_stats() const { return alloc_.stats(); }
 
 private:
-    std::vector<BinaryHeapNode*> heap_; // binary heap storing pointers to nodes
-    HeapStructureStats stats_{};
-    std::size_t live_nodes_ = 0;
+    std::vector<Node*> heap_; // binary heap storing pointers to nodes
+    HandleSlots<int> positions_; // handle slot -> index in heap_
+    Stats stats_;
+    Compare compare_;
+    Alloc alloc_;
 
     static int parent(int i) { return (i - 1) / 2; }
     static int left(int i) { return 2 * i + 1; }
@@ -42,3 +60,174 @@ private:
     void swap_at(int i, int j);
     void update_size_metrics();
 };
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+BinaryHeap<Key, Value, Compare, Alloc, Stats>::BinaryHeap() : compare_() {}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+BinaryHeap<Key, Value, Compare, Alloc, Stats>::BinaryHeap(const Compare& compare) : compare_(compare) {}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+BinaryHeap<Key, Value, Compare, Alloc, Stats>::~BinaryHeap() {
+    if constexpr (!releases_nodes_in_bulk<Alloc, Node>()) {
+        for (auto* p : heap_) destroy_node(alloc_, p);
+    }
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+HeapHandle BinaryHeap<Key, Value, Compare, Alloc, Stats>::insert(Key key, Value value) {
+    const int index = static_cast<int>(heap_.size());
+    const HeapHandle handle = positions_.acquire(index);
+    auto* node = allocate_node<Node>(alloc_, key, value, handle.slot);
+    heap_.push_back(node);
+    heapify_up(index);
+    update_size_metrics();
+    return handle;
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+std::pair<Key, Value> BinaryHeap<Key, Value, Compare, Alloc, Stats>::extract_min() {
+    if (heap_.empty()) throw std::runtime_error("extract_min from empty heap");
+    Node* root = heap_.front();
+    std::pair<Key, Value> result(root->key, root->value);
+
+    Node* last = heap_.back();
+    heap_.pop_back();
+    if (!heap_.empty()) {
+        heap_[0] = last;
+        positions_[last->slot] = 0;
+        heapify_down(0);
+    }
+
+    positions_.release(root->slot);
+    destroy_node(alloc_, root);
+    update_size_metrics();
+    return result;
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+std::pair<Key, Value> BinaryHeap<Key, Value, Compare, Alloc, Stats>::peek_min() const {
+    if (heap_.empty()) throw std::runtime_error("peek_min from empty heap");
+    Node* root = heap_.front();
+    return {root->key, root->value};
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void BinaryHeap<Key, Value, Compare, Alloc, Stats>::decrease_key(HeapHandle handle, Key new_key) {
+    const int index = positions_.resolve(handle);
+    Node* node = heap_[static_cast<std::size_t>(index)];
+    if (compare_(node->key, new_key)) throw std::invalid_argument("new_key is greater than current key");
+    node->key = new_key;
+    heapify_up(index);
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void BinaryHeap<Key, Value, Compare, Alloc, Stats>::merge(Base& other_base) {
+    auto* other = dynamic_cast<BinaryHeap*>(&other_base);
+    if (!other) throw std::invalid_argument("merge requires another BinaryHeap");
+    if (other == this || other->heap_.empty()) return;
+
+    const std::uint32_t slot_offset = positions_.absorb(other->positions_);
+    const std::size_t first_added = heap_.size();
+    heap_.reserve(heap_.size() + other->heap_.size());
+    for (auto* node : other->heap_) {
+        node->slot += slot_offset;
+        positions_[node->slot] = static_cast<int>(heap_.size());
+        heap_.push_back(node);
+    }
+    other->heap_.clear();
+    alloc_.absorb(other->alloc_);
+
+    // Sifting the m new nodes up costs O(m log n), a bottom-up rebuild
+    // O(n + m); melding a small heap into a large one takes the former.
+    const std::size_t added = heap_.size() - first_added;
+    std::size_t depth = 1;
+    while ((std::size_t{1} << depth) <= heap_.size()) ++depth;
+    if (added * depth < heap_.size()) {
+        for (std::size_t i = first_added; i < heap_.size(); ++i) {
+            heapify_up(static_cast<int>(i));
+        }
+    } else {
+        for (int i = static_cast<int>(heap_.size() / 2) - 1; i >= 0; --i) {
+            heapify_down(i);
+        }
+    }
+    update_size_metrics();
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+bool BinaryHeap<Key, Value, Compare, Alloc, Stats>::is_empty() const {
+    return heap_.empty();
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void BinaryHeap<Key, Value, Compare, Alloc, Stats>::clear() {
+    if constexpr (!releases_nodes_in_bulk<Alloc, Node>()) {
+        for (auto* p : heap_) destroy_node(alloc_, p);
+    }
+    heap_.clear();
+    positions_.clear();
+    stats_.reset();
+    alloc_.reset();
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void BinaryHeap<Key, Value, Compare, Alloc, Stats>::swap_at(int i, int j) {
+    std::swap(heap_[i], heap_[j]);
+    positions_[heap_[i]->slot] = i;
+    positions_[heap_[j]->slot] = j;
+    stats_.on_link();
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void BinaryHeap<Key, Value, Compare, Alloc, Stats>::heapify_up(int i) {
+    while (i > 0) {
+        int p = parent(i);
+        if (!compare_(heap_[i]->key, heap_[p]->key)) break;
+        swap_at(p, i);
+        i = p;
+    }
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void BinaryHeap<Key, Value, Compare, Alloc, Stats>::heapify_down(int i) {
+    bool rearranged = false;
+    int n = static_cast<int>(heap_.size());
+    while (true) {
+        int l = left(i), r = right(i);
+        int smallest = i;
+        if (l < n && compare_(heap_[l]->key, heap_[smallest]->key)) smallest = l;
+        if (r < n && compare_(heap_[r]->key, heap_[smallest]->key)) smallest = r;
+        if (smallest == i) break;
+        swap_at(i, smallest);
+        i = smallest;
+        rearranged = true;
+    }
+    if (rearranged) {
+        stats_.on_consolidation();
+    }
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+std::size_t BinaryHeap<Key, Value, Compare, Alloc, Stats>::compute_height(std::size_t nodes) {
+    if (nodes == 0) return 0;
+    std::size_t height = 0;
+    while (nodes > 0) {
+        nodes >>= 1U;
+        ++height;
+    }
+    return height;
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void BinaryHeap<Key, Value, Compare, Alloc, Stats>::update_size_metrics() {
+    if (!stats_.should_sample()) return;
+    const std::size_t nodes = heap_.size();
+    stats_.on_size(nodes, nodes * sizeof(Node) + heap_.capacity() * sizeof(Node*) + positions_.capacity_bytes());
+    stats_.on_height(compute_height(nodes));
+    stats_.on_roots(nodes > 0 ? 1u : 0u);
+}
+
+// The instantiations used by the driver are compiled once in BinaryHeap.cpp.
+extern template class BinaryHeap<long long, int>;
+extern template class BinaryHeap<std::uint32_t, int>;
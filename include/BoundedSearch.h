@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Dijkstra.h"
+#include "Graph.h"
+
+// When a local search may stop. Unset rules are ignored; the search ends at
+// the first rule met, or when the reachable vertices run out.
+struct SearchBounds {
+    long long radius = -1;    // settle nothing farther than this; -1 for no bound
+    std::vector<int> targets; // stop once every target is settled
+    std::size_t nearest = 0;  // stop after this many settled, source included; 0 for no bound
+};
+
+// Only the vertices the search settled, in order of distance.
+struct BoundedResult {
+    std::vector<int> vertices;
+    std::vector<long long> distances;
+    std::vector<int> parents;
+    std::size_t touched = 0; // vertices given a label, settled or not
+};
+
+// Dijkstra with early termination for isochrones, many-target and
+// k-nearest queries. Labels live in arrays sized once per graph and are
+// cleared through the touched list, so a query costs what it explores
+// rather than O(n). One instance must not run two searches at once.
+class BoundedSearch {
+public:
+    explicit BoundedSearch(const Graph& graph);
+
+    BoundedResult run(int source, const SearchBounds& bounds, DijkstraQueue& queue);
+
+private:
+    void search(int source, const SearchBounds& bounds, DijkstraQueue& queue, BoundedResult& result);
+    // Returns the label arrays to their all-clear state, also after a throw.
+    void clear_labels(const SearchBounds& bounds);
+
+    const Graph& graph_;
+    std::vector<long long> distances_;
+    std::vector<int> parents_;
+    std::vector<char> targets_;
+    std::vector<int> touched_;
+};
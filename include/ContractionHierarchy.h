@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Dijkstra.h"
+#include "Graph.h"
+
+// Contraction hierarchy (Geisberger et al.). Vertices are contracted one at
+// a time in order of edge difference; contracting v adds a shortcut u -> w
+// for each in/out neighbor pair unless a witness search finds a path from u
+// to w avoiding v that is no longer. A query then searches only upward in
+// rank from both ends.
+class ContractionHierarchy {
+public:
+    struct BuildStats {
+        std::size_t shortcuts = 0;
+        std::size_t witness_searches = 0;
+        std::size_t witness_settled = 0;
+    };
+
+    ContractionHierarchy() = default;
+
+    // Witness searches run on `queue`, so preprocessing time depends on the
+    // heap behind it.
+    static ContractionHierarchy build(const Graph& graph, DijkstraQueue& queue);
+
+    // Bidirectional upward search with stall-on-demand; the path is unpacked
+    // to original edges. Reuses internal scratch, so one hierarchy must not
+    // be queried from two threads at once.
+    PointToPointResult query(int source, int target, DijkstraQueue& queue_fwd, DijkstraQueue& queue_bwd) const;
+
+    std::size_t node_count() const { return rank_.size(); }
+    std::size_t upward_arc_count() const { return forward_arcs_.size() + backward_arcs_.size(); }
+    const BuildStats& build_stats() const { return stats_; }
+    int rank(int vertex) const { return rank_[static_cast<std::size_t>(vertex)]; }
+
+private:
+    // An arc toward a higher-ranked vertex. middle is the contracted vertex a
+    // shortcut bypasses, or -1 for an original edge.
+    struct Arc {
+        int to = -1;
+        long long weight = 0;
+        int middle = -1;
+    };
+
+    // Arc ids number forward arcs first, then backward ones. A shortcut's
+    // two halves are resolved at build time so unpacking follows ids.
+    struct Unpacking {
+        int tail = -1;
+        int head = -1;
+        int first = -1; // tail -> middle, -1 for an original edge
+        int second = -1; // middle -> head
+    };
+
+    // Per-direction query state, reset through the touched list. parents
+    // holds the id of the arc each vertex was reached by.
+    struct Side {
+        std::vector<long long> distances;
+        std::vector<int> parents;
+        std::vector<int> touched;
+    };
+
+    const Arc* forward_begin(int vertex) const;
+    const Arc* forward_end(int vertex) const;
+    const Arc* backward_begin(int vertex) const;
+    const Arc* backward_end(int vertex) const;
+    int arc_id(const Arc* arc) const;
+    int find_arc(int tail, int head) const;
+    void unpack(int arc, std::vector<int>& path) const;
+    void search(int source, int target, DijkstraQueue& queue_fwd, DijkstraQueue& queue_bwd,
+                PointToPointResult& result) const;
+    // Returns sides_ to its all-clear state, also after a throw.
+    void clear_sides() const;
+
+    std::vector<int> rank_;
+    // forward: arcs v -> w; backward: arcs w -> v stored at v with to = w.
+    // Both hold only arcs whose far end outranks v.
+    std::vector<std::size_t> forward_offsets_;
+    std::vector<Arc> forward_arcs_;
+    std::vector<std::size_t> backward_offsets_;
+    std::vector<Arc> backward_arcs_;
+    std::vector<Unpacking> unpacking_;
+    BuildStats stats_;
+    mutable Side sides_[2];
+    mutable std::vector<int> unpack_stack_;
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Dijkstra.h"
+#include "Graph.h"
+
+// Delta-stepping (Meyer & Sanders). Tentative distances fall into buckets
+// of width delta; the lowest bucket is emptied in rounds that relax only
+// light edges (weight <= delta), since those can refill it, and the heavy
+// edges of everything it held are relaxed once at the end. Each thread owns
+// a block of vertices with their buckets and writes only their labels;
+// relaxations of another thread's vertex are posted to it between barriers.
+class DeltaStepping {
+public:
+    struct RunStats {
+        std::size_t buckets = 0;      // buckets emptied
+        std::size_t light_rounds = 0; // light-edge rounds over all buckets
+        std::size_t requests = 0;     // relaxations posted
+    };
+
+    DeltaStepping() = default;
+
+    // Copies the arcs with light ones first. delta 0 uses suggest_delta().
+    static DeltaStepping build(const Graph& graph, long long delta = 0);
+
+    // Eight times the mean edge weight, raised if needed so the live
+    // buckets fit in 2^16 slots.
+    static long long suggest_delta(const Graph& graph);
+
+    // Distances match run_dijkstra. Parents form a shortest-path tree, but
+    // among equally short paths may pick another predecessor. metrics count
+    // bucket inserts as inserts and removals as extracts, with entries
+    // superseded by a shorter distance as stale extracts.
+    DijkstraResult run(int source, std::size_t threads, RunStats* stats = nullptr) const;
+
+    std::size_t node_count() const { return offsets_.empty() ? 0 : offsets_.size() - 1; }
+    long long delta() const { return delta_; }
+    std::size_t light_edge_count() const { return light_edges_; }
+
+private:
+    long long delta_ = 1;
+    std::size_t slots_ = 1; // cyclic bucket array size, a power of two
+    std::size_t light_edges_ = 0;
+    // Out-arcs of v are arcs_[offsets_[v], offsets_[v + 1]), light ones
+    // before heavy_begin_[v].
+    std::vector<std::size_t> offsets_;
+    std::vector<std::size_t> heavy_begin_;
+    std::vector<GraphEdge> arcs_;
+};
@@ -1,12 +1,15 @@
 #pragma once
 
 #include <cstddef>
+#include <functional>
 #include <memory>
 #include <utility>
 #include <vector>
 
 #include "Graph.h"
+#include "HeapAllocators.h"
 #include "HeapStats.h"
+#include "LatencyHistogram.h"
 
 struct QueueMetrics {
     std::size_t insert_count = 0;
@@ -15,6 +18,17 @@ struct QueueMetrics {
     long long insert_time_ns = 0;
     long long decrease_time_ns = 0;
     long long extract_time_ns = 0;
+    long long reset_time_ns = 0; // preparing the queue for this run
+    std::size_t migration_count = 0; // adaptive queue: heap switches this run
+    long long migration_time_ns = 0; // adaptive queue: draining and rebuilding
+    // Entries extracted after their vertex was settled at a smaller key, and
+    // the most such superseded entries queued at once. Zero with decrease-key.
+    std::size_t stale_extract_count = 0;
+    std::size_t peak_stale_entries = 0;
+    // Per-op latency distributions, for tails the averages above hide.
+    LatencyHistogram insert_latency;
+    LatencyHistogram decrease_latency;
+    LatencyHistogram extract_latency;
 };
 
 struct DijkstraResult {
@@ -22,12 +36,35 @@ struct DijkstraResult {
     std::vector<int> parents;
     QueueMetrics metrics;
     HeapStructureStats structure;
+    AllocationStats allocation;
 };
 
 enum class HeapSelection {
     kBinary = 1,
     kFibonacci = 2,
-    kHollow = 3
+    kHollow = 3,
+    kFibonacciIndexed = 4,
+    kHollowIndexed = 5,
+    // Starts on the binary heap and migrates to the indexed Fibonacci heap
+    // while the recent op mix is decrease-heavy over a large frontier.
+    kAdaptive = 6,
+    // SIMD-scanned flat array for small frontiers, spilling to a binary heap.
+    kFlat = 7,
+    // Binary heap with page-blocked (B-heap) node layout.
+    kBHeap = 8,
+    // Kaplan-Tarjan thin heap and Takaoka 2-3 heap: Fibonacci-heap bounds
+    // with different tree shapes, for comparison against kFibonacci.
+    kThin = 9,
+    kTwoThree = 10,
+    // Fibonacci heap with consolidation spread over operations, bounding
+    // the work in any single extract_min.
+    kFibonacciBounded = 11,
+    // Leftist and skew heaps: binary trees that meld in O(log n).
+    kLeftist = 12,
+    kSkew = 13,
+    // std::priority_queue with no decrease-key: every push is an insert and
+    // the search skips stale entries. Baseline for the lazy-insertion runs.
+    kStdPriorityQueue = 14
 };
 
 class DijkstraQueue {
@@ -35,12 +72,70 @@ public:
     virtual ~DijkstraQueue() = default;
     virtual void reset(std::size_t node_count) = 0;
     virtual void push_or_decrease(int vertex, long long key) = 0;
+    // Inserts a new entry even if vertex is already queued; the caller skips
+    // the superseded one when it surfaces. The adaptive queue, which tracks
+    // one handle per vertex, decreases instead.
+    virtual void push(int vertex, long long key) = 0;
     virtual std::pair<long long, int> extract_min() = 0;
     virtual bool empty() const = 0;
     virtual const QueueMetrics& metrics() const = 0;
     virtual const HeapStructureStats& structure_stats() const = 0;
+    virtual const AllocationStats& allocation_stats() const = 0;
 };
 
-std::unique_ptr<DijkstraQueue> make_queue_adapter(HeapSelection selection);
+// StatsPolicy::kNone compiles the heap's structural statistics out; use it
+// for timing runs and kFull when the structure report is wanted.
+std::unique_ptr<DijkstraQueue> make_queue_adapter(HeapSelection selection,
+                                                  AllocatorPolicy allocator = AllocatorPolicy::kNewDelete,
+                                                  StatsPolicy stats = StatsPolicy::kFull);
 
 DijkstraResult run_dijkstra(const Graph& graph, int source, DijkstraQueue& queue);
+
+// The same search into a caller-owned result whose vectors keep their
+// capacity, so repeated runs allocate nothing once they have grown.
+void run_dijkstra(const Graph& graph, int source, DijkstraQueue& queue, DijkstraResult& result);
+
+// Same search without decrease-key: an improved vertex is pushed again and
+// stale extracts are skipped. Metrics include the wasted extracts.
+DijkstraResult run_lazy_dijkstra(const Graph& graph, int source, DijkstraQueue& queue);
+
+// A source of a multi-source search, entered at distance offset (a depot's
+// dispatch delay, say).
+struct SearchSource {
+    int vertex = -1;
+    long long offset = 0;
+};
+
+// One search from every source at once: distances are to the nearest
+// source, offset included, and parents lead back to it. owners, if given,
+// receives per vertex the index in `sources` of that nearest source, or -1
+// when none reaches it: a graph Voronoi partition.
+DijkstraResult run_multi_source_dijkstra(const Graph& graph, const std::vector<SearchSource>& sources,
+                                         DijkstraQueue& queue, std::vector<int>* owners = nullptr);
+
+// One source-target query. settled counts vertices settled over every
+// search direction, the usual measure of query work.
+struct PointToPointResult {
+    long long distance = -1; // -1 when target is unreachable
+    std::vector<int> path;   // source..target, empty when unreachable
+    std::size_t settled = 0;
+};
+
+// Dijkstra from source that stops once target is settled.
+PointToPointResult run_point_to_point(const Graph& graph, int source, int target, DijkstraQueue& queue);
+
+// Searches forward from source and backward from target over the reverse
+// adjacency, always advancing the side with the smaller radius, and stops
+// once the two radii together reach the best path seen.
+PointToPointResult run_bidirectional(const Graph& graph, int source, int target, DijkstraQueue& queue_fwd,
+                                     DijkstraQueue& queue_bwd);
+
+// A* toward target, keyed by distance plus graph.distance_lower_bound to
+// target. The bound is consistent, so each vertex is settled once and the
+// search stops when target is. Requires graph.has_coordinates().
+PointToPointResult run_astar(const Graph& graph, int source, int target, DijkstraQueue& queue);
+
+// A* with a caller-supplied potential: a consistent lower bound on the
+// distance from a vertex to target. Each vertex's potential is asked once.
+PointToPointResult run_astar(const Graph& graph, int source, int target, DijkstraQueue& queue,
+                             const std::function<long long(int)>& potential);
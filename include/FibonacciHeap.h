@@ -1,48 +1,545 @@
 #pragma once
 
+#include "HeapAllocators.h"
 #include "HeapStats.h"
 #include "PriorityQueue.h"
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
+// Pointers lead so the narrower fields pack into the tail; with 64-bit keys
+// the handle slot fits in what used to be padding.
+template <typename Key = long long, typename Value = int>
 struct FibonacciHeapNode {
-	long long key;
-	int value;
 	FibonacciHeapNode* parent;
 	FibonacciHeapNode* child;
 	FibonacciHeapNode* left;
 	FibonacciHeapNode* right;
-	int degree;
-	bool mark;
+	Key key;
+	Value value;
 	int subtree_height;
+	std::uint32_t slot;
+	std::uint16_t degree;
+	bool mark;
 };
 
-class FibonacciHeap : public PriorityQueue<FibonacciHeapNode>
+// LinkBudget > 0 deamortizes extract_min. Every root an operation creates
+// is placed into a persistent degree table before the operation returns,
+// linking equal degrees as a binary counter carries, so between operations
+// the table holds every root, at most one per degree. extract_min then finds
+// the new minimum among O(log n) table slots instead of consolidating the
+// whole root list, and no call pays for work an earlier one left behind:
+// an operation costs O(log n) links per root it creates (the promoted
+// children of extract_min, the cuts of decrease_key). A meld places all of
+// the other heap's roots. Any positive LinkBudget selects this mode.
+template <typename Key = long long, typename Value = int, typename Compare = std::less<Key>,
+          typename Alloc = NewDeleteAllocator, typename Stats = FullStats, std::size_t LinkBudget = 0>
+class FibonacciHeap : public PriorityQueue<Key, Value, Compare>
 {
 public:
+	using Node = FibonacciHeapNode<Key, Value>;
+	using Base = PriorityQueue<Key, Value, Compare>;
+
+	// Node plus its handle-table entry.
+	static constexpr std::size_t kNodeBytes = sizeof(Node) + sizeof(Node*);
+	static constexpr bool kBounded = LinkBudget > 0;
+
 	FibonacciHeap();
+	explicit FibonacciHeap(const Compare& compare);
 	~FibonacciHeap() override;
 
-	FibonacciHeapNode* insert(long long key, int value) override;
-	std::pair<long long, int> extract_min() override;
-	std::pair<long long, int> peek_min() const override;
-	void decrease_key(FibonacciHeapNode* node, long long new_key) override;
-	void merge(PriorityQueue& other) override;
+	HeapHandle insert(Key key, Value value) override;
+	std::pair<Key, Value> extract_min() override;
+	std::pair<Key, Value> peek_min() const override;
+	void decrease_key(HeapHandle handle, Key new_key) override;
+	void merge(Base& other) override;
 	bool is_empty() const override;
-	const HeapStructureStats& structure_stats() const { return stats_; }
+	void clear() override;
+	const HeapStructureStats& structure_stats() const { return stats_.stats(); }
+	const AllocationStats& allocation_stats() const { return alloc_.stats(); }
 
 private:
-	FibonacciHeapNode* min_;
+	Node* min_;
 	std::size_t size_;
 	std::size_t root_count_ = 0;
-	HeapStructureStats stats_{};
+	HandleSlots<Node*> slots_;
+	Stats stats_;
+	Compare compare_;
+	Alloc alloc_;
+	// Bounded mode only: at most one root per degree, and the roots the
+	// current operation created, empty between operations.
+	std::vector<Node*> degree_table_;
+	std::vector<Node*> pending_;
 
-	void add_to_root_list(FibonacciHeapNode* node);
-	void remove_from_root_list(FibonacciHeapNode* node);
+	Node* make_node(Key key, Value value);
+	static void concatenate_root_lists(Node* a, Node* b);
+	void add_to_root_list(Node* node);
+	void remove_from_root_list(Node* node);
 	void consolidate();
-	void link_nodes(FibonacciHeapNode* child, FibonacciHeapNode* parent);
-	void cut(FibonacciHeapNode* node, FibonacciHeapNode* parent);
-	void cascading_cut(FibonacciHeapNode* node);
-	void delete_all(FibonacciHeapNode* node);
+	void settle();
+	void unsettle(Node* root);
+	void link_nodes(Node* child, Node* parent);
+	void cut(Node* node, Node* parent);
+	void cascading_cut(Node* node);
+	void delete_all(Node* node);
 	void update_size_metrics();
 	void note_tree_height(int subtree_height);
 };
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats, std::size_t LinkBudget>
+auto FibonacciHeap<Key, Value, Compare, Alloc, Stats, LinkBudget>::make_node(Key key, Value value) -> Node* {
+    auto* node = allocate_node<Node>(alloc_);
+    node->key = key;
+    node->value = value;
+    node->parent = nullptr;
+    node->child = nullptr;
+    node->left = node;
+    node->right = node;
+    node->degree = 0;
+    node->mark = false;
+    node->subtree_height = 0;
+    return node;
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats, std::size_t LinkBudget>
+void FibonacciHeap<Key, Value, Compare, Alloc, Stats, LinkBudget>::concatenate_root_lists(Node* a, Node* b) {
+    if (!a || !b) return;
+    Node* aRight = a->right;
+    Node* bLeft = b->left;
+
+    a->right = b;
+    b->left = a;
+    aRight->left = bLeft;
+    bLeft->right = aRight;
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats, std::size_t LinkBudget>
+FibonacciHeap<Key, Value, Compare, Alloc, Stats, LinkBudget>::FibonacciHeap() : min_(nullptr), size_(0), root_count_(0), compare_() {}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats, std::size_t LinkBudget>
+FibonacciHeap<Key, Value, Compare, Alloc, Stats, LinkBudget>::FibonacciHeap(const Compare& compare)
+    : min_(nullptr), size_(0), root_count_(0), compare_(compare) {}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats, std::size_t LinkBudget>
+FibonacciHeap<Key, Value, Compare, Alloc, Stats, LinkBudget>::~FibonacciHeap() {
+    if constexpr (!releases_nodes_in_bulk<Alloc, Node>()) {
+        delete_all(min_);
+    }
+    min_ = nullptr;
+    size_ = 0;
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats, std::size_t LinkBudget>
+bool FibonacciHeap<Key, Value, Compare, Alloc, Stats, LinkBudget>::is_empty() const {
+    return min_ == nullptr;
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats, std::size_t LinkBudget>
+void FibonacciHeap<Key, Value, Compare, Alloc, Stats, LinkBudget>::clear() {
+    if constexpr (!releases_nodes_in_bulk<Alloc, Node>()) {
+        delete_all(min_);
+    }
+    min_ = nullptr;
+    size_ = 0;
+    root_count_ = 0;
+    if constexpr (kBounded) {
+        std::fill(degree_table_.begin(), degree_table_.end(), nullptr);
+        pending_.clear();
+    }
+    slots_.clear();
+    stats_.reset();
+    alloc_.reset();
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats, std::size_t LinkBudget>
+HeapHandle FibonacciHeap<Key, Value, Compare, Alloc, Stats, LinkBudget>::insert(Key key, Value value) {
+    auto* node = make_node(key, value);
+    const HeapHandle handle = slots_.acquire(node);
+    node->slot = handle.slot;
+    add_to_root_list(node);
+    ++size_;
+    update_size_metrics();
+    note_tree_height(node->subtree_height);
+    if constexpr (kBounded) settle();
+    return handle;
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats, std::size_t LinkBudget>
+std::pair<Key, Value> FibonacciHeap<Key, Value, Compare, Alloc, Stats, LinkBudget>::extract_min() {
+    if (!min_) {
+        throw std::runtime_error("extract_min from empty FibonacciHeap");
+    }
+
+    Node* z = min_;
+    if constexpr (kBounded) unsettle(z);
+    if (z->child) {
+        std::vector<Node*> children;
+        Node* current = z->child;
+        do {
+            children.push_back(current);
+            current = current->right;
+        } while (current != z->child);
+
+        for (auto* child : children) {
+            child->parent = nullptr;
+            child->mark = false;
+            // detach child from its sibling ring
+            child->left->right = child->right;
+            child->right->left = child->left;
+            child->left = child->right = child;
+            add_to_root_list(child);
+        }
+        z->child = nullptr;
+    }
+
+    remove_from_root_list(z);
+    --size_;
+    update_size_metrics();
+
+    if constexpr (kBounded) {
+        if (min_) {
+            stats_.on_consolidation();
+            // Only the O(log n) promoted children need placing; the table
+            // then holds every root.
+            settle();
+            Node* best = nullptr;
+            for (Node* root : degree_table_) {
+                if (root && (!best || compare_(root->key, best->key))) best = root;
+            }
+            min_ = best;
+        }
+    } else if (min_) {
+        consolidate();
+    }
+
+    std::pair<Key, Value> result(z->key, z->value);
+    slots_.release(z->slot);
+    destroy_node(alloc_, z);
+    return result;
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats, std::size_t LinkBudget>
+std::pair<Key, Value> FibonacciHeap<Key, Value, Compare, Alloc, Stats, LinkBudget>::peek_min() const {
+    if (!min_) {
+        throw std::runtime_error("peek_min from empty FibonacciHeap");
+    }
+    return {min_->key, min_->value};
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats, std::size_t LinkBudget>
+void FibonacciHeap<Key, Value, Compare, Alloc, Stats, LinkBudget>::decrease_key(HeapHandle handle, Key new_key) {
+    Node* node = slots_.resolve(handle);
+    if (!node) {
+        throw std::invalid_argument("node is null");
+    }
+    if (compare_(node->key, new_key)) {
+        throw std::invalid_argument("new_key is greater than current key");
+    }
+
+    node->key = new_key;
+    Node* parent = node->parent;
+    if (parent && compare_(node->key, parent->key)) {
+        cut(node, parent);
+        cascading_cut(parent);
+    }
+
+    if (!min_ || compare_(node->key, min_->key)) {
+        min_ = node;
+    }
+    if constexpr (kBounded) settle();
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats, std::size_t LinkBudget>
+void FibonacciHeap<Key, Value, Compare, Alloc, Stats, LinkBudget>::merge(Base& other_base) {
+    auto* other = dynamic_cast<FibonacciHeap*>(&other_base);
+    if (!other) throw std::invalid_argument("merge requires another FibonacciHeap");
+    if (other == this || !other->min_) return;
+
+    if constexpr (kBounded) {
+        Node* current = other->min_;
+        do {
+            pending_.push_back(current);
+            current = current->right;
+        } while (current != other->min_);
+        std::fill(other->degree_table_.begin(), other->degree_table_.end(), nullptr);
+        other->pending_.clear();
+    }
+
+    if (!min_) {
+        min_ = other->min_;
+        size_ = other->size_;
+        root_count_ = other->root_count_;
+    } else {
+        concatenate_root_lists(min_, other->min_);
+        if (compare_(other->min_->key, min_->key)) {
+            min_ = other->min_;
+        }
+        size_ += other->size_;
+        root_count_ += other->root_count_;
+    }
+    // Left pending, a meld's roots would be rescanned by every extract_min.
+    if constexpr (kBounded) settle();
+
+    stats_.on_roots(root_count_);
+    update_size_metrics();
+
+    const std::uint32_t slot_offset = slots_.absorb(other->slots_);
+    for (std::uint32_t slot = slot_offset; slot < slots_.size(); ++slot) {
+        if (Node* node = slots_[slot]) node->slot = slot;
+    }
+
+    other->min_ = nullptr;
+    other->size_ = 0;
+    other->root_count_ = 0;
+    alloc_.absorb(other->alloc_);
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats, std::size_t LinkBudget>
+void FibonacciHeap<Key, Value, Compare, Alloc, Stats, LinkBudget>::add_to_root_list(Node* node) {
+    if (!node) return;
+    if (!min_) {
+        node->left = node->right = node;
+        node->parent = nullptr;
+        node->mark = false;
+        min_ = node;
+        root_count_ = 1;
+        note_tree_height(node->subtree_height);
+        stats_.on_roots(root_count_);
+        if constexpr (kBounded) pending_.push_back(node);
+        return;
+    }
+
+    node->left = min_->left;
+    node->right = min_;
+    min_->left->right = node;
+    min_->left = node;
+    node->parent = nullptr;
+    node->mark = false;
+    ++root_count_;
+    note_tree_height(node->subtree_height);
+    if (compare_(node->key, min_->key)) {
+        min_ = node;
+    }
+    stats_.on_roots(root_count_);
+    if constexpr (kBounded) pending_.push_back(node);
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats, std::size_t LinkBudget>
+void FibonacciHeap<Key, Value, Compare, Alloc, Stats, LinkBudget>::remove_from_root_list(Node* node) {
+    if (!node) return;
+    if (node->right == node) {
+        min_ = nullptr;
+        root_count_ = 0;
+    } else {
+        node->left->right = node->right;
+        node->right->left = node->left;
+        if (min_ == node) {
+            min_ = node->right;
+        }
+        if (root_count_ > 0) {
+            --root_count_;
+        }
+    }
+    node->left = node->right = node;
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats, std::size_t LinkBudget>
+void FibonacciHeap<Key, Value, Compare, Alloc, Stats, LinkBudget>::link_nodes(Node* child, Node* parent) {
+    remove_from_root_list(child);
+    child->parent = parent;
+    child->mark = false;
+    if (!parent->child) {
+        parent->child = child;
+        child->left = child->right = child;
+    } else {
+        child->left = parent->child->left;
+        child->right = parent->child;
+        parent->child->left->right = child;
+        parent->child->left = child;
+    }
+    parent->degree++;
+    if constexpr (Stats::kEnabled) {
+        const int candidate_height = child->subtree_height + 1;
+        if (candidate_height > parent->subtree_height) {
+            parent->subtree_height = candidate_height;
+            note_tree_height(parent->subtree_height);
+        }
+    }
+    stats_.on_link();
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats, std::size_t LinkBudget>
+void FibonacciHeap<Key, Value, Compare, Alloc, Stats, LinkBudget>::consolidate() {
+    if (!min_) return;
+
+    stats_.on_consolidation();
+
+    std::vector<Node*> roots;
+    Node* current = min_;
+    if (current) {
+        do {
+            roots.push_back(current);
+            current = current->right;
+        } while (current != min_);
+    }
+
+    std::size_t max_degree = 0;
+    std::size_t n = size_;
+    while (n > 0) {
+        n >>= 1U;
+        ++max_degree;
+    }
+    max_degree += 2;
+
+    std::vector<Node*> degree_table(max_degree, nullptr);
+
+    for (auto* w : roots) {
+        Node* x = w;
+        std::size_t d = static_cast<std::size_t>(x->degree);
+        while (true) {
+            if (d >= degree_table.size()) {
+                degree_table.resize(d + 1, nullptr);
+            }
+            if (!degree_table[d]) break;
+            Node* y = degree_table[d];
+            if (compare_(y->key, x->key)) std::swap(x, y);
+            link_nodes(y, x);
+            degree_table[d] = nullptr;
+            ++d;
+        }
+        degree_table[d] = x;
+    }
+
+    min_ = nullptr;
+    root_count_ = 0;
+    for (auto* node : degree_table) {
+        if (!node) continue;
+        node->left = node->right = node;
+        node->parent = nullptr;
+        node->mark = false;
+        add_to_root_list(node);
+    }
+}
+
+// Places every pending root into the degree table, linking equal degrees;
+// each placement's carry chain is at most the table's O(log n) length.
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats, std::size_t LinkBudget>
+void FibonacciHeap<Key, Value, Compare, Alloc, Stats, LinkBudget>::settle() {
+    while (!pending_.empty()) {
+        Node* x = pending_.back();
+        pending_.pop_back();
+        std::size_t d = x->degree;
+        while (true) {
+            if (d >= degree_table_.size()) {
+                degree_table_.resize(d + 1, nullptr);
+            }
+            Node* y = degree_table_[d];
+            if (!y) break;
+            degree_table_[d] = nullptr;
+            if (compare_(y->key, x->key)) std::swap(x, y);
+            const bool y_was_min = min_ == y;
+            link_nodes(y, x);
+            if (y_was_min) min_ = x; // equal keys
+            ++d;
+        }
+        degree_table_[d] = x;
+    }
+}
+
+// Drops a root from the degree table. Only roots that were there when the
+// operation began are unsettled (the extracted minimum, the root above a
+// cascading cut), so the table always holds them.
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats, std::size_t LinkBudget>
+void FibonacciHeap<Key, Value, Compare, Alloc, Stats, LinkBudget>::unsettle(Node* root) {
+    if (root->degree >= degree_table_.size() || degree_table_[root->degree] != root) {
+        throw std::logic_error("root missing from the degree table");
+    }
+    degree_table_[root->degree] = nullptr;
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats, std::size_t LinkBudget>
+void FibonacciHeap<Key, Value, Compare, Alloc, Stats, LinkBudget>::cut(Node* node, Node* parent) {
+    if (!node || !parent) return;
+
+    if constexpr (kBounded) {
+        // A settled root must be re-placed once its degree drops.
+        if (!parent->parent) {
+            unsettle(parent);
+            pending_.push_back(parent);
+        }
+    }
+    if (node->right == node) {
+        parent->child = nullptr;
+    } else {
+        if (parent->child == node) {
+            parent->child = node->right;
+        }
+        node->left->right = node->right;
+        node->right->left = node->left;
+    }
+    parent->degree--;
+    node->left = node->right = node;
+    node->parent = nullptr;
+    node->mark = false;
+    add_to_root_list(node);
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats, std::size_t LinkBudget>
+void FibonacciHeap<Key, Value, Compare, Alloc, Stats, LinkBudget>::cascading_cut(Node* node) {
+    Node* parent = node->parent;
+    if (!parent) return;
+    if (!node->mark) {
+        node->mark = true;
+    } else {
+        cut(node, parent);
+        cascading_cut(parent);
+    }
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats, std::size_t LinkBudget>
+void FibonacciHeap<Key, Value, Compare, Alloc, Stats, LinkBudget>::delete_all(Node* node) {
+    if (!node) return;
+    Node* start = node;
+    Node* current = start;
+    do {
+        Node* next = current->right;
+        if (current->child) {
+            delete_all(current->child);
+            current->child = nullptr;
+        }
+        destroy_node(alloc_, current);
+        current = next;
+    } while (current != start);
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats, std::size_t LinkBudget>
+void FibonacciHeap<Key, Value, Compare, Alloc, Stats, LinkBudget>::update_size_metrics() {
+    if (!stats_.should_sample()) return;
+    stats_.on_roots(root_count_);
+    stats_.on_size(size_, size_ * sizeof(Node) + slots_.capacity_bytes());
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats, std::size_t LinkBudget>
+void FibonacciHeap<Key, Value, Compare, Alloc, Stats, LinkBudget>::note_tree_height(int subtree_height) {
+    if (subtree_height < 0) {
+        return;
+    }
+    const std::size_t height = static_cast<std::size_t>(subtree_height + 1);
+    stats_.on_height(height);
+}
+
+// The driver's deamortized variant (HeapSelection::kFibonacciBounded).
+inline constexpr std::size_t kBoundedFibonacciLinkBudget = 8;
+template <typename Key = long long, typename Value = int, typename Compare = std::less<Key>,
+          typename Alloc = NewDeleteAllocator, typename Stats = FullStats>
+using BoundedFibonacciHeap = FibonacciHeap<Key, Value, Compare, Alloc, Stats, kBoundedFibonacciLinkBudget>;
+
+// The instantiations used by the driver are compiled once in FibonacciHeap.cpp.
+extern template class FibonacciHeap<long long, int>;
+extern template class FibonacciHeap<std::uint32_t, int>;
+extern template class FibonacciHeap<long long, int, std::less<long long>, NewDeleteAllocator, FullStats, kBoundedFibonacciLinkBudget>;
+extern template class FibonacciHeap<std::uint32_t, int, std::less<std::uint32_t>, NewDeleteAllocator, FullStats, kBoundedFibonacciLinkBudget>;
@@ -0,0 +1,277 @@
+#pragma once
+
+#include "BinaryHeap.h"
+#include "HeapAllocators.h"
+#include "HeapHandle.h"
+#include "HeapStats.h"
+#include "PriorityQueue.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Index of the first smallest key in keys[0, count); count must be > 0.
+// Uses an AVX2 scan when the CPU supports it (checked once at run time).
+std::size_t flat_argmin(const long long* keys, std::size_t count);
+std::size_t flat_argmin(const std::uint32_t* keys, std::size_t count);
+
+// Priority queue for small frontiers: up to flat_capacity elements live in
+// 64-byte-aligned key/value/owner arrays, found by a linear min-scan and
+// decreased in place. Inserts that find the arrays full spill into a
+// BinaryHeap; extract_min takes the smaller of the two minima, so spilled
+// elements drain out without being moved back. merge re-inserts the other
+// heap's elements.
+template <typename Key = long long, typename Value = int, typename Compare = std::less<Key>,
+          typename Alloc = NewDeleteAllocator, typename Stats = FullStats>
+class FlatSpillHeap : public PriorityQueue<Key, Value, Compare>
+{
+public:
+    using Base = PriorityQueue<Key, Value, Compare>;
+
+    // Where a handle's element lives: a flat position, or a spill handle.
+    struct Location {
+        std::uint32_t position = kSpilled;
+        HeapHandle spilled;
+    };
+
+    struct SpilledEntry {
+        Value value;
+        std::uint32_t owner;
+    };
+
+    using SpillHeap = BinaryHeap<Key, SpilledEntry, Compare, Alloc, Stats>;
+
+    static constexpr std::uint32_t kSpilled = HeapHandle::kInvalidSlot;
+    static constexpr std::size_t kDefaultFlatCapacity = 128;
+    static constexpr std::size_t kAlignment = 64;
+    // Flat key, value and owner plus the handle-table entry.
+    static constexpr std::size_t kNodeBytes = sizeof(Key) + sizeof(Value) + sizeof(std::uint32_t) + sizeof(Location);
+
+    explicit FlatSpillHeap(std::size_t flat_capacity = kDefaultFlatCapacity);
+    FlatSpillHeap(std::size_t flat_capacity, const Compare& compare);
+
+    HeapHandle insert(Key key, Value value) override;
+    std::pair<Key, Value> extract_min() override;
+    std::pair<Key, Value> peek_min() const override;
+    void decrease_key(HeapHandle handle, Key new_key) override;
+    void merge(Base& other) override;
+    bool is_empty() const override;
+    void clear() override;
+    const HeapStructureStats& structure_stats() const;
+    const AllocationStats& allocation_stats() const { return spill_.allocation_stats(); }
+
+    std::size_t flat_size() const { return flat_size_; }
+    std::size_t spilled_size() const { return handles_.live() - flat_size_; }
+
+private:
+    template <typename T>
+    struct AlignedDelete {
+        void operator()(T* p) const { ::operator delete(p, std::align_val_t{kAlignment}); }
+    };
+    template <typename T>
+    using AlignedArray = std::unique_ptr<T[], AlignedDelete<T>>;
+
+    template <typename T>
+    static AlignedArray<T> make_aligned(std::size_t count);
+
+    // The SIMD scan applies to the driver's key types under std::less.
+    static constexpr bool kVectorScan =
+        std::is_same_v<Compare, std::less<Key>> &&
+        (std::is_same_v<Key, long long> || std::is_same_v<Key, std::uint32_t>);
+
+    std::size_t flat_min_position() const;
+    void remove_flat(std::size_t position);
+    void update_size_metrics();
+
+    std::size_t flat_capacity_;
+    std::size_t flat_size_ = 0;
+    AlignedArray<Key> keys_;
+    AlignedArray<Value> values_;
+    AlignedArray<std::uint32_t> owners_; // flat position -> handle slot
+    // Cached position of the flat minimum; kSpilled when it must be rescanned.
+    mutable std::uint32_t min_position_ = kSpilled;
+
+    HandleSlots<Location> handles_;
+    SpillHeap spill_;
+    Stats stats_;
+    Compare compare_;
+    mutable HeapStructureStats combined_stats_;
+};
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+template <typename T>
+auto FlatSpillHeap<Key, Value, Compare, Alloc, Stats>::make_aligned(std::size_t count) -> AlignedArray<T> {
+    static_assert(std::is_trivially_copyable_v<T>, "flat arrays hold trivially copyable types");
+    void* raw = ::operator new(std::max<std::size_t>(count, 1) * sizeof(T), std::align_val_t{kAlignment});
+    return AlignedArray<T>(static_cast<T*>(raw));
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+FlatSpillHeap<Key, Value, Compare, Alloc, Stats>::FlatSpillHeap(std::size_t flat_capacity)
+    : FlatSpillHeap(flat_capacity, Compare()) {}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+FlatSpillHeap<Key, Value, Compare, Alloc, Stats>::FlatSpillHeap(std::size_t flat_capacity, const Compare& compare)
+    : flat_capacity_(flat_capacity),
+      keys_(make_aligned<Key>(flat_capacity)),
+      values_(make_aligned<Value>(flat_capacity)),
+      owners_(make_aligned<std::uint32_t>(flat_capacity)),
+      spill_(compare),
+      compare_(compare) {}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+bool FlatSpillHeap<Key, Value, Compare, Alloc, Stats>::is_empty() const {
+    return flat_size_ == 0 && spill_.is_empty();
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void FlatSpillHeap<Key, Value, Compare, Alloc, Stats>::clear() {
+    flat_size_ = 0;
+    min_position_ = kSpilled;
+    handles_.clear();
+    spill_.clear();
+    stats_.reset();
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+HeapHandle FlatSpillHeap<Key, Value, Compare, Alloc, Stats>::insert(Key key, Value value) {
+    const HeapHandle handle = handles_.acquire(Location{});
+    if (flat_size_ < flat_capacity_) {
+        const std::size_t position = flat_size_++;
+        keys_[position] = key;
+        values_[position] = value;
+        owners_[position] = handle.slot;
+        handles_[handle.slot].position = static_cast<std::uint32_t>(position);
+        if (min_position_ != kSpilled && compare_(key, keys_[min_position_])) {
+            min_position_ = static_cast<std::uint32_t>(position);
+        }
+    } else {
+        handles_[handle.slot].spilled = spill_.insert(key, SpilledEntry{value, handle.slot});
+    }
+    update_size_metrics();
+    return handle;
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+std::size_t FlatSpillHeap<Key, Value, Compare, Alloc, Stats>::flat_min_position() const {
+    if (min_position_ == kSpilled) {
+        std::size_t best = 0;
+        if constexpr (kVectorScan) {
+            best = flat_argmin(keys_.get(), flat_size_);
+        } else {
+            for (std::size_t i = 1; i < flat_size_; ++i) {
+                if (compare_(keys_[i], keys_[best])) best = i;
+            }
+        }
+        min_position_ = static_cast<std::uint32_t>(best);
+    }
+    return min_position_;
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void FlatSpillHeap<Key, Value, Compare, Alloc, Stats>::remove_flat(std::size_t position) {
+    handles_.release(owners_[position]);
+    const std::size_t last = --flat_size_;
+    if (position != last) {
+        keys_[position] = keys_[last];
+        values_[position] = values_[last];
+        owners_[position] = owners_[last];
+        handles_[owners_[position]].position = static_cast<std::uint32_t>(position);
+    }
+    min_position_ = kSpilled;
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+std::pair<Key, Value> FlatSpillHeap<Key, Value, Compare, Alloc, Stats>::extract_min() {
+    if (is_empty()) throw std::runtime_error("extract_min from empty FlatSpillHeap");
+    stats_.on_consolidation();
+
+    if (flat_size_ > 0) {
+        const std::size_t position = flat_min_position();
+        if (spill_.is_empty() || !compare_(spill_.peek_min().first, keys_[position])) {
+            std::pair<Key, Value> result(keys_[position], values_[position]);
+            remove_flat(position);
+            update_size_metrics();
+            return result;
+        }
+    }
+
+    auto [key, entry] = spill_.extract_min();
+    handles_.release(entry.owner);
+    update_size_metrics();
+    return {key, entry.value};
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+std::pair<Key, Value> FlatSpillHeap<Key, Value, Compare, Alloc, Stats>::peek_min() const {
+    if (is_empty()) throw std::runtime_error("peek_min from empty FlatSpillHeap");
+    if (flat_size_ > 0) {
+        const std::size_t position = flat_min_position();
+        if (spill_.is_empty() || !compare_(spill_.peek_min().first, keys_[position])) {
+            return {keys_[position], values_[position]};
+        }
+    }
+    const auto& [key, entry] = spill_.peek_min();
+    return {key, entry.value};
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void FlatSpillHeap<Key, Value, Compare, Alloc, Stats>::decrease_key(HeapHandle handle, Key new_key) {
+    const Location& location = handles_.resolve(handle);
+    if (location.position == kSpilled) {
+        spill_.decrease_key(location.spilled, new_key);
+        return;
+    }
+    const std::size_t position = location.position;
+    if (compare_(keys_[position], new_key)) throw std::invalid_argument("new_key is greater than current key");
+    keys_[position] = new_key;
+    if (min_position_ != kSpilled && compare_(new_key, keys_[min_position_])) {
+        min_position_ = static_cast<std::uint32_t>(position);
+    }
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void FlatSpillHeap<Key, Value, Compare, Alloc, Stats>::merge(Base& other_base) {
+    auto* other = dynamic_cast<FlatSpillHeap*>(&other_base);
+    if (!other) throw std::invalid_argument("merge requires another FlatSpillHeap");
+    if (other == this || other->is_empty()) return;
+
+    for (std::size_t i = 0; i < other->flat_size_; ++i) {
+        insert(other->keys_[i], other->values_[i]);
+    }
+    while (!other->spill_.is_empty()) {
+        auto [key, entry] = other->spill_.extract_min();
+        insert(key, entry.value);
+    }
+    other->clear();
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+const HeapStructureStats& FlatSpillHeap<Key, Value, Compare, Alloc, Stats>::structure_stats() const {
+    // Sizes are the whole queue's; links and tree height come from the spill heap.
+    combined_stats_ = stats_.stats();
+    const HeapStructureStats& spill = spill_.structure_stats();
+    combined_stats_.max_tree_height = std::max(combined_stats_.max_tree_height, spill.max_tree_height);
+    combined_stats_.link_operations += spill.link_operations;
+    return combined_stats_;
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void FlatSpillHeap<Key, Value, Compare, Alloc, Stats>::update_size_metrics() {
+    if (!stats_.should_sample()) return;
+    const std::size_t spilled = spilled_size();
+    stats_.on_size(flat_size_ + spilled,
+                   flat_capacity_ * (sizeof(Key) + sizeof(Value) + sizeof(std::uint32_t)) +
+                       handles_.capacity_bytes() + spilled * SpillHeap::kNodeBytes);
+    stats_.on_height(flat_size_ > 0 ? 1u : 0u);
+    stats_.on_roots(flat_size_ + (spilled > 0 ? 1u : 0u));
+}
+
+// The instantiations used by the driver are compiled once in FlatSpillHeap.cpp.
+extern template class FlatSpillHeap<long long, int>;
+extern template class FlatSpillHeap<std::uint32_t, int>;
@@ -2,6 +2,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -11,19 +12,68 @@ struct GraphEdge {
     long long weight = 0; // weight stored in whole meters
 };
 
+// How load_coordinates reads each vertex's (x, y): longitude and latitude
+// in degrees (great-circle distance) or planar x, y (Euclidean distance).
+enum class CoordinateSystem {
+    kLonLatDegrees,
+    kPlanar
+};
+
 class Graph {
 public:
     bool load_from_file(const std::string& path, std::string* error_message = nullptr);
+    // Optional vertex geometry, one "id x y" line per vertex (a leading "v"
+    // as in DIMACS .co files is accepted; '#' lines are skipped). Call after
+    // load_from_file; every vertex needs a position.
+    bool load_coordinates(const std::string& path, CoordinateSystem system,
+                          std::string* error_message = nullptr);
 
     std::size_t node_count() const noexcept { return adjacency_.size(); }
     std::size_t edge_count() const noexcept { return edge_count_; }
     bool empty() const noexcept { return adjacency_.empty(); }
 
+    bool has_coordinates() const noexcept { return !coordinates_.empty(); }
+    // Straight-line distance scaled into weight units and rounded down. The
+    // scale is the smallest weight-to-distance ratio over all edges, so the
+    // bound never exceeds a path's weight and is consistent for A*.
+    long long distance_lower_bound(int from, int to) const;
+    CoordinateSystem coordinate_system() const noexcept { return coordinate_system_; }
+    // Stored position: planar (x, y), or (longitude, latitude) in radians.
+    std::pair<double, double> coordinate(int node) const {
+        const Point& point = coordinates_[static_cast<std::size_t>(node)];
+        return {point.x, point.y};
+    }
+
+    // The same vertices with every edge reversed, for searches toward a vertex.
+    Graph reversed() const;
+
+    // Replaces every edge weight with weight(from, edge), keeping the
+    // topology, as a reload of new travel times would. The reverse adjacency
+    // and the A* bound follow. Throws on a weight the loader would reject.
+    void reweight(const std::function<long long(int, const GraphEdge&)>& weight);
+
     const std::vector<GraphEdge>& neighbors(int node) const { return adjacency_[static_cast<std::size_t>(node)]; }
+    // Incoming edges of node; each edge's `to` is the tail it comes from.
+    const std::vector<GraphEdge>& reverse_neighbors(int node) const {
+        return reverse_adjacency_[static_cast<std::size_t>(node)];
+    }
 
 private:
     void reset();
+    void build_reverse_adjacency();
+    void update_bound_scale();
 
     std::vector<std::vector<GraphEdge>> adjacency_;
+    std::vector<std::vector<GraphEdge>> reverse_adjacency_;
+    // Planar points, or (longitude, latitude) in radians.
+    struct Point {
+        double x = 0.0;
+        double y = 0.0;
+    };
+    double straight_line_distance(const Point& a, const Point& b) const;
+
+    std::vector<Point> coordinates_;
+    CoordinateSystem coordinate_system_ = CoordinateSystem::kPlanar;
+    double bound_scale_ = 0.0;
     std::size_t edge_count_ = 0;
 };
@@ -0,0 +1,370 @@
+#pragma once
+
+#include "HeapStats.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+// Allocator policies for heap nodes. Every policy exposes
+//   void* allocate(std::size_t bytes, std::size_t align);
+//   void deallocate(void* ptr, std::size_t bytes, std::size_t align);
+//   void absorb(Policy& other);  // take ownership of other's storage (merge)
+//   void release();              // return all storage to the system
+//   void reset();                // forget every node but keep the storage
+//   const AllocationStats& stats() const;
+// and kReleasesInBulk, which tells the heap that destroying the policy frees
+// every node, so trivially destructible nodes need not be walked one by one.
+
+enum class AllocatorPolicy {
+    kNewDelete = 1,
+    kPool = 2,
+    kArena = 3,
+    kHugePageArena = 4
+};
+
+// Plain global new/delete per node; the behaviour the heaps originally had.
+class NewDeleteAllocator {
+public:
+    static constexpr bool kReleasesInBulk = false;
+
+    void* allocate(std::size_t bytes, std::size_t align) {
+        stats_.allocations++;
+        stats_.system_allocations++;
+        note_reserved(static_cast<std::ptrdiff_t>(bytes));
+        if (align > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            return ::operator new(bytes, std::align_val_t(align));
+        }
+        return ::operator new(bytes);
+    }
+
+    void deallocate(void* ptr, std::size_t bytes, std::size_t align) {
+        stats_.deallocations++;
+        note_reserved(-static_cast<std::ptrdiff_t>(bytes));
+        if (align > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            ::operator delete(ptr, std::align_val_t(align));
+            return;
+        }
+        ::operator delete(ptr);
+    }
+
+    void absorb(NewDeleteAllocator& other) {
+        stats_.reserved_bytes += other.stats_.reserved_bytes;
+        stats_.max_reserved_bytes = std::max(stats_.max_reserved_bytes, stats_.reserved_bytes);
+        other.stats_.reserved_bytes = 0;
+    }
+
+    void release() {}
+
+    // Nodes were freed one by one; only the counters start over.
+    void reset() { stats_ = {}; }
+
+    const AllocationStats& stats() const { return stats_; }
+
+private:
+    AllocationStats stats_{};
+
+    void note_reserved(std::ptrdiff_t delta) {
+        stats_.reserved_bytes = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(stats_.reserved_bytes) + delta);
+        stats_.max_reserved_bytes = std::max(stats_.max_reserved_bytes, stats_.reserved_bytes);
+    }
+};
+
+namespace heap_alloc_detail {
+
+constexpr std::size_t kMaxNodeAlign = alignof(std::max_align_t);
+
+inline std::size_t align_up(std::size_t value, std::size_t align) {
+    return (value + align - 1) & ~(align - 1);
+}
+
+// Chunks from the global heap.
+struct GlobalChunkSource {
+    static std::pair<void*, std::size_t> acquire(std::size_t min_bytes) {
+        return {::operator new(min_bytes, std::align_val_t(kMaxNodeAlign)), min_bytes};
+    }
+
+    static void give_back(void* ptr, std::size_t) {
+        ::operator delete(ptr, std::align_val_t(kMaxNodeAlign));
+    }
+};
+
+// 2 MiB regions backed by explicit huge pages when the kernel has them
+// reserved (MAP_HUGETLB), otherwise by transparent huge pages via madvise.
+// Platforms without mmap fall back to the global heap.
+struct HugePageChunkSource {
+    static constexpr std::size_t kHugePageBytes = std::size_t{2} << 20;
+
+    static std::pair<void*, std::size_t> acquire(std::size_t min_bytes) {
+        const std::size_t bytes = align_up(min_bytes, kHugePageBytes);
+#if defined(__linux__)
+        void* ptr = MAP_FAILED;
+#if defined(MAP_HUGETLB)
+        ptr = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif
+        if (ptr == MAP_FAILED) {
+            ptr = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (ptr == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+#if defined(MADV_HUGEPAGE)
+            ::madvise(ptr, bytes, MADV_HUGEPAGE);
+#endif
+        }
+        return {ptr, bytes};
+#else
+        return GlobalChunkSource::acquire(bytes);
+#endif
+    }
+
+    static void give_back(void* ptr, std::size_t bytes) {
+#if defined(__linux__)
+        ::munmap(ptr, bytes);
+#else
+        GlobalChunkSource::give_back(ptr, bytes);
+#endif
+    }
+};
+
+} // namespace heap_alloc_detail
+
+// Bump allocator over a growing list of chunks. Individual frees are only
+// counted; memory is returned when the arena is released or destroyed.
+// reset() rewinds to the first chunk so a reused heap allocates nothing new.
+template <typename ChunkSource>
+class BasicMonotonicArena {
+public:
+    static constexpr bool kReleasesInBulk = true;
+    static constexpr std::size_t kInitialChunkBytes = 16 * 1024;
+    static constexpr std::size_t kMaxChunkBytes = 4 * 1024 * 1024;
+
+    BasicMonotonicArena() = default;
+    BasicMonotonicArena(const BasicMonotonicArena&) = delete;
+    BasicMonotonicArena& operator=(const BasicMonotonicArena&) = delete;
+    ~BasicMonotonicArena() { release(); }
+
+    void* allocate(std::size_t bytes, std::size_t align) {
+        stats_.allocations++;
+        std::size_t offset = heap_alloc_detail::align_up(static_cast<std::size_t>(cursor_ - base_), align);
+        if (!base_ || offset + bytes > static_cast<std::size_t>(end_ - base_)) {
+            grow(bytes + align);
+            offset = heap_alloc_detail::align_up(static_cast<std::size_t>(cursor_ - base_), align);
+        }
+        void* ptr = base_ + offset;
+        cursor_ = base_ + offset + bytes;
+        return ptr;
+    }
+
+    void deallocate(void*, std::size_t, std::size_t) { stats_.deallocations++; }
+
+    // The other arena's chunks hold live nodes, so they join the in-use part.
+    void absorb(BasicMonotonicArena& other) {
+        chunks_.insert(chunks_.begin() + static_cast<std::ptrdiff_t>(next_spare_), other.chunks_.begin(),
+                       other.chunks_.end());
+        next_spare_ += other.chunks_.size();
+        stats_.reserved_bytes += other.stats_.reserved_bytes;
+        stats_.max_reserved_bytes = std::max(stats_.max_reserved_bytes, stats_.reserved_bytes);
+        other.chunks_.clear();
+        other.next_spare_ = 0;
+        other.stats_.reserved_bytes = 0;
+        other.base_ = other.cursor_ = other.end_ = nullptr;
+    }
+
+    void release() {
+        for (const auto& chunk : chunks_) {
+            ChunkSource::give_back(chunk.first, chunk.second);
+        }
+        chunks_.clear();
+        next_spare_ = 0;
+        base_ = cursor_ = end_ = nullptr;
+        next_chunk_bytes_ = kInitialChunkBytes;
+        stats_.reserved_bytes = 0;
+    }
+
+    void reset() {
+        next_spare_ = 0;
+        base_ = cursor_ = end_ = nullptr;
+        stats_.allocations = stats_.deallocations = stats_.system_allocations = 0;
+    }
+
+    const AllocationStats& stats() const { return stats_; }
+
+private:
+    std::vector<std::pair<void*, std::size_t>> chunks_;
+    std::size_t next_spare_ = 0; // chunks_[next_spare_..] are kept by reset() for reuse
+    char* base_ = nullptr;
+    char* cursor_ = nullptr;
+    char* end_ = nullptr;
+    std::size_t next_chunk_bytes_ = kInitialChunkBytes;
+    AllocationStats stats_{};
+
+    void grow(std::size_t min_bytes) {
+        while (next_spare_ < chunks_.size()) {
+            const auto& spare = chunks_[next_spare_++];
+            if (spare.second >= min_bytes) {
+                base_ = cursor_ = static_cast<char*>(spare.first);
+                end_ = base_ + spare.second;
+                return;
+            }
+        }
+        auto chunk = ChunkSource::acquire(std::max(next_chunk_bytes_, min_bytes));
+        chunks_.push_back(chunk);
+        next_spare_ = chunks_.size();
+        base_ = cursor_ = static_cast<char*>(chunk.first);
+        end_ = base_ + chunk.second;
+        next_chunk_bytes_ = std::min(next_chunk_bytes_ * 2, kMaxChunkBytes);
+        stats_.system_allocations++;
+        stats_.reserved_bytes += chunk.second;
+        stats_.max_reserved_bytes = std::max(stats_.max_reserved_bytes, stats_.reserved_bytes);
+    }
+};
+
+using MonotonicArenaAllocator = BasicMonotonicArena<heap_alloc_detail::GlobalChunkSource>;
+using HugePageArenaAllocator = BasicMonotonicArena<heap_alloc_detail::HugePageChunkSource>;
+
+// Segregated free lists in 16-byte size classes up to 256 bytes, carved
+// lazily from 64 KiB chunks. Larger or over-aligned requests go to new/delete.
+// reset() empties every class and hands the chunks out again as needed.
+class PoolAllocator {
+public:
+    static constexpr bool kReleasesInBulk = true;
+    static constexpr std::size_t kGranularity = 16;
+    static constexpr std::size_t kClassCount = 16;
+    static constexpr std::size_t kChunkBytes = 64 * 1024;
+
+    PoolAllocator() = default;
+    PoolAllocator(const PoolAllocator&) = delete;
+    PoolAllocator& operator=(const PoolAllocator&) = delete;
+    ~PoolAllocator() { release(); }
+
+    void* allocate(std::size_t bytes, std::size_t align) {
+        stats_.allocations++;
+        if (!pooled(bytes, align)) {
+            stats_.system_allocations++;
+            return ::operator new(bytes, std::align_val_t(align));
+        }
+        SizeClass& cls = classes_[class_index(bytes)];
+        if (cls.free_list) {
+            FreeBlock* block = cls.free_list;
+            cls.free_list = block->next;
+            return block;
+        }
+        const std::size_t block_bytes = (class_index(bytes) + 1) * kGranularity;
+        if (cls.cursor + block_bytes > cls.end) {
+            cls.cursor = static_cast<char*>(take_chunk());
+            cls.end = cls.cursor + kChunkBytes;
+        }
+        void* ptr = cls.cursor;
+        cls.cursor += block_bytes;
+        return ptr;
+    }
+
+    void deallocate(void* ptr, std::size_t bytes, std::size_t align) {
+        stats_.deallocations++;
+        if (!pooled(bytes, align)) {
+            ::operator delete(ptr, std::align_val_t(align));
+            return;
+        }
+        SizeClass& cls = classes_[class_index(bytes)];
+        auto* block = static_cast<FreeBlock*>(ptr);
+        block->next = cls.free_list;
+        cls.free_list = block;
+    }
+
+    // Adopts the other pool's chunks; its free blocks are not reused but are
+    // returned with the chunks when this pool is released.
+    void absorb(PoolAllocator& other) {
+        chunks_.insert(chunks_.begin() + static_cast<std::ptrdiff_t>(next_spare_), other.chunks_.begin(),
+                       other.chunks_.end());
+        next_spare_ += other.chunks_.size();
+        stats_.reserved_bytes += other.stats_.reserved_bytes;
+        stats_.max_reserved_bytes = std::max(stats_.max_reserved_bytes, stats_.reserved_bytes);
+        other.chunks_.clear();
+        other.next_spare_ = 0;
+        other.classes_ = {};
+        other.stats_.reserved_bytes = 0;
+    }
+
+    void release() {
+        for (void* chunk : chunks_) {
+            ::operator delete(chunk, std::align_val_t(kGranularity));
+        }
+        chunks_.clear();
+        next_spare_ = 0;
+        classes_ = {};
+        stats_.reserved_bytes = 0;
+    }
+
+    void reset() {
+        next_spare_ = 0;
+        classes_ = {};
+        stats_.allocations = stats_.deallocations = stats_.system_allocations = 0;
+    }
+
+    const AllocationStats& stats() const { return stats_; }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    struct SizeClass {
+        FreeBlock* free_list = nullptr;
+        char* cursor = nullptr;
+        char* end = nullptr;
+    };
+
+    std::array<SizeClass, kClassCount> classes_{};
+    std::vector<void*> chunks_;
+    std::size_t next_spare_ = 0; // chunks_[next_spare_..] are kept by reset() for reuse
+    AllocationStats stats_{};
+
+    void* take_chunk() {
+        if (next_spare_ < chunks_.size()) {
+            return chunks_[next_spare_++];
+        }
+        void* chunk = ::operator new(kChunkBytes, std::align_val_t(kGranularity));
+        chunks_.push_back(chunk);
+        next_spare_ = chunks_.size();
+        stats_.system_allocations++;
+        stats_.reserved_bytes += kChunkBytes;
+        stats_.max_reserved_bytes = std::max(stats_.max_reserved_bytes, stats_.reserved_bytes);
+        return chunk;
+    }
+
+    static bool pooled(std::size_t bytes, std::size_t align) {
+        return bytes <= kGranularity * kClassCount && align <= kGranularity;
+    }
+
+    static std::size_t class_index(std::size_t bytes) {
+        return (std::max<std::size_t>(bytes, 1) - 1) / kGranularity;
+    }
+};
+
+// Construct / destroy a node through an allocator policy.
+template <typename T, typename Alloc, typename... Args>
+T* allocate_node(Alloc& alloc, Args&&... args) {
+    void* memory = alloc.allocate(sizeof(T), alignof(T));
+    return new (memory) T{std::forward<Args>(args)...};
+}
+
+template <typename T, typename Alloc>
+void destroy_node(Alloc& alloc, T* node) {
+    node->~T();
+    alloc.deallocate(node, sizeof(T), alignof(T));
+}
+
+// True when dropping the policy frees every node of type T without running
+// per-node destructors, so heap teardown can skip walking its structure.
+template <typename Alloc, typename T>
+constexpr bool releases_nodes_in_bulk() {
+    return Alloc::kReleasesInBulk && std::is_trivially_destructible<T>::value;
+}
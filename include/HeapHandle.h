@@ -0,0 +1,156 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+// Handle returned by every heap's insert: the 32-bit slot of the element in
+// the heap's handle table. Debug builds also carry the slot's generation so
+// a handle kept past extract_min (or past the slot's reuse) is rejected;
+// release builds drop the field and a handle is 4 bytes. A default-
+// constructed handle is null.
+struct HeapHandle {
+    static constexpr std::uint32_t kInvalidSlot = 0xFFFFFFFFu;
+
+    std::uint32_t slot = kInvalidSlot;
+#ifndef NDEBUG
+    std::uint32_t generation = 0;
+#endif
+
+    explicit operator bool() const { return slot != kInvalidSlot; }
+};
+
+#ifdef NDEBUG
+static_assert(sizeof(HeapHandle) == 4, "release handles must stay 4 bytes");
+#endif
+
+// Per-slot generation counters; compiled out in release builds.
+class HandleGenerations {
+public:
+    HeapHandle issue(std::uint32_t slot) {
+        HeapHandle handle;
+        handle.slot = slot;
+#ifndef NDEBUG
+        if (slot >= generations_.size()) {
+            generations_.resize(static_cast<std::size_t>(slot) + 1, 0);
+        }
+        handle.generation = generations_[slot];
+#endif
+        return handle;
+    }
+
+    // Called when the slot's element leaves the heap.
+    void retire(std::uint32_t slot) {
+#ifndef NDEBUG
+        generations_[slot]++;
+#else
+        (void)slot;
+#endif
+    }
+
+    void check(HeapHandle handle) const {
+#ifndef NDEBUG
+        if (handle.slot >= generations_.size() || generations_[handle.slot] != handle.generation) {
+            throw std::invalid_argument("stale heap handle");
+        }
+#else
+        (void)handle;
+#endif
+    }
+
+    // Invalidates handles to slots [first, first + count), e.g. slots taken
+    // over from a merged heap whose own handles no longer apply.
+    void retire_range(std::uint32_t first, std::size_t count) {
+#ifndef NDEBUG
+        if (first + count > generations_.size()) {
+            generations_.resize(first + count, 0);
+        }
+        for (std::size_t slot = first; slot < first + count; ++slot) {
+            generations_[slot]++;
+        }
+#else
+        (void)first;
+        (void)count;
+#endif
+    }
+
+    // Invalidates every outstanding handle; slots are handed out from 0 again.
+    void clear() {
+#ifndef NDEBUG
+        retire_range(0, generations_.size());
+#endif
+    }
+
+private:
+#ifndef NDEBUG
+    std::vector<std::uint32_t> generations_;
+#endif
+};
+
+// Handle table for heaps whose elements move or live behind pointers: maps
+// a slot to T (a node pointer or an array position) and recycles freed slots.
+// Released slots hold T{} until reused.
+template <typename T>
+class HandleSlots {
+public:
+    HeapHandle acquire(T target) {
+        std::uint32_t slot;
+        if (!free_.empty()) {
+            slot = free_.back();
+            free_.pop_back();
+            targets_[slot] = target;
+        } else {
+            slot = static_cast<std::uint32_t>(targets_.size());
+            targets_.push_back(target);
+        }
+        return generations_.issue(slot);
+    }
+
+    T& operator[](std::uint32_t slot) { return targets_[slot]; }
+    const T& operator[](std::uint32_t slot) const { return targets_[slot]; }
+
+    // Resolves a client handle; throws on null (and, in debug, on stale) handles.
+    T& resolve(HeapHandle handle) {
+        if (!handle || handle.slot >= targets_.size()) {
+            throw std::invalid_argument("handle is null");
+        }
+        generations_.check(handle);
+        return targets_[handle.slot];
+    }
+
+    void release(std::uint32_t slot) {
+        targets_[slot] = T{};
+        generations_.retire(slot);
+        free_.push_back(slot);
+    }
+
+    // Appends other's slots after ours and returns the offset; other's slot s
+    // becomes s + offset, so handles issued by other are no longer valid.
+    std::uint32_t absorb(HandleSlots& other) {
+        const auto offset = static_cast<std::uint32_t>(targets_.size());
+        targets_.insert(targets_.end(), other.targets_.begin(), other.targets_.end());
+        for (std::uint32_t slot : other.free_) {
+            free_.push_back(slot + offset);
+        }
+        generations_.retire_range(offset, other.targets_.size());
+        other.clear();
+        return offset;
+    }
+
+    // Drops every element but keeps the table's capacity.
+    void clear() {
+        targets_.clear();
+        free_.clear();
+        generations_.clear();
+    }
+
+    std::size_t size() const { return targets_.size(); }
+    std::size_t live() const { return targets_.size() - free_.size(); }
+    std::size_t capacity_bytes() const { return targets_.capacity() * sizeof(T); }
+
+private:
+    std::vector<T> targets_;
+    std::vector<std::uint32_t> free_;
+    HandleGenerations generations_;
+};
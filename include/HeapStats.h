@@ -13,3 +13,88 @@ struct HeapStructureStats {
     std::size_t current_bytes = 0;        // approximate memory footprint (bytes)
     std::size_t max_bytes = 0;            // peak bytes
 };
+
+// Node allocation counters reported by a heap's allocator policy.
+struct AllocationStats {
+    std::size_t allocations = 0;        // node allocations served to the heap
+    std::size_t deallocations = 0;      // node frees returned by the heap
+    std::size_t system_allocations = 0; // requests forwarded to the global heap / OS
+    std::size_t reserved_bytes = 0;     // bytes currently held from the global heap / OS
+    std::size_t max_reserved_bytes = 0; // peak reserved bytes
+};
+
+enum class StatsPolicy {
+    kFull = 1,
+    kSampled = 2,
+    kNone = 3
+};
+
+// Structural statistics policies. Heaps report events through these hooks:
+//   on_link(), on_consolidation()      counters
+//   on_height(h), on_roots(r)          running peaks
+//   should_sample() / on_size(n, b)    node count and byte footprint
+// Callers guard the size refresh (and whatever it costs to compute) with
+// should_sample(). kEnabled lets a heap skip bookkeeping kept only for stats.
+
+// Records every event.
+class FullStats {
+public:
+    static constexpr bool kEnabled = true;
+
+    void on_link() { stats_.link_operations++; }
+    void on_consolidation() { stats_.consolidation_passes++; }
+    void on_height(std::size_t height) {
+        if (height > stats_.max_tree_height) stats_.max_tree_height = height;
+    }
+    void on_roots(std::size_t roots) {
+        if (roots > stats_.max_roots) stats_.max_roots = roots;
+    }
+    bool should_sample() { return true; }
+    void on_size(std::size_t nodes, std::size_t bytes) {
+        stats_.current_nodes = nodes;
+        if (nodes > stats_.max_nodes) stats_.max_nodes = nodes;
+        stats_.current_bytes = bytes;
+        if (bytes > stats_.max_bytes) stats_.max_bytes = bytes;
+    }
+
+    const HeapStructureStats& stats() const { return stats_; }
+    void reset() { stats_ = {}; }
+
+private:
+    HeapStructureStats stats_{};
+};
+
+// Counters and peaks as FullStats, but the size refresh runs only on every
+// kSampleInterval-th call, so node and byte peaks are approximate.
+class SampledStats : public FullStats {
+public:
+    static constexpr std::size_t kSampleInterval = 64;
+
+    bool should_sample() { return (++ticks_ & (kSampleInterval - 1)) == 0; }
+    void reset() {
+        FullStats::reset();
+        ticks_ = 0;
+    }
+
+private:
+    std::size_t ticks_ = 0;
+};
+
+// Records nothing; every hook is empty and stats() is all zeros.
+class NoStats {
+public:
+    static constexpr bool kEnabled = false;
+
+    void on_link() {}
+    void on_consolidation() {}
+    void on_height(std::size_t) {}
+    void on_roots(std::size_t) {}
+    static constexpr bool should_sample() { return false; }
+    void on_size(std::size_t, std::size_t) {}
+
+    const HeapStructureStats& stats() const {
+        static const HeapStructureStats empty{};
+        return empty;
+    }
+    void reset() {}
+};
@@ -1,48 +1,358 @@
 #pragma once
 
+#include "HeapAllocators.h"
 #include "HeapStats.h"
 #include "PriorityQueue.h"
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
 #include <utility>
 #include <vector>
-#include <memory>
 
-struct HollowHeapCell;
-
-struct HollowHeapNode {
-	HollowHeapCell* cell = nullptr;
+// Pointers lead so the narrower fields pack into the tail. owner is the
+// handle slot of the element the cell holds; the slot table points back at
+// the element's current cell.
+template <typename Key = long long, typename Value = int>
+struct HollowHeapCell {
+	HollowHeapCell* child;
+	HollowHeapCell* next;
+	HollowHeapCell* second_parent;
+	Key key;
+	Value value;
+	std::uint32_t owner;
+	unsigned rank;
+	bool hollow;
 };
 
-class HollowHeap : public PriorityQueue<HollowHeapNode>
+template <typename Key = long long, typename Value = int, typename Compare = std::less<Key>,
+          typename Alloc = NewDeleteAllocator, typename Stats = FullStats>
+class HollowHeap : public PriorityQueue<Key, Value, Compare>
 {
 public:
+	using Cell = HollowHeapCell<Key, Value>;
+	using Base = PriorityQueue<Key, Value, Compare>;
+
+	// Cell plus its handle-table entry.
+	static constexpr std::size_t kNodeBytes = sizeof(Cell) + sizeof(Cell*);
+
 	HollowHeap();
+	explicit HollowHeap(const Compare& compare);
 	~HollowHeap() override;
 
-	HollowHeapNode* insert(long long key, int value) override;
-	std::pair<long long, int> extract_min() override;
-	std::pair<long long, int> peek_min() const override;
-	void decrease_key(HollowHeapNode* node, long long new_key) override;
-	void merge(PriorityQueue& other) override;
+	HeapHandle insert(Key key, Value value) override;
+	std::pair<Key, Value> extract_min() override;
+	std::pair<Key, Value> peek_min() const override;
+	void decrease_key(HeapHandle handle, Key new_key) override;
+	void merge(Base& other) override;
 	bool is_empty() const override;
-	const HeapStructureStats& structure_stats() const { return stats_; }
+	void clear() override;
+	const HeapStructureStats& structure_stats() const { return stats_.stats(); }
+	const AllocationStats& allocation_stats() const { return alloc_.stats(); }
 
 private:
-	HollowHeapNode* make_handle();
-	HollowHeapCell* make_cell(long long key, int value, HollowHeapNode* owner);
-	HollowHeapCell* link(HollowHeapCell* u, HollowHeapCell* v);
+	static constexpr std::size_t kInitialRankCapacity = 16;
+
+	Cell* make_cell(Key key, Value value, std::uint32_t owner);
+	Cell* link(Cell* u, Cell* v);
 	void ensure_rank_capacity(std::size_t rank);
 	void clear_rankmap();
 
-	HollowHeapCell* root_;
+	Cell* root_;
 	std::size_t active_size_;
 
-	std::vector<std::unique_ptr<HollowHeapNode>> handles_;
-	std::vector<std::unique_ptr<HollowHeapCell>> cells_;
-	std::vector<HollowHeapCell*> rankmap_;
-	std::vector<HollowHeapCell*> to_delete_;
-	HeapStructureStats stats_{};
+	HandleSlots<Cell*> handles_; // handle slot -> the element's current cell
+	std::vector<Cell*> cells_;
+	std::vector<Cell*> rankmap_;
+	std::vector<Cell*> to_delete_;
+	Stats stats_;
+	Compare compare_;
+	Alloc alloc_;
 
 	void update_size_metrics();
 	void note_rank_as_height(unsigned rank);
 };
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+HollowHeap<Key, Value, Compare, Alloc, Stats>::HollowHeap()
+    : HollowHeap(Compare()) {}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+HollowHeap<Key, Value, Compare, Alloc, Stats>::HollowHeap(const Compare& compare)
+    : root_(nullptr), active_size_(0), compare_(compare) {
+    rankmap_.assign(kInitialRankCapacity, nullptr);
+    to_delete_.reserve(32);
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+HollowHeap<Key, Value, Compare, Alloc, Stats>::~HollowHeap() {
+    if constexpr (!releases_nodes_in_bulk<Alloc, Cell>()) {
+        for (Cell* cell : cells_) destroy_node(alloc_, cell);
+    }
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+bool HollowHeap<Key, Value, Compare, Alloc, Stats>::is_empty() const {
+    return root_ == nullptr;
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void HollowHeap<Key, Value, Compare, Alloc, Stats>::clear() {
+    if constexpr (!releases_nodes_in_bulk<Alloc, Cell>()) {
+        for (Cell* cell : cells_) destroy_node(alloc_, cell);
+    }
+    cells_.clear();
+    handles_.clear();
+    clear_rankmap();
+    to_delete_.clear();
+    root_ = nullptr;
+    active_size_ = 0;
+    stats_.reset();
+    alloc_.reset();
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+auto HollowHeap<Key, Value, Compare, Alloc, Stats>::make_cell(Key key, Value value, std::uint32_t owner) -> Cell* {
+    Cell* raw = allocate_node<Cell>(alloc_);
+    raw->key = key;
+    raw->value = value;
+    raw->child = nullptr;
+    raw->next = nullptr;
+    raw->second_parent = nullptr;
+    raw->rank = 0;
+    raw->hollow = false;
+    raw->owner = owner;
+    cells_.push_back(raw);
+    return raw;
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void HollowHeap<Key, Value, Compare, Alloc, Stats>::ensure_rank_capacity(std::size_t rank) {
+    if (rank >= rankmap_.size()) {
+        rankmap_.resize(rank + 1, nullptr);
+    }
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void HollowHeap<Key, Value, Compare, Alloc, Stats>::clear_rankmap() {
+    std::fill(rankmap_.begin(), rankmap_.end(), nullptr);
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+auto HollowHeap<Key, Value, Compare, Alloc, Stats>::link(Cell* u, Cell* v) -> Cell* {
+    if (!u) return v;
+    if (!v) return u;
+
+    stats_.on_link();
+
+    Cell* parent = u;
+    Cell* child = v;
+
+    if (compare_(v->key, u->key)) {
+        parent = v;
+        child = u;
+    } else if (!compare_(u->key, v->key)) {
+        if (v->rank < u->rank) {
+            parent = v;
+            child = u;
+        }
+    }
+
+    child->next = parent->child;
+    parent->child = child;
+    child->second_parent = nullptr;
+    return parent;
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+HeapHandle HollowHeap<Key, Value, Compare, Alloc, Stats>::insert(Key key, Value value) {
+    const HeapHandle handle = handles_.acquire(nullptr);
+    Cell* cell = make_cell(key, value, handle.slot);
+    handles_[handle.slot] = cell;
+    active_size_++;
+    root_ = link(root_, cell);
+    note_rank_as_height(cell->rank);
+    update_size_metrics();
+    return handle;
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void HollowHeap<Key, Value, Compare, Alloc, Stats>::decrease_key(HeapHandle handle, Key new_key) {
+    Cell*& current = handles_.resolve(handle);
+    if (!current) {
+        throw std::invalid_argument("handle is null");
+    }
+    Cell* node = current;
+    if (compare_(node->key, new_key)) {
+        throw std::invalid_argument("new_key is greater than current key");
+    }
+
+    if (node == root_) {
+        node->key = new_key;
+        return;
+    }
+
+    Cell* new_cell = make_cell(new_key, node->value, handle.slot);
+    current = new_cell;
+    if (node->rank > 2) {
+        new_cell->rank = node->rank - 2;
+    }
+    note_rank_as_height(new_cell->rank);
+    node->hollow = true;
+
+    if (!root_) {
+        root_ = new_cell;
+        update_size_metrics();
+        return;
+    }
+
+    Cell* old_root = root_;
+    root_ = link(root_, new_cell);
+    if (root_ == old_root) {
+        new_cell->child = node;
+        node->second_parent = new_cell;
+    }
+    update_size_metrics();
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+std::pair<Key, Value> HollowHeap<Key, Value, Compare, Alloc, Stats>::extract_min() {
+    if (!root_) {
+        throw std::runtime_error("extract_min from empty HollowHeap");
+    }
+
+    stats_.on_consolidation();
+
+    Cell* old_root = root_;
+    std::pair<Key, Value> result(old_root->key, old_root->value);
+    handles_.release(old_root->owner);
+
+    to_delete_.clear();
+    to_delete_.push_back(old_root);
+
+    int max_rank = -1;
+
+    for (std::size_t idx = 0; idx < to_delete_.size(); ++idx) {
+        Cell* parent = to_delete_[idx];
+        Cell* cur = parent->child;
+        parent->child = nullptr;
+
+        while (cur) {
+            Cell* next = cur->next;
+            cur->next = nullptr;
+
+            if (!cur->hollow) {
+                while (true) {
+                    ensure_rank_capacity(cur->rank);
+                    Cell*& slot = rankmap_[cur->rank];
+                    if (!slot) break;
+                    Cell* other = slot;
+                    slot = nullptr;
+                    cur = link(cur, other);
+                    cur->rank++;
+                    note_rank_as_height(cur->rank);
+                }
+                ensure_rank_capacity(cur->rank);
+                rankmap_[cur->rank] = cur;
+                if (static_cast<int>(cur->rank) > max_rank) {
+                    max_rank = static_cast<int>(cur->rank);
+                }
+            } else {
+                if (!cur->second_parent) {
+                    to_delete_.push_back(cur);
+                } else {
+                    if (cur->second_parent == parent) {
+                        cur->second_parent = nullptr;
+                        to_delete_.push_back(cur);
+                    } else {
+                        cur->second_parent = nullptr;
+                        cur->next = nullptr;
+                    }
+                }
+            }
+
+            cur = next;
+        }
+    }
+
+    root_ = nullptr;
+    if (max_rank >= 0) {
+        for (int i = max_rank; i >= 0; --i) {
+            if (i >= static_cast<int>(rankmap_.size())) continue;
+            Cell* node = rankmap_[i];
+            if (!node) continue;
+            if (!root_) {
+                root_ = node;
+            } else {
+                root_ = link(root_, node);
+            }
+            rankmap_[i] = nullptr;
+        }
+    }
+
+    active_size_--;
+    old_root->hollow = true;
+    if (!root_) {
+        clear_rankmap();
+    }
+
+    update_size_metrics();
+
+    return result;
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+std::pair<Key, Value> HollowHeap<Key, Value, Compare, Alloc, Stats>::peek_min() const {
+    if (!root_) {
+        throw std::runtime_error("peek_min from empty HollowHeap");
+    }
+    return {root_->key, root_->value};
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void HollowHeap<Key, Value, Compare, Alloc, Stats>::merge(Base& other_base) {
+    auto* other = dynamic_cast<HollowHeap*>(&other_base);
+    if (!other) throw std::invalid_argument("merge requires another HollowHeap");
+    if (other == this || other->active_size_ == 0) return;
+
+    const std::uint32_t slot_offset = handles_.absorb(other->handles_);
+    for (Cell* cell : other->cells_) {
+        cell->owner += slot_offset;
+    }
+
+    cells_.insert(cells_.end(), other->cells_.begin(), other->cells_.end());
+    other->cells_.clear();
+    alloc_.absorb(other->alloc_);
+
+    if (!root_) {
+        root_ = other->root_;
+    } else if (other->root_) {
+        root_ = link(root_, other->root_);
+    }
+
+    active_size_ += other->active_size_;
+    other->active_size_ = 0;
+    other->root_ = nullptr;
+    other->rankmap_.assign(kInitialRankCapacity, nullptr);
+    other->to_delete_.clear();
+
+    update_size_metrics();
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void HollowHeap<Key, Value, Compare, Alloc, Stats>::update_size_metrics() {
+    if (!stats_.should_sample()) return;
+    stats_.on_roots(root_ ? 1u : 0u);
+    stats_.on_size(active_size_, handles_.capacity_bytes() + cells_.size() * sizeof(Cell));
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void HollowHeap<Key, Value, Compare, Alloc, Stats>::note_rank_as_height(unsigned rank) {
+    const std::size_t height = static_cast<std::size_t>(rank + 1);
+    stats_.on_height(height);
+}
+
+// The instantiations used by the driver are compiled once in HollowHeap.cpp.
+extern template class HollowHeap<long long, int>;
+extern template class HollowHeap<std::uint32_t, int>;
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Dijkstra.h"
+#include "Graph.h"
+
+enum class HubOrdering {
+    // Highest total degree first.
+    kDegree = 1,
+    // Highest contraction hierarchy rank first; much smaller labels on
+    // road networks at the cost of building a hierarchy.
+    kContraction = 2
+};
+
+// Two-hop distance labels from pruned landmark labeling (Akiba et al.),
+// directed: out(v) holds hubs h with d(v, h), in(v) hubs h with d(h, v), and
+// d(s, t) is the minimum of d(s, h) + d(h, t) over hubs in both out(s) and
+// in(t). Hubs are numbered by processing order, so every label is already
+// sorted. A label is one contiguous block, its hub ids then its distances,
+// so a query touches two blocks.
+class HubLabels {
+public:
+    HubLabels() = default;
+
+    // Runs one pruned search per vertex and direction on `queue`. Throws if
+    // a distance needs more than 31 bits (two must sum within 32).
+    static HubLabels build(const Graph& graph, HubOrdering ordering, DijkstraQueue& queue);
+
+    // Binary layout in host byte order: header, then offsets and label
+    // blocks for out labels followed by in labels. load() rejects a file
+    // written for a graph of a different size.
+    void save(const std::string& path) const;
+    static HubLabels load(const std::string& path, const Graph& graph);
+
+    // -1 when target is unreachable. Uses AVX2 when the CPU has it.
+    long long distance(int source, int target) const;
+
+    std::size_t node_count() const { return out_offsets_.empty() ? 0 : out_offsets_.size() - 1; }
+    bool empty() const { return node_count() == 0; }
+    HubOrdering ordering() const { return ordering_; }
+    std::size_t out_entries() const { return out_offsets_.empty() ? 0 : out_offsets_.back(); }
+    std::size_t in_entries() const { return in_offsets_.empty() ? 0 : in_offsets_.back(); }
+    std::size_t label_bytes() const;
+
+private:
+    // Offsets count entries; entry i of a direction starts at word 2 * i.
+    HubOrdering ordering_ = HubOrdering::kContraction;
+    std::vector<std::uint64_t> out_offsets_;
+    std::vector<std::uint32_t> out_labels_;
+    std::vector<std::uint64_t> in_offsets_;
+    std::vector<std::uint32_t> in_labels_;
+};
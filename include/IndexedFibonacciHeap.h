@@ -0,0 +1,440 @@
+#pragma once
+
+#include "HeapHandle.h"
+#include "HeapStats.h"
+#include "PriorityQueue.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// FibonacciHeap with nodes stored in contiguous arrays and linked by 32-bit
+// slot indices. Fields touched while restructuring (key, links, degree, mark)
+// live in the hot array; the payload and the stats-only subtree height live
+// in a separate cold array. Slots of extracted nodes are recycled.
+// A handle's slot is the node's own index.
+// Merging copies the other heap's nodes, so handles into it become invalid.
+template <typename Key = long long, typename Value = int, typename Compare = std::less<Key>,
+          typename Stats = FullStats>
+class IndexedFibonacciHeap : public PriorityQueue<Key, Value, Compare>
+{
+public:
+	using Index = std::uint32_t;
+	using Base = PriorityQueue<Key, Value, Compare>;
+
+	struct HotNode {
+		Key key;
+		Index parent;
+		Index child;
+		Index left;
+		Index right;
+		std::uint16_t degree;
+		bool mark;
+	};
+
+	struct ColdNode {
+		Value value;
+		int subtree_height;
+	};
+
+	static constexpr Index kNil = HeapHandle::kInvalidSlot;
+	static constexpr std::size_t kNodeBytes = sizeof(HotNode) + sizeof(ColdNode);
+
+	IndexedFibonacciHeap();
+	explicit IndexedFibonacciHeap(const Compare& compare);
+
+	HeapHandle insert(Key key, Value value) override;
+	std::pair<Key, Value> extract_min() override;
+	std::pair<Key, Value> peek_min() const override;
+	void decrease_key(HeapHandle handle, Key new_key) override;
+	void merge(Base& other) override;
+	bool is_empty() const override;
+	void clear() override;
+	const HeapStructureStats& structure_stats() const { return stats_.stats(); }
+	const AllocationStats& allocation_stats() const { return alloc_stats_; }
+
+private:
+	std::vector<HotNode> hot_;
+	std::vector<ColdNode> cold_;
+	std::vector<Index> free_slots_;
+	HandleGenerations generations_;
+	std::vector<Index> scratch_;      // root / child lists collected during extract
+	std::vector<Index> degree_table_; // reused by consolidate
+	Index min_ = kNil;
+	std::size_t size_ = 0;
+	std::size_t root_count_ = 0;
+	Stats stats_;
+	AllocationStats alloc_stats_{};
+	Compare compare_;
+
+	Index acquire_slot(Key key, Value value);
+	void add_to_root_list(Index node);
+	void remove_from_root_list(Index node);
+	void consolidate();
+	void link_nodes(Index child, Index parent);
+	void cut(Index node, Index parent);
+	void cascading_cut(Index node);
+	void update_size_metrics();
+	void note_tree_height(int subtree_height);
+};
+
+template <typename Key, typename Value, typename Compare, typename Stats>
+IndexedFibonacciHeap<Key, Value, Compare, Stats>::IndexedFibonacciHeap() : compare_() {}
+
+template <typename Key, typename Value, typename Compare, typename Stats>
+IndexedFibonacciHeap<Key, Value, Compare, Stats>::IndexedFibonacciHeap(const Compare& compare) : compare_(compare) {}
+
+template <typename Key, typename Value, typename Compare, typename Stats>
+bool IndexedFibonacciHeap<Key, Value, Compare, Stats>::is_empty() const {
+    return min_ == kNil;
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats>
+void IndexedFibonacciHeap<Key, Value, Compare, Stats>::clear() {
+    hot_.clear();
+    cold_.clear();
+    free_slots_.clear();
+    generations_.clear();
+    min_ = kNil;
+    size_ = 0;
+    root_count_ = 0;
+    stats_.reset();
+    alloc_stats_.allocations = alloc_stats_.deallocations = alloc_stats_.system_allocations = 0;
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats>
+auto IndexedFibonacciHeap<Key, Value, Compare, Stats>::acquire_slot(Key key, Value value) -> Index {
+    alloc_stats_.allocations++;
+    Index slot;
+    if (!free_slots_.empty()) {
+        slot = free_slots_.back();
+        free_slots_.pop_back();
+        hot_[slot] = HotNode{key, kNil, kNil, slot, slot, 0, false};
+        cold_[slot] = ColdNode{value, 0};
+    } else {
+        if (hot_.size() == hot_.capacity()) {
+            alloc_stats_.system_allocations++;
+        }
+        slot = static_cast<Index>(hot_.size());
+        hot_.push_back(HotNode{key, kNil, kNil, slot, slot, 0, false});
+        cold_.push_back(ColdNode{value, 0});
+        alloc_stats_.reserved_bytes = hot_.capacity() * sizeof(HotNode) + cold_.capacity() * sizeof(ColdNode);
+        alloc_stats_.max_reserved_bytes = std::max(alloc_stats_.max_reserved_bytes, alloc_stats_.reserved_bytes);
+    }
+    return slot;
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats>
+HeapHandle IndexedFibonacciHeap<Key, Value, Compare, Stats>::insert(Key key, Value value) {
+    const Index node = acquire_slot(key, value);
+    add_to_root_list(node);
+    ++size_;
+    update_size_metrics();
+    note_tree_height(cold_[node].subtree_height);
+    return generations_.issue(node);
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats>
+std::pair<Key, Value> IndexedFibonacciHeap<Key, Value, Compare, Stats>::extract_min() {
+    if (min_ == kNil) {
+        throw std::runtime_error("extract_min from empty IndexedFibonacciHeap");
+    }
+
+    const Index z = min_;
+    if (hot_[z].child != kNil) {
+        scratch_.clear();
+        Index current = hot_[z].child;
+        do {
+            scratch_.push_back(current);
+            current = hot_[current].right;
+        } while (current != hot_[z].child);
+
+        for (Index child : scratch_) {
+            HotNode& c = hot_[child];
+            c.parent = kNil;
+            c.mark = false;
+            hot_[c.left].right = c.right;
+            hot_[c.right].left = c.left;
+            c.left = c.right = child;
+            add_to_root_list(child);
+        }
+        hot_[z].child = kNil;
+    }
+
+    remove_from_root_list(z);
+    --size_;
+    update_size_metrics();
+
+    if (min_ != kNil) {
+        consolidate();
+    }
+
+    std::pair<Key, Value> result(hot_[z].key, cold_[z].value);
+    free_slots_.push_back(z);
+    generations_.retire(z);
+    alloc_stats_.deallocations++;
+    return result;
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats>
+std::pair<Key, Value> IndexedFibonacciHeap<Key, Value, Compare, Stats>::peek_min() const {
+    if (min_ == kNil) {
+        throw std::runtime_error("peek_min from empty IndexedFibonacciHeap");
+    }
+    return {hot_[min_].key, cold_[min_].value};
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats>
+void IndexedFibonacciHeap<Key, Value, Compare, Stats>::decrease_key(HeapHandle handle, Key new_key) {
+    if (!handle || handle.slot >= hot_.size()) {
+        throw std::invalid_argument("handle is null");
+    }
+    generations_.check(handle);
+    const Index node = handle.slot;
+    if (compare_(hot_[node].key, new_key)) {
+        throw std::invalid_argument("new_key is greater than current key");
+    }
+
+    hot_[node].key = new_key;
+    const Index parent = hot_[node].parent;
+    if (parent != kNil && compare_(new_key, hot_[parent].key)) {
+        cut(node, parent);
+        cascading_cut(parent);
+    }
+
+    if (min_ == kNil || compare_(new_key, hot_[min_].key)) {
+        min_ = node;
+    }
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats>
+void IndexedFibonacciHeap<Key, Value, Compare, Stats>::merge(Base& other_base) {
+    auto* other = dynamic_cast<IndexedFibonacciHeap*>(&other_base);
+    if (!other) throw std::invalid_argument("merge requires another IndexedFibonacciHeap");
+    if (other == this || other->min_ == kNil) return;
+
+    // Append the other heap's arrays, shifting every link by the slot offset.
+    const Index offset = static_cast<Index>(hot_.size());
+    auto shift = [offset](Index i) { return i == kNil ? kNil : i + offset; };
+    hot_.reserve(hot_.size() + other->hot_.size());
+    cold_.reserve(cold_.size() + other->cold_.size());
+    for (std::size_t i = 0; i < other->hot_.size(); ++i) {
+        HotNode node = other->hot_[i];
+        node.parent = shift(node.parent);
+        node.child = shift(node.child);
+        node.left = shift(node.left);
+        node.right = shift(node.right);
+        hot_.push_back(node);
+        cold_.push_back(other->cold_[i]);
+    }
+    for (Index slot : other->free_slots_) {
+        free_slots_.push_back(slot + offset);
+    }
+    generations_.retire_range(offset, other->hot_.size());
+    alloc_stats_.system_allocations++;
+
+    const Index other_min = other->min_ + offset;
+    if (min_ == kNil) {
+        min_ = other_min;
+        size_ = other->size_;
+        root_count_ = other->root_count_;
+    } else {
+        // splice the two circular root lists
+        const Index a_right = hot_[min_].right;
+        const Index b_left = hot_[other_min].left;
+        hot_[min_].right = other_min;
+        hot_[other_min].left = min_;
+        hot_[a_right].left = b_left;
+        hot_[b_left].right = a_right;
+        if (compare_(hot_[other_min].key, hot_[min_].key)) {
+            min_ = other_min;
+        }
+        size_ += other->size_;
+        root_count_ += other->root_count_;
+    }
+
+    stats_.on_roots(root_count_);
+    update_size_metrics();
+
+    other->hot_.clear();
+    other->cold_.clear();
+    other->free_slots_.clear();
+    other->generations_.clear();
+    other->min_ = kNil;
+    other->size_ = 0;
+    other->root_count_ = 0;
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats>
+void IndexedFibonacciHeap<Key, Value, Compare, Stats>::add_to_root_list(Index node) {
+    HotNode& n = hot_[node];
+    n.parent = kNil;
+    n.mark = false;
+    if (min_ == kNil) {
+        n.left = n.right = node;
+        min_ = node;
+        root_count_ = 1;
+    } else {
+        HotNode& m = hot_[min_];
+        n.left = m.left;
+        n.right = min_;
+        hot_[m.left].right = node;
+        m.left = node;
+        ++root_count_;
+        if (compare_(n.key, m.key)) {
+            min_ = node;
+        }
+    }
+    note_tree_height(cold_[node].subtree_height);
+    stats_.on_roots(root_count_);
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats>
+void IndexedFibonacciHeap<Key, Value, Compare, Stats>::remove_from_root_list(Index node) {
+    HotNode& n = hot_[node];
+    if (n.right == node) {
+        min_ = kNil;
+        root_count_ = 0;
+    } else {
+        hot_[n.left].right = n.right;
+        hot_[n.right].left = n.left;
+        if (min_ == node) {
+            min_ = n.right;
+        }
+        if (root_count_ > 0) {
+            --root_count_;
+        }
+    }
+    n.left = n.right = node;
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats>
+void IndexedFibonacciHeap<Key, Value, Compare, Stats>::link_nodes(Index child, Index parent) {
+    remove_from_root_list(child);
+    HotNode& c = hot_[child];
+    HotNode& p = hot_[parent];
+    c.parent = parent;
+    c.mark = false;
+    if (p.child == kNil) {
+        p.child = child;
+        c.left = c.right = child;
+    } else {
+        HotNode& first = hot_[p.child];
+        c.left = first.left;
+        c.right = p.child;
+        hot_[first.left].right = child;
+        first.left = child;
+    }
+    p.degree++;
+    if constexpr (Stats::kEnabled) {
+        const int candidate_height = cold_[child].subtree_height + 1;
+        if (candidate_height > cold_[parent].subtree_height) {
+            cold_[parent].subtree_height = candidate_height;
+            note_tree_height(candidate_height);
+        }
+    }
+    stats_.on_link();
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats>
+void IndexedFibonacciHeap<Key, Value, Compare, Stats>::consolidate() {
+    if (min_ == kNil) return;
+
+    stats_.on_consolidation();
+
+    scratch_.clear();
+    Index current = min_;
+    do {
+        scratch_.push_back(current);
+        current = hot_[current].right;
+    } while (current != min_);
+
+    std::size_t max_degree = 0;
+    std::size_t n = size_;
+    while (n > 0) {
+        n >>= 1U;
+        ++max_degree;
+    }
+    max_degree += 2;
+    degree_table_.assign(max_degree, kNil);
+
+    for (Index w : scratch_) {
+        Index x = w;
+        std::size_t d = hot_[x].degree;
+        while (true) {
+            if (d >= degree_table_.size()) {
+                degree_table_.resize(d + 1, kNil);
+            }
+            if (degree_table_[d] == kNil) break;
+            Index y = degree_table_[d];
+            if (compare_(hot_[y].key, hot_[x].key)) std::swap(x, y);
+            link_nodes(y, x);
+            degree_table_[d] = kNil;
+            ++d;
+        }
+        degree_table_[d] = x;
+    }
+
+    min_ = kNil;
+    root_count_ = 0;
+    for (Index node : degree_table_) {
+        if (node == kNil) continue;
+        hot_[node].left = hot_[node].right = node;
+        add_to_root_list(node);
+    }
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats>
+void IndexedFibonacciHeap<Key, Value, Compare, Stats>::cut(Index node, Index parent) {
+    HotNode& n = hot_[node];
+    HotNode& p = hot_[parent];
+    if (n.right == node) {
+        p.child = kNil;
+    } else {
+        if (p.child == node) {
+            p.child = n.right;
+        }
+        hot_[n.left].right = n.right;
+        hot_[n.right].left = n.left;
+    }
+    p.degree--;
+    n.left = n.right = node;
+    add_to_root_list(node);
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats>
+void IndexedFibonacciHeap<Key, Value, Compare, Stats>::cascading_cut(Index node) {
+    while (true) {
+        const Index parent = hot_[node].parent;
+        if (parent == kNil) return;
+        if (!hot_[node].mark) {
+            hot_[node].mark = true;
+            return;
+        }
+        cut(node, parent);
+        node = parent;
+    }
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats>
+void IndexedFibonacciHeap<Key, Value, Compare, Stats>::update_size_metrics() {
+    if (!stats_.should_sample()) return;
+    stats_.on_roots(root_count_);
+    stats_.on_size(size_, size_ * kNodeBytes);
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats>
+void IndexedFibonacciHeap<Key, Value, Compare, Stats>::note_tree_height(int subtree_height) {
+    if (subtree_height < 0) {
+        return;
+    }
+    const std::size_t height = static_cast<std::size_t>(subtree_height + 1);
+    stats_.on_height(height);
+}
+
+// The instantiations used by the driver are compiled once in IndexedFibonacciHeap.cpp.
+extern template class IndexedFibonacciHeap<long long, int>;
+extern template class IndexedFibonacciHeap<std::uint32_t, int>;
@@ -0,0 +1,381 @@
+#pragma once
+
+#include "HeapHandle.h"
+#include "HeapStats.h"
+#include "PriorityQueue.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// HollowHeap with cells stored in contiguous arrays and linked by 32-bit
+// indices. The hot array holds what linking and deletion walk (key, child,
+// next, second parent, rank, hollow flag); the payload and owning handle live
+// in a cold array. A handle is a slot in a 4-byte table that points at the
+// element's current cell. Cells released by extract_min are recycled, so
+// hollow cells no longer accumulate for the lifetime of the heap.
+// Merging copies the other heap's cells, so handles into it become invalid.
+template <typename Key = long long, typename Value = int, typename Compare = std::less<Key>,
+          typename Stats = FullStats>
+class IndexedHollowHeap : public PriorityQueue<Key, Value, Compare>
+{
+public:
+	using Index = std::uint32_t;
+	using Base = PriorityQueue<Key, Value, Compare>;
+
+	struct HotCell {
+		Key key;
+		Index child;
+		Index next;
+		Index second_parent;
+		std::uint16_t rank;
+		bool hollow;
+	};
+
+	struct ColdCell {
+		Value value;
+		Index owner;
+	};
+
+	static constexpr Index kNil = HeapHandle::kInvalidSlot;
+	static constexpr std::size_t kNodeBytes = sizeof(HotCell) + sizeof(ColdCell) + sizeof(Index);
+
+	IndexedHollowHeap();
+	explicit IndexedHollowHeap(const Compare& compare);
+
+	HeapHandle insert(Key key, Value value) override;
+	std::pair<Key, Value> extract_min() override;
+	std::pair<Key, Value> peek_min() const override;
+	void decrease_key(HeapHandle handle, Key new_key) override;
+	void merge(Base& other) override;
+	bool is_empty() const override;
+	void clear() override;
+	const HeapStructureStats& structure_stats() const { return stats_.stats(); }
+	const AllocationStats& allocation_stats() const { return alloc_stats_; }
+
+private:
+	static constexpr std::size_t kInitialRankCapacity = 16;
+
+	std::vector<HotCell> hot_;
+	std::vector<ColdCell> cold_;
+	std::vector<Index> handle_cell_; // handle slot -> current cell
+	std::vector<Index> free_cells_;
+	std::vector<Index> free_handles_;
+	HandleGenerations generations_;
+	std::vector<Index> rankmap_;
+	std::vector<Index> to_delete_;
+	Index root_ = kNil;
+	std::size_t active_size_ = 0;
+	Stats stats_;
+	AllocationStats alloc_stats_{};
+	Compare compare_;
+
+	Index acquire_handle();
+	Index acquire_cell(Key key, Value value, Index owner);
+	Index link(Index u, Index v);
+	void update_reserved_bytes();
+	void update_size_metrics();
+	void note_rank_as_height(unsigned rank);
+};
+
+template <typename Key, typename Value, typename Compare, typename Stats>
+IndexedHollowHeap<Key, Value, Compare, Stats>::IndexedHollowHeap() : IndexedHollowHeap(Compare()) {}
+
+template <typename Key, typename Value, typename Compare, typename Stats>
+IndexedHollowHeap<Key, Value, Compare, Stats>::IndexedHollowHeap(const Compare& compare) : compare_(compare) {
+    rankmap_.assign(kInitialRankCapacity, kNil);
+    to_delete_.reserve(32);
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats>
+bool IndexedHollowHeap<Key, Value, Compare, Stats>::is_empty() const {
+    return root_ == kNil;
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats>
+void IndexedHollowHeap<Key, Value, Compare, Stats>::clear() {
+    hot_.clear();
+    cold_.clear();
+    handle_cell_.clear();
+    free_cells_.clear();
+    free_handles_.clear();
+    generations_.clear();
+    std::fill(rankmap_.begin(), rankmap_.end(), kNil);
+    to_delete_.clear();
+    root_ = kNil;
+    active_size_ = 0;
+    stats_.reset();
+    alloc_stats_.allocations = alloc_stats_.deallocations = alloc_stats_.system_allocations = 0;
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats>
+auto IndexedHollowHeap<Key, Value, Compare, Stats>::acquire_handle() -> Index {
+    if (!free_handles_.empty()) {
+        const Index slot = free_handles_.back();
+        free_handles_.pop_back();
+        return slot;
+    }
+    if (handle_cell_.size() == handle_cell_.capacity()) {
+        alloc_stats_.system_allocations++;
+    }
+    handle_cell_.push_back(kNil);
+    update_reserved_bytes();
+    return static_cast<Index>(handle_cell_.size() - 1);
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats>
+auto IndexedHollowHeap<Key, Value, Compare, Stats>::acquire_cell(Key key, Value value, Index owner) -> Index {
+    alloc_stats_.allocations++;
+    const HotCell hot{key, kNil, kNil, kNil, 0, false};
+    const ColdCell cold{value, owner};
+    if (!free_cells_.empty()) {
+        const Index cell = free_cells_.back();
+        free_cells_.pop_back();
+        hot_[cell] = hot;
+        cold_[cell] = cold;
+        return cell;
+    }
+    if (hot_.size() == hot_.capacity()) {
+        alloc_stats_.system_allocations++;
+    }
+    hot_.push_back(hot);
+    cold_.push_back(cold);
+    update_reserved_bytes();
+    return static_cast<Index>(hot_.size() - 1);
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats>
+auto IndexedHollowHeap<Key, Value, Compare, Stats>::link(Index u, Index v) -> Index {
+    if (u == kNil) return v;
+    if (v == kNil) return u;
+
+    stats_.on_link();
+
+    Index parent = u;
+    Index child = v;
+    const HotCell& hu = hot_[u];
+    const HotCell& hv = hot_[v];
+    if (compare_(hv.key, hu.key) || (!compare_(hu.key, hv.key) && hv.rank < hu.rank)) {
+        parent = v;
+        child = u;
+    }
+
+    hot_[child].next = hot_[parent].child;
+    hot_[parent].child = child;
+    return parent;
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats>
+HeapHandle IndexedHollowHeap<Key, Value, Compare, Stats>::insert(Key key, Value value) {
+    const Index handle = acquire_handle();
+    const Index cell = acquire_cell(key, value, handle);
+    handle_cell_[handle] = cell;
+    active_size_++;
+    root_ = link(root_, cell);
+    note_rank_as_height(0);
+    update_size_metrics();
+    return generations_.issue(handle);
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats>
+void IndexedHollowHeap<Key, Value, Compare, Stats>::decrease_key(HeapHandle handle, Key new_key) {
+    if (!handle || handle.slot >= handle_cell_.size() || handle_cell_[handle.slot] == kNil) {
+        throw std::invalid_argument("handle is null");
+    }
+    generations_.check(handle);
+    const Index node = handle_cell_[handle.slot];
+    if (compare_(hot_[node].key, new_key)) {
+        throw std::invalid_argument("new_key is greater than current key");
+    }
+
+    if (node == root_) {
+        hot_[node].key = new_key;
+        return;
+    }
+
+    // The old cell turns hollow and becomes the last child of its
+    // replacement, which gives it a second parent.
+    const Index fresh = acquire_cell(new_key, cold_[node].value, handle.slot);
+    handle_cell_[handle.slot] = fresh;
+    HotCell& old_cell = hot_[node];
+    HotCell& new_cell = hot_[fresh];
+    if (old_cell.rank > 2) {
+        new_cell.rank = static_cast<std::uint16_t>(old_cell.rank - 2);
+    }
+    old_cell.hollow = true;
+    old_cell.second_parent = fresh;
+    new_cell.child = node;
+    note_rank_as_height(new_cell.rank);
+
+    root_ = link(fresh, root_);
+    update_size_metrics();
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats>
+std::pair<Key, Value> IndexedHollowHeap<Key, Value, Compare, Stats>::extract_min() {
+    if (root_ == kNil) {
+        throw std::runtime_error("extract_min from empty IndexedHollowHeap");
+    }
+
+    stats_.on_consolidation();
+
+    const Index old_root = root_;
+    std::pair<Key, Value> result(hot_[old_root].key, cold_[old_root].value);
+    const Index owner = cold_[old_root].owner;
+    handle_cell_[owner] = kNil;
+    free_handles_.push_back(owner);
+    generations_.retire(owner);
+    hot_[old_root].hollow = true;
+
+    to_delete_.clear();
+    to_delete_.push_back(old_root);
+
+    int max_rank = -1;
+
+    for (std::size_t idx = 0; idx < to_delete_.size(); ++idx) {
+        const Index parent = to_delete_[idx];
+        Index cur = hot_[parent].child;
+        hot_[parent].child = kNil;
+
+        while (cur != kNil) {
+            Index next = hot_[cur].next;
+
+            if (hot_[cur].hollow) {
+                if (hot_[cur].second_parent == kNil) {
+                    // parent was its only parent: delete it as well
+                    to_delete_.push_back(cur);
+                } else {
+                    if (hot_[cur].second_parent == parent) {
+                        // cur is the last child of its second parent and stays
+                        // in its first parent's list
+                        next = kNil;
+                    } else {
+                        // only the second parent is left; cur is its last child
+                        hot_[cur].next = kNil;
+                    }
+                    hot_[cur].second_parent = kNil;
+                }
+            } else {
+                hot_[cur].next = kNil;
+                while (true) {
+                    if (hot_[cur].rank >= rankmap_.size()) {
+                        rankmap_.resize(hot_[cur].rank + 1u, kNil);
+                    }
+                    Index& slot = rankmap_[hot_[cur].rank];
+                    if (slot == kNil) break;
+                    const Index other = slot;
+                    slot = kNil;
+                    cur = link(cur, other);
+                    hot_[cur].rank++;
+                    note_rank_as_height(hot_[cur].rank);
+                }
+                rankmap_[hot_[cur].rank] = cur;
+                max_rank = std::max(max_rank, static_cast<int>(hot_[cur].rank));
+            }
+
+            cur = next;
+        }
+    }
+
+    root_ = kNil;
+    for (int i = max_rank; i >= 0; --i) {
+        Index& slot = rankmap_[static_cast<std::size_t>(i)];
+        if (slot == kNil) continue;
+        root_ = link(root_, slot);
+        slot = kNil;
+    }
+
+    alloc_stats_.deallocations += to_delete_.size();
+    free_cells_.insert(free_cells_.end(), to_delete_.begin(), to_delete_.end());
+    active_size_--;
+    update_size_metrics();
+
+    return result;
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats>
+std::pair<Key, Value> IndexedHollowHeap<Key, Value, Compare, Stats>::peek_min() const {
+    if (root_ == kNil) {
+        throw std::runtime_error("peek_min from empty IndexedHollowHeap");
+    }
+    return {hot_[root_].key, cold_[root_].value};
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats>
+void IndexedHollowHeap<Key, Value, Compare, Stats>::merge(Base& other_base) {
+    auto* other = dynamic_cast<IndexedHollowHeap*>(&other_base);
+    if (!other) throw std::invalid_argument("merge requires another IndexedHollowHeap");
+    if (other == this || other->active_size_ == 0) return;
+
+    // Append the other heap's cells and handle table, shifting every index.
+    const Index cell_offset = static_cast<Index>(hot_.size());
+    const Index handle_offset = static_cast<Index>(handle_cell_.size());
+    auto shift = [](Index i, Index offset) { return i == kNil ? kNil : i + offset; };
+    for (std::size_t i = 0; i < other->hot_.size(); ++i) {
+        HotCell cell = other->hot_[i];
+        cell.child = shift(cell.child, cell_offset);
+        cell.next = shift(cell.next, cell_offset);
+        cell.second_parent = shift(cell.second_parent, cell_offset);
+        hot_.push_back(cell);
+        ColdCell cold = other->cold_[i];
+        cold.owner = shift(cold.owner, handle_offset);
+        cold_.push_back(cold);
+    }
+    for (Index cell : other->handle_cell_) {
+        handle_cell_.push_back(shift(cell, cell_offset));
+    }
+    for (Index cell : other->free_cells_) {
+        free_cells_.push_back(cell + cell_offset);
+    }
+    for (Index handle : other->free_handles_) {
+        free_handles_.push_back(handle + handle_offset);
+    }
+    generations_.retire_range(handle_offset, other->handle_cell_.size());
+    alloc_stats_.system_allocations++;
+    update_reserved_bytes();
+
+    root_ = link(root_, other->root_ + cell_offset);
+    active_size_ += other->active_size_;
+
+    other->hot_.clear();
+    other->cold_.clear();
+    other->handle_cell_.clear();
+    other->free_cells_.clear();
+    other->free_handles_.clear();
+    other->generations_.clear();
+    other->rankmap_.assign(kInitialRankCapacity, kNil);
+    other->to_delete_.clear();
+    other->root_ = kNil;
+    other->active_size_ = 0;
+
+    update_size_metrics();
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats>
+void IndexedHollowHeap<Key, Value, Compare, Stats>::update_reserved_bytes() {
+    alloc_stats_.reserved_bytes = hot_.capacity() * sizeof(HotCell) + cold_.capacity() * sizeof(ColdCell) +
+                                  handle_cell_.capacity() * sizeof(Index);
+    alloc_stats_.max_reserved_bytes = std::max(alloc_stats_.max_reserved_bytes, alloc_stats_.reserved_bytes);
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats>
+void IndexedHollowHeap<Key, Value, Compare, Stats>::update_size_metrics() {
+    if (!stats_.should_sample()) return;
+    stats_.on_roots(root_ != kNil ? 1u : 0u);
+    const std::size_t live_cells = hot_.size() - free_cells_.size();
+    const std::size_t live_handles = handle_cell_.size() - free_handles_.size();
+    stats_.on_size(active_size_, live_cells * (sizeof(HotCell) + sizeof(ColdCell)) + live_handles * sizeof(Index));
+}
+
+template <typename Key, typename Value, typename Compare, typename Stats>
+void IndexedHollowHeap<Key, Value, Compare, Stats>::note_rank_as_height(unsigned rank) {
+    const std::size_t height = static_cast<std::size_t>(rank + 1);
+    stats_.on_height(height);
+}
+
+// The instantiations used by the driver are compiled once in IndexedHollowHeap.cpp.
+extern template class IndexedHollowHeap<long long, int>;
+extern template class IndexedHollowHeap<std::uint32_t, int>;
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Dijkstra.h"
+#include "Graph.h"
+
+enum class LandmarkSelection {
+    // Each landmark is the reachable vertex farthest from those chosen so far.
+    kFarthest = 1,
+    // Goldberg-Werneck avoid: grow a shortest-path tree from a random root
+    // and descend into the subtree whose bounds are currently worst.
+    kAvoid = 2
+};
+
+// Distances from and to k landmark vertices, for ALT lower bounds by the
+// triangle inequality: d(v, t) >= d(L, t) - d(L, v) and d(v, L) - d(t, L).
+// Rows are per vertex (k forward then k backward entries) so one bound reads
+// a single contiguous row per endpoint. Distances are 32-bit; unreachable
+// pairs hold kUnreachable and contribute no bound.
+class LandmarkTable {
+public:
+    static constexpr std::uint32_t kUnreachable = 0xFFFFFFFFu;
+
+    LandmarkTable() = default;
+
+    // Runs two searches per landmark (run_dijkstra on the graph and on its
+    // reverse) plus one per avoid root. Throws if a distance needs more than
+    // 32 bits.
+    static LandmarkTable build(const Graph& graph, std::size_t count, LandmarkSelection selection,
+                               DijkstraQueue& queue, std::uint32_t seed);
+
+    // Binary layout in host byte order: header, landmark ids, then the rows.
+    // load() rejects a file written for a graph of a different size.
+    void save(const std::string& path) const;
+    static LandmarkTable load(const std::string& path, const Graph& graph);
+
+    std::size_t size() const { return landmarks_.size(); }
+    bool empty() const { return landmarks_.empty(); }
+    const std::vector<int>& landmarks() const { return landmarks_; }
+    LandmarkSelection selection() const { return selection_; }
+    std::size_t table_bytes() const { return rows_.size() * sizeof(std::uint32_t); }
+
+    // The `limit` landmarks giving the largest bound on d(source, target);
+    // ALT queries restrict themselves to these.
+    std::vector<std::size_t> best_landmarks(int source, int target, std::size_t limit) const;
+    // Lower bounds on d(from, to); effectively infinite (max / 4) when a
+    // landmark proves `to` unreachable from `from`.
+    long long lower_bound(int from, int to, const std::vector<std::size_t>& subset) const;
+    long long lower_bound(int from, int to) const;
+
+private:
+    // Rows are 2 * stride_ wide; while building, only the first
+    // landmarks_.size() columns of each half are filled.
+    const std::uint32_t* row(int vertex) const { return rows_.data() + static_cast<std::size_t>(vertex) * 2 * stride_; }
+    long long bound_via(std::size_t landmark, const std::uint32_t* from, const std::uint32_t* to) const;
+
+    std::size_t node_count_ = 0;
+    std::size_t stride_ = 0;
+    LandmarkSelection selection_ = LandmarkSelection::kAvoid;
+    std::vector<int> landmarks_;
+    std::vector<std::uint32_t> rows_;
+};
+
+// A* whose potential is the landmark bound to target, over the best
+// kActiveLandmarks landmarks for this source-target pair.
+inline constexpr std::size_t kActiveLandmarks = 4;
+PointToPointResult run_alt(const Graph& graph, const LandmarkTable& table, int source, int target,
+                           DijkstraQueue& queue);
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Log-linear histogram of per-operation latencies in nanoseconds: exact below
+// kLinear, then kSubBuckets buckets per power of two (about 12% resolution),
+// up to 2^40 ns. The maximum is kept exactly.
+class LatencyHistogram {
+public:
+    static constexpr std::size_t kSubBits = 3;
+    static constexpr std::size_t kSubBuckets = std::size_t{1} << kSubBits;
+    static constexpr std::size_t kLinear = 2 * kSubBuckets;
+    static constexpr std::size_t kMaxExponent = 40;
+    static constexpr std::size_t kBuckets = kLinear + (kMaxExponent - kSubBits - 1) * kSubBuckets;
+
+    void record(long long ns) {
+        const std::uint64_t value = ns > 0 ? static_cast<std::uint64_t>(ns) : 0;
+        counts_[bucket_of(value)]++;
+        count_++;
+        max_ns_ = std::max(max_ns_, value);
+    }
+
+    void merge(const LatencyHistogram& other) {
+        for (std::size_t i = 0; i < kBuckets; ++i) counts_[i] += other.counts_[i];
+        count_ += other.count_;
+        max_ns_ = std::max(max_ns_, other.max_ns_);
+    }
+
+    std::uint64_t count() const { return count_; }
+    std::uint64_t max_ns() const { return max_ns_; }
+
+    // Upper bound of the bucket holding the q-quantile (0 < q <= 1), capped
+    // at the recorded maximum; 0 when empty.
+    std::uint64_t percentile_ns(double q) const {
+        if (count_ == 0) return 0;
+        auto rank = static_cast<std::uint64_t>(q * static_cast<double>(count_));
+        rank = std::clamp<std::uint64_t>(rank, 1, count_);
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < kBuckets; ++i) {
+            seen += counts_[i];
+            if (seen >= rank) return std::min(bucket_upper(i), max_ns_);
+        }
+        return max_ns_;
+    }
+
+private:
+    static std::size_t highest_bit(std::uint64_t value) {
+#if defined(__GNUC__)
+        return 63 - static_cast<std::size_t>(__builtin_clzll(value));
+#else
+        std::size_t bit = 0;
+        while (value >>= 1) ++bit;
+        return bit;
+#endif
+    }
+
+    static std::size_t bucket_of(std::uint64_t value) {
+        if (value < kLinear) return static_cast<std::size_t>(value);
+        const std::size_t exponent = highest_bit(value);
+        if (exponent >= kMaxExponent) return kBuckets - 1;
+        const std::size_t sub = static_cast<std::size_t>(value >> (exponent - kSubBits)) & (kSubBuckets - 1);
+        return kLinear + (exponent - kSubBits - 1) * kSubBuckets + sub;
+    }
+
+    static std::uint64_t bucket_upper(std::size_t bucket) {
+        if (bucket < kLinear) return bucket;
+        const std::size_t offset = bucket - kLinear;
+        const std::size_t exponent = offset / kSubBuckets + kSubBits + 1;
+        const std::uint64_t sub = offset % kSubBuckets;
+        const std::uint64_t width = std::uint64_t{1} << (exponent - kSubBits);
+        return (std::uint64_t{1} << exponent) + (sub + 1) * width - 1;
+    }
+
+    std::array<std::uint64_t, kBuckets> counts_{};
+    std::uint64_t count_ = 0;
+    std::uint64_t max_ns_ = 0;
+};
@@ -0,0 +1,266 @@
+#pragma once
+
+#include "HeapAllocators.h"
+#include "HeapStats.h"
+#include "PriorityQueue.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+template <typename Key = long long, typename Value = int>
+struct LeftistHeapNode {
+    LeftistHeapNode* left;
+    LeftistHeapNode* right;
+    LeftistHeapNode* parent;
+    Key key;
+    Value value;
+    std::uint32_t slot;
+    std::uint32_t rank;   // length of the right spine (null path length)
+    std::uint32_t height; // upper bound on subtree depth, kept only for stats
+};
+
+// Leftist heap (Crane): a heap-ordered binary tree whose right spine is at
+// most log2(n + 1) nodes long, so two heaps meld in O(log n) by merging their
+// right spines. decrease_key cuts the subtree, restores ranks on the path
+// above it and melds the subtree back into the root.
+template <typename Key = long long, typename Value = int, typename Compare = std::less<Key>,
+          typename Alloc = NewDeleteAllocator, typename Stats = FullStats>
+class LeftistHeap : public PriorityQueue<Key, Value, Compare>
+{
+public:
+    using Node = LeftistHeapNode<Key, Value>;
+    using Base = PriorityQueue<Key, Value, Compare>;
+
+    // Node plus its handle-table entry.
+    static constexpr std::size_t kNodeBytes = sizeof(Node) + sizeof(Node*);
+
+    LeftistHeap();
+    explicit LeftistHeap(const Compare& compare);
+    ~LeftistHeap() override;
+
+    HeapHandle insert(Key key, Value value) override;
+    std::pair<Key, Value> extract_min() override;
+    std::pair<Key, Value> peek_min() const override;
+    void decrease_key(HeapHandle handle, Key new_key) override;
+    void merge(Base& other) override;
+    bool is_empty() const override;
+    void clear() override;
+    const HeapStructureStats& structure_stats() const { return stats_.stats(); }
+    const AllocationStats& allocation_stats() const { return alloc_.stats(); }
+
+private:
+    Node* root_ = nullptr;
+    std::size_t size_ = 0;
+    std::vector<Node*> path_; // right-spine nodes touched by the current meld
+    HandleSlots<Node*> slots_;
+    Stats stats_;
+    Compare compare_;
+    Alloc alloc_;
+
+    static std::uint32_t rank_of(const Node* node) { return node ? node->rank : 0; }
+    static std::uint32_t height_of(const Node* node) { return node ? node->height : 0; }
+
+    Node* meld(Node* a, Node* b);
+    void restore(Node* node);
+    void delete_all(Node* node);
+    void update_size_metrics();
+};
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+LeftistHeap<Key, Value, Compare, Alloc, Stats>::LeftistHeap() : LeftistHeap(Compare()) {}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+LeftistHeap<Key, Value, Compare, Alloc, Stats>::LeftistHeap(const Compare& compare) : compare_(compare) {}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+LeftistHeap<Key, Value, Compare, Alloc, Stats>::~LeftistHeap() {
+    if constexpr (!releases_nodes_in_bulk<Alloc, Node>()) {
+        delete_all(root_);
+    }
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+bool LeftistHeap<Key, Value, Compare, Alloc, Stats>::is_empty() const {
+    return root_ == nullptr;
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void LeftistHeap<Key, Value, Compare, Alloc, Stats>::clear() {
+    if constexpr (!releases_nodes_in_bulk<Alloc, Node>()) {
+        delete_all(root_);
+    }
+    root_ = nullptr;
+    size_ = 0;
+    slots_.clear();
+    stats_.reset();
+    alloc_.reset();
+}
+
+// Merges the right spines top-down, then swaps children bottom-up wherever
+// the right rank exceeds the left. Both arguments must be roots.
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+auto LeftistHeap<Key, Value, Compare, Alloc, Stats>::meld(Node* a, Node* b) -> Node* {
+    if (!a) return b;
+    if (!b) return a;
+    if (compare_(b->key, a->key)) std::swap(a, b);
+    Node* root = a;
+
+    path_.clear();
+    while (true) {
+        path_.push_back(a);
+        stats_.on_link();
+        Node* right = a->right;
+        if (!right) {
+            a->right = b;
+            b->parent = a;
+            break;
+        }
+        if (compare_(b->key, right->key)) {
+            a->right = b;
+            b->parent = a;
+            a = b;
+            b = right;
+        } else {
+            a = right;
+        }
+    }
+    for (auto it = path_.rbegin(); it != path_.rend(); ++it) {
+        Node* node = *it;
+        if (rank_of(node->left) < rank_of(node->right)) std::swap(node->left, node->right);
+        node->rank = rank_of(node->right) + 1;
+        if constexpr (Stats::kEnabled) {
+            node->height = std::max(height_of(node->left), height_of(node->right)) + 1;
+        }
+    }
+    stats_.on_height(height_of(root));
+    return root;
+}
+
+// node lost a child: swap and re-rank upward until a rank stops changing.
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void LeftistHeap<Key, Value, Compare, Alloc, Stats>::restore(Node* node) {
+    while (node) {
+        if (rank_of(node->left) < rank_of(node->right)) std::swap(node->left, node->right);
+        const std::uint32_t rank = rank_of(node->right) + 1;
+        if (rank == node->rank) return;
+        node->rank = rank;
+        node = node->parent;
+    }
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+HeapHandle LeftistHeap<Key, Value, Compare, Alloc, Stats>::insert(Key key, Value value) {
+    auto* node = allocate_node<Node>(alloc_);
+    node->left = nullptr;
+    node->right = nullptr;
+    node->parent = nullptr;
+    node->key = key;
+    node->value = value;
+    node->rank = 1;
+    node->height = 1;
+    const HeapHandle handle = slots_.acquire(node);
+    node->slot = handle.slot;
+    root_ = meld(root_, node);
+    ++size_;
+    update_size_metrics();
+    return handle;
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+std::pair<Key, Value> LeftistHeap<Key, Value, Compare, Alloc, Stats>::extract_min() {
+    if (!root_) {
+        throw std::runtime_error("extract_min from empty LeftistHeap");
+    }
+    Node* z = root_;
+    if (z->left) z->left->parent = nullptr;
+    if (z->right) z->right->parent = nullptr;
+    root_ = meld(z->left, z->right);
+    --size_;
+    update_size_metrics();
+
+    std::pair<Key, Value> result(z->key, z->value);
+    slots_.release(z->slot);
+    destroy_node(alloc_, z);
+    return result;
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+std::pair<Key, Value> LeftistHeap<Key, Value, Compare, Alloc, Stats>::peek_min() const {
+    if (!root_) {
+        throw std::runtime_error("peek_min from empty LeftistHeap");
+    }
+    return {root_->key, root_->value};
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void LeftistHeap<Key, Value, Compare, Alloc, Stats>::decrease_key(HeapHandle handle, Key new_key) {
+    Node* node = slots_.resolve(handle);
+    if (!node) {
+        throw std::invalid_argument("node is null");
+    }
+    if (compare_(node->key, new_key)) {
+        throw std::invalid_argument("new_key is greater than current key");
+    }
+    node->key = new_key;
+
+    Node* parent = node->parent;
+    if (!parent || !compare_(node->key, parent->key)) return;
+
+    if (parent->left == node) {
+        parent->left = nullptr;
+    } else {
+        parent->right = nullptr;
+    }
+    node->parent = nullptr;
+    restore(parent);
+    root_ = meld(root_, node);
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void LeftistHeap<Key, Value, Compare, Alloc, Stats>::merge(Base& other_base) {
+    auto* other = dynamic_cast<LeftistHeap*>(&other_base);
+    if (!other) throw std::invalid_argument("merge requires another LeftistHeap");
+    if (other == this || !other->root_) return;
+
+    root_ = meld(root_, other->root_);
+    size_ += other->size_;
+    update_size_metrics();
+
+    const std::uint32_t slot_offset = slots_.absorb(other->slots_);
+    for (std::uint32_t slot = slot_offset; slot < slots_.size(); ++slot) {
+        if (Node* node = slots_[slot]) node->slot = slot;
+    }
+
+    other->root_ = nullptr;
+    other->size_ = 0;
+    alloc_.absorb(other->alloc_);
+}
+
+// Iterative: a tree cut apart by decrease_key can be far deeper than its rank.
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void LeftistHeap<Key, Value, Compare, Alloc, Stats>::delete_all(Node* node) {
+    path_.clear();
+    if (node) path_.push_back(node);
+    while (!path_.empty()) {
+        Node* current = path_.back();
+        path_.pop_back();
+        if (current->left) path_.push_back(current->left);
+        if (current->right) path_.push_back(current->right);
+        destroy_node(alloc_, current);
+    }
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void LeftistHeap<Key, Value, Compare, Alloc, Stats>::update_size_metrics() {
+    if (!stats_.should_sample()) return;
+    stats_.on_roots(root_ ? 1 : 0);
+    stats_.on_size(size_, size_ * sizeof(Node) + slots_.capacity_bytes());
+}
+
+// The instantiations used by the driver are compiled once in LeftistHeap.cpp.
+extern template class LeftistHeap<long long, int>;
+extern template class LeftistHeap<std::uint32_t, int>;
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Dijkstra.h"
+#include "Graph.h"
+
+// Customizable route planning (Delling et al.). The vertices are split once
+// into nested cells, from the topology alone. Customization then fills, per
+// cell, a clique of distances between its boundary vertices (those with an
+// arc crossing the cell border), and is the only step to rerun when weights
+// change. A query is bidirectional Dijkstra over original arcs in the
+// finest cells of source and target, and over the coarsest cliques that
+// contain neither anywhere else.
+class MultilevelOverlay {
+public:
+    MultilevelOverlay() = default;
+
+    // One level per entry of cell_sizes, finest first; each caps the mean
+    // vertices per cell and must exceed the previous one. Every level is a
+    // BFS-grown partition of the cells of the level below.
+    static MultilevelOverlay build(const Graph& graph, const std::vector<std::size_t>& cell_sizes,
+                                   std::uint32_t seed);
+
+    // Recomputes every clique from graph's current weights, level by level.
+    // The cells of a level are shared among `threads` workers, each running
+    // searches on its own queue. graph must have the partitioned topology.
+    void customize(const Graph& graph, HeapSelection selection, AllocatorPolicy allocator, std::size_t threads);
+
+    // Needs a customized overlay. The path lists the vertices the search
+    // passed through: a clique hop is not unpacked to original edges.
+    // Reuses internal scratch, so one overlay must not be queried from two
+    // threads at once.
+    PointToPointResult query(const Graph& graph, int source, int target, DijkstraQueue& queue_fwd,
+                             DijkstraQueue& queue_bwd) const;
+
+    std::size_t node_count() const { return levels_.empty() ? 0 : levels_.front().cell.size(); }
+    std::size_t level_count() const { return levels_.size(); }
+    std::size_t cell_count(std::size_t level) const { return levels_[level].boundary_offsets.size() - 1; }
+    std::size_t boundary_count(std::size_t level) const { return levels_[level].boundary.size(); }
+    std::size_t clique_entries() const;
+    bool customized() const { return customized_; }
+
+private:
+    // Cells of one level. A cell's boundary vertices are listed by id, and
+    // its clique is a row-major matrix over them (kInfinity if unreachable
+    // inside the cell).
+    struct Level {
+        std::vector<int> cell;
+        std::vector<std::size_t> boundary_offsets;
+        std::vector<int> boundary;
+        std::vector<int> boundary_index; // position in its cell's list, or -1
+        std::vector<std::size_t> clique_offsets;
+        std::vector<long long> cliques;
+    };
+
+    // One customization thread's queue and search state.
+    struct Worker {
+        std::unique_ptr<DijkstraQueue> queue;
+        std::vector<long long> distances;
+        std::vector<int> touched;
+    };
+
+    struct Side {
+        std::vector<long long> distances;
+        std::vector<int> parents;
+        std::vector<int> touched;
+    };
+
+    void customize_cell(const Graph& graph, std::size_t level, std::size_t cell, Worker& worker);
+
+    std::vector<Level> levels_;
+    bool customized_ = false;
+    mutable Side sides_[2];
+};
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Graph.h"
+
+enum class PartitionMethod {
+    // Regions grown breadth-first from hop-spread seeds, smallest region first.
+    kBfsGrown = 1,
+    // Recursive bisection at the median along the principal axis of the
+    // vertex coordinates. Needs graph.has_coordinates().
+    kInertial = 2
+};
+
+// Neighbor lists of abstract units (vertices, or cells of a finer level),
+// ignoring direction. Duplicates are harmless.
+using UnitAdjacency = std::vector<std::vector<int>>;
+
+UnitAdjacency undirected_adjacency(const Graph& graph);
+
+// Region id in [0, regions) per unit. Units the seeds cannot reach join the
+// smallest region.
+std::vector<int> bfs_grown_partition(const UnitAdjacency& adjacency, std::size_t regions, std::uint32_t seed);
+std::vector<int> inertial_partition(const Graph& graph, std::size_t regions);
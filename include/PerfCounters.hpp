@@ -0,0 +1,73 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Counts last-level cache misses of the calling thread between Start() and
+// Stop() through perf_event_open. Where the counter is unavailable (non-Linux,
+// containers without a PMU, perf_event_paranoid too high) Available() is false
+// and Misses() returns -1.
+class CacheMissCounter
+{
+private:
+    int fd = -1;
+    long long misses = -1;
+
+public:
+    CacheMissCounter()
+    {
+#if defined(__linux__)
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+
+    ~CacheMissCounter()
+    {
+#if defined(__linux__)
+        if (fd >= 0) close(fd);
+#endif
+    }
+
+    CacheMissCounter(const CacheMissCounter&) = delete;
+    CacheMissCounter& operator=(const CacheMissCounter&) = delete;
+
+    bool Available() const { return fd >= 0; }
+
+    void Start()
+    {
+#if defined(__linux__)
+        if (fd < 0) return;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    void Stop()
+    {
+#if defined(__linux__)
+        if (fd < 0) return;
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        std::uint64_t value = 0;
+        if (read(fd, &value, sizeof(value)) == static_cast<ssize_t>(sizeof(value))) {
+            misses = static_cast<long long>(value);
+        }
+#endif
+    }
+
+    // Misses counted by the last Start()/Stop() pair, or -1 if unavailable.
+    long long Misses() const { return misses; }
+};
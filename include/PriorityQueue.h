@@ -1,15 +1,29 @@
 #pragma once
+#include "HeapHandle.h"
+#include <functional>
 #include <utility>
 
-template <typename Nodetype>
+// Common interface for every heap. Keys are ordered by Compare (min-heap on
+// std::less); values are opaque payloads returned alongside the key. insert
+// hands back a HeapHandle for decrease_key; it stays valid until the element
+// is extracted. merge moves other's elements in and invalidates its handles.
+template <typename Key = long long, typename Value = int, typename Compare = std::less<Key>>
 class PriorityQueue
 {
 public:
-    virtual Nodetype* insert(long long key, int value) = 0;
-    virtual std::pair<long long, int> extract_min() = 0;
-    virtual std::pair<long long, int> peek_min() const = 0;
-    virtual void decrease_key(Nodetype* node, long long new_key) = 0;
+    using handle_type = HeapHandle;
+    using key_type = Key;
+    using value_type = Value;
+    using key_compare = Compare;
+
+    virtual HeapHandle insert(Key key, Value value) = 0;
+    virtual std::pair<Key, Value> extract_min() = 0;
+    virtual std::pair<Key, Value> peek_min() const = 0;
+    virtual void decrease_key(HeapHandle handle, Key new_key) = 0;
     virtual void merge(PriorityQueue& other) = 0;
     virtual bool is_empty() const = 0;
+    // Drops every element and invalidates all handles, keeping the storage
+    // so the heap can be reused without reallocating.
+    virtual void clear() = 0;
     virtual ~PriorityQueue() = default;
 };
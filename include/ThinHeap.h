@@ -0,0 +1,358 @@
+#pragma once
+
+#include "HeapAllocators.h"
+#include "HeapStats.h"
+#include "PriorityQueue.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Three pointers and no parent or mark: left is the previous sibling, or the
+// parent for a first child, and is null for roots (which chain through right).
+template <typename Key = long long, typename Value = int>
+struct ThinHeapNode {
+    ThinHeapNode* child; // first child, which has the highest rank
+    ThinHeapNode* left;
+    ThinHeapNode* right;
+    Key key;
+    Value value;
+    std::uint32_t slot;
+    std::uint32_t rank;
+};
+
+// Thin heap (Kaplan and Tarjan): Fibonacci-heap bounds with rank-ordered
+// child lists instead of parent pointers and marks. A node is thick when its
+// first child has rank one less than its own (or it is a leaf of rank 0) and
+// thin when that gap is two; roots are always thick. decrease_key cuts the
+// node and repairs ranks by walking left pointers from where it was.
+template <typename Key = long long, typename Value = int, typename Compare = std::less<Key>,
+          typename Alloc = NewDeleteAllocator, typename Stats = FullStats>
+class ThinHeap : public PriorityQueue<Key, Value, Compare>
+{
+public:
+    using Node = ThinHeapNode<Key, Value>;
+    using Base = PriorityQueue<Key, Value, Compare>;
+
+    // Node plus its handle-table entry.
+    static constexpr std::size_t kNodeBytes = sizeof(Node) + sizeof(Node*);
+
+    ThinHeap();
+    explicit ThinHeap(const Compare& compare);
+    ~ThinHeap() override;
+
+    HeapHandle insert(Key key, Value value) override;
+    std::pair<Key, Value> extract_min() override;
+    std::pair<Key, Value> peek_min() const override;
+    void decrease_key(HeapHandle handle, Key new_key) override;
+    void merge(Base& other) override;
+    bool is_empty() const override;
+    void clear() override;
+    const HeapStructureStats& structure_stats() const { return stats_.stats(); }
+    const AllocationStats& allocation_stats() const { return alloc_.stats(); }
+
+private:
+    Node* roots_ = nullptr; // singly linked through right
+    Node* min_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t root_count_ = 0;
+    std::vector<Node*> rank_table_;
+    HandleSlots<Node*> slots_;
+    Stats stats_;
+    Compare compare_;
+    Alloc alloc_;
+
+    static bool is_thick(const Node* node) {
+        return node->child ? node->child->rank + 1 == node->rank : node->rank == 0;
+    }
+    static void make_thick(Node* node) { node->rank = node->child ? node->child->rank + 1 : 0; }
+
+    void push_root(Node* node);
+    Node* link(Node* a, Node* b);
+    void cut(Node* node);
+    void repair(Node* node, bool lost_first_child);
+    void delete_all(Node* node);
+    void update_size_metrics();
+    void note_rank_as_height(std::uint32_t rank);
+};
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+ThinHeap<Key, Value, Compare, Alloc, Stats>::ThinHeap() : ThinHeap(Compare()) {}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+ThinHeap<Key, Value, Compare, Alloc, Stats>::ThinHeap(const Compare& compare) : compare_(compare) {}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+ThinHeap<Key, Value, Compare, Alloc, Stats>::~ThinHeap() {
+    if constexpr (!releases_nodes_in_bulk<Alloc, Node>()) {
+        delete_all(roots_);
+    }
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+bool ThinHeap<Key, Value, Compare, Alloc, Stats>::is_empty() const {
+    return min_ == nullptr;
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void ThinHeap<Key, Value, Compare, Alloc, Stats>::clear() {
+    if constexpr (!releases_nodes_in_bulk<Alloc, Node>()) {
+        delete_all(roots_);
+    }
+    roots_ = nullptr;
+    min_ = nullptr;
+    size_ = 0;
+    root_count_ = 0;
+    slots_.clear();
+    stats_.reset();
+    alloc_.reset();
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void ThinHeap<Key, Value, Compare, Alloc, Stats>::push_root(Node* node) {
+    node->left = nullptr;
+    node->right = roots_;
+    roots_ = node;
+    ++root_count_;
+    if (!min_ || compare_(node->key, min_->key)) {
+        min_ = node;
+    }
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+HeapHandle ThinHeap<Key, Value, Compare, Alloc, Stats>::insert(Key key, Value value) {
+    auto* node = allocate_node<Node>(alloc_);
+    node->child = nullptr;
+    node->key = key;
+    node->value = value;
+    node->rank = 0;
+    const HeapHandle handle = slots_.acquire(node);
+    node->slot = handle.slot;
+    push_root(node);
+    ++size_;
+    note_rank_as_height(0);
+    update_size_metrics();
+    return handle;
+}
+
+// Links two thick roots of equal rank; the loser becomes the first child.
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+auto ThinHeap<Key, Value, Compare, Alloc, Stats>::link(Node* a, Node* b) -> Node* {
+    if (compare_(b->key, a->key)) std::swap(a, b);
+    b->right = a->child;
+    if (a->child) a->child->left = b;
+    b->left = a;
+    a->child = b;
+    a->rank++;
+    stats_.on_link();
+    note_rank_as_height(a->rank);
+    return a;
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+std::pair<Key, Value> ThinHeap<Key, Value, Compare, Alloc, Stats>::extract_min() {
+    if (!min_) {
+        throw std::runtime_error("extract_min from empty ThinHeap");
+    }
+    stats_.on_consolidation();
+
+    Node* z = min_;
+    std::fill(rank_table_.begin(), rank_table_.end(), nullptr);
+    auto place = [this](Node* node) {
+        while (true) {
+            if (node->rank >= rank_table_.size()) {
+                rank_table_.resize(node->rank + 1, nullptr);
+            }
+            Node*& slot = rank_table_[node->rank];
+            if (!slot) {
+                slot = node;
+                return;
+            }
+            Node* other = slot;
+            slot = nullptr;
+            node = link(node, other);
+        }
+    };
+
+    for (Node* root = roots_; root;) {
+        Node* next = root->right;
+        if (root != z) {
+            root->right = nullptr;
+            place(root);
+        }
+        root = next;
+    }
+    // Children become roots; thin ones drop a rank to become thick.
+    for (Node* child = z->child; child;) {
+        Node* next = child->right;
+        child->left = nullptr;
+        child->right = nullptr;
+        make_thick(child);
+        place(child);
+        child = next;
+    }
+
+    roots_ = nullptr;
+    min_ = nullptr;
+    root_count_ = 0;
+    for (Node*& node : rank_table_) {
+        if (node) {
+            push_root(node);
+            node = nullptr;
+        }
+    }
+    --size_;
+    stats_.on_roots(root_count_);
+    update_size_metrics();
+
+    std::pair<Key, Value> result(z->key, z->value);
+    slots_.release(z->slot);
+    destroy_node(alloc_, z);
+    return result;
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+std::pair<Key, Value> ThinHeap<Key, Value, Compare, Alloc, Stats>::peek_min() const {
+    if (!min_) {
+        throw std::runtime_error("peek_min from empty ThinHeap");
+    }
+    return {min_->key, min_->value};
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void ThinHeap<Key, Value, Compare, Alloc, Stats>::decrease_key(HeapHandle handle, Key new_key) {
+    Node* node = slots_.resolve(handle);
+    if (!node) {
+        throw std::invalid_argument("node is null");
+    }
+    if (compare_(node->key, new_key)) {
+        throw std::invalid_argument("new_key is greater than current key");
+    }
+    node->key = new_key;
+
+    Node* left = node->left;
+    if (!left) {
+        if (compare_(node->key, min_->key)) min_ = node;
+        return;
+    }
+
+    // Without parent pointers the heap order cannot be checked, so the node
+    // is always cut.
+    const bool first_child = left->child == node;
+    cut(node);
+    stats_.on_roots(root_count_);
+    repair(left, first_child);
+}
+
+// Unlinks a non-root with its subtree and makes it a thick root.
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void ThinHeap<Key, Value, Compare, Alloc, Stats>::cut(Node* node) {
+    Node* left = node->left;
+    if (left->child == node) {
+        left->child = node->right;
+    } else {
+        left->right = node->right;
+    }
+    if (node->right) node->right->left = left;
+    make_thick(node);
+    push_root(node);
+}
+
+// node lost its first child, or lost its right sibling (or that sibling's
+// rank dropped). Siblings' ranks must fall by exactly one to the right, so a
+// node that is too thin for its first child is cut out rather than lowered.
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void ThinHeap<Key, Value, Compare, Alloc, Stats>::repair(Node* node, bool lost_first_child) {
+    while (true) {
+        Node* left = node->left;
+        const bool first_child = left && left->child == node;
+        if (lost_first_child) {
+            const std::uint32_t thick_rank = node->child ? node->child->rank + 1 : 0;
+            if (!left) {
+                node->rank = thick_rank;
+                return;
+            }
+            if (node->rank <= thick_rank + 1) return;
+            cut(node);
+            stats_.on_roots(root_count_);
+        } else {
+            const std::uint32_t expected = node->right ? node->right->rank + 1 : 0;
+            if (node->rank == expected) return;
+            if (is_thick(node)) {
+                // The first child (rank expected) moves right to fill the gap.
+                Node* moved = node->child;
+                node->child = moved->right;
+                if (moved->right) moved->right->left = node;
+                moved->right = node->right;
+                if (node->right) node->right->left = moved;
+                node->right = moved;
+                moved->left = node;
+                stats_.on_link();
+                return;
+            }
+            node->rank--;
+        }
+        lost_first_child = first_child;
+        node = left;
+    }
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void ThinHeap<Key, Value, Compare, Alloc, Stats>::merge(Base& other_base) {
+    auto* other = dynamic_cast<ThinHeap*>(&other_base);
+    if (!other) throw std::invalid_argument("merge requires another ThinHeap");
+    if (other == this || !other->min_) return;
+
+    Node* tail = other->roots_;
+    while (tail->right) tail = tail->right;
+    tail->right = roots_;
+    roots_ = other->roots_;
+    if (!min_ || compare_(other->min_->key, min_->key)) {
+        min_ = other->min_;
+    }
+    size_ += other->size_;
+    root_count_ += other->root_count_;
+    stats_.on_roots(root_count_);
+    update_size_metrics();
+
+    const std::uint32_t slot_offset = slots_.absorb(other->slots_);
+    for (std::uint32_t slot = slot_offset; slot < slots_.size(); ++slot) {
+        if (Node* node = slots_[slot]) node->slot = slot;
+    }
+
+    other->roots_ = nullptr;
+    other->min_ = nullptr;
+    other->size_ = 0;
+    other->root_count_ = 0;
+    alloc_.absorb(other->alloc_);
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void ThinHeap<Key, Value, Compare, Alloc, Stats>::delete_all(Node* node) {
+    while (node) {
+        Node* next = node->right;
+        delete_all(node->child);
+        destroy_node(alloc_, node);
+        node = next;
+    }
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void ThinHeap<Key, Value, Compare, Alloc, Stats>::update_size_metrics() {
+    if (!stats_.should_sample()) return;
+    stats_.on_roots(root_count_);
+    stats_.on_size(size_, size_ * sizeof(Node) + slots_.capacity_bytes());
+}
+
+// A thin tree of rank r is at most r + 1 levels deep.
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void ThinHeap<Key, Value, Compare, Alloc, Stats>::note_rank_as_height(std::uint32_t rank) {
+    stats_.on_height(static_cast<std::size_t>(rank) + 1);
+}
+
+// The instantiations used by the driver are compiled once in ThinHeap.cpp.
+extern template class ThinHeap<long long, int>;
+extern template class ThinHeap<std::uint32_t, int>;
@@ -0,0 +1,433 @@
+#pragma once
+
+#include "HeapAllocators.h"
+#include "HeapStats.h"
+#include "PriorityQueue.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Children form a circular list. A child's dim is the level it hangs at:
+// the trunk at level j under a node is that node plus its level-j child plus,
+// optionally, that child's level-j child. A root's dim is its tree dimension.
+template <typename Key = long long, typename Value = int>
+struct TwoThreeHeapNode {
+    TwoThreeHeapNode* parent;
+    TwoThreeHeapNode* child;
+    TwoThreeHeapNode* left;
+    TwoThreeHeapNode* right;
+    Key key;
+    Value value;
+    std::uint32_t slot;
+    std::uint32_t dim;
+};
+
+// 2-3 heap (Takaoka): every trunk holds two or three nodes, so trees stay
+// within a constant factor of perfectly balanced and at most two trees of
+// each dimension are kept. A third tree of a dimension links all three into
+// one trunk and carries; decrease_key cuts the node and, if that leaves a
+// one-node trunk, regroups the nodes one level up (at most seven) into
+// trunks of two or three, cascading only when just three remain.
+template <typename Key = long long, typename Value = int, typename Compare = std::less<Key>,
+          typename Alloc = NewDeleteAllocator, typename Stats = FullStats>
+class TwoThreeHeap : public PriorityQueue<Key, Value, Compare>
+{
+public:
+    using Node = TwoThreeHeapNode<Key, Value>;
+    using Base = PriorityQueue<Key, Value, Compare>;
+
+    // Node plus its handle-table entry.
+    static constexpr std::size_t kNodeBytes = sizeof(Node) + sizeof(Node*);
+
+    TwoThreeHeap();
+    explicit TwoThreeHeap(const Compare& compare);
+    ~TwoThreeHeap() override;
+
+    HeapHandle insert(Key key, Value value) override;
+    std::pair<Key, Value> extract_min() override;
+    std::pair<Key, Value> peek_min() const override;
+    void decrease_key(HeapHandle handle, Key new_key) override;
+    void merge(Base& other) override;
+    bool is_empty() const override;
+    void clear() override;
+    const HeapStructureStats& structure_stats() const { return stats_.stats(); }
+    const AllocationStats& allocation_stats() const { return alloc_.stats(); }
+
+private:
+    // Two tree slots per dimension.
+    std::vector<std::array<Node*, 2>> trees_;
+    Node* min_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t root_count_ = 0;
+    HandleSlots<Node*> slots_;
+    Stats stats_;
+    Compare compare_;
+    Alloc alloc_;
+
+    static void add_child(Node* parent, Node* child);
+    static void remove_child(Node* parent, Node* child);
+    static Node* child_at(const Node* node, std::uint32_t level);
+
+    void add_tree(Node* root);
+    void remove_tree(Node* root);
+    void fix_deficiency(Node* node, std::uint32_t level);
+    void find_min();
+    void delete_all(Node* node);
+    void update_size_metrics();
+    void note_dim_as_height(std::uint32_t dim);
+};
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+TwoThreeHeap<Key, Value, Compare, Alloc, Stats>::TwoThreeHeap() : TwoThreeHeap(Compare()) {}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+TwoThreeHeap<Key, Value, Compare, Alloc, Stats>::TwoThreeHeap(const Compare& compare) : compare_(compare) {}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+TwoThreeHeap<Key, Value, Compare, Alloc, Stats>::~TwoThreeHeap() {
+    if constexpr (!releases_nodes_in_bulk<Alloc, Node>()) {
+        for (auto& pair : trees_) {
+            for (Node* root : pair) delete_all(root);
+        }
+    }
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+bool TwoThreeHeap<Key, Value, Compare, Alloc, Stats>::is_empty() const {
+    return min_ == nullptr;
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void TwoThreeHeap<Key, Value, Compare, Alloc, Stats>::clear() {
+    for (auto& pair : trees_) {
+        for (Node*& root : pair) {
+            if constexpr (!releases_nodes_in_bulk<Alloc, Node>()) {
+                delete_all(root);
+            }
+            root = nullptr;
+        }
+    }
+    min_ = nullptr;
+    size_ = 0;
+    root_count_ = 0;
+    slots_.clear();
+    stats_.reset();
+    alloc_.reset();
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void TwoThreeHeap<Key, Value, Compare, Alloc, Stats>::add_child(Node* parent, Node* child) {
+    child->parent = parent;
+    if (!parent->child) {
+        child->left = child->right = child;
+        parent->child = child;
+        return;
+    }
+    Node* first = parent->child;
+    child->right = first;
+    child->left = first->left;
+    first->left->right = child;
+    first->left = child;
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void TwoThreeHeap<Key, Value, Compare, Alloc, Stats>::remove_child(Node* parent, Node* child) {
+    if (child->right == child) {
+        parent->child = nullptr;
+    } else {
+        child->left->right = child->right;
+        child->right->left = child->left;
+        if (parent->child == child) parent->child = child->right;
+    }
+    child->parent = nullptr;
+    child->left = child->right = child;
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+auto TwoThreeHeap<Key, Value, Compare, Alloc, Stats>::child_at(const Node* node, std::uint32_t level) -> Node* {
+    Node* first = node->child;
+    if (!first) return nullptr;
+    Node* current = first;
+    do {
+        if (current->dim == level) return current;
+        current = current->right;
+    } while (current != first);
+    return nullptr;
+}
+
+// Inserts a tree by its dim; a third tree of one dimension merges with the
+// other two into a trunk headed by the smallest root, carried one dim up.
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void TwoThreeHeap<Key, Value, Compare, Alloc, Stats>::add_tree(Node* root) {
+    while (true) {
+        const std::uint32_t dim = root->dim;
+        root->parent = nullptr;
+        if (dim >= trees_.size()) trees_.resize(dim + 1, {nullptr, nullptr});
+        auto& pair = trees_[dim];
+        if (!pair[0] || !pair[1]) {
+            (pair[0] ? pair[1] : pair[0]) = root;
+            ++root_count_;
+            note_dim_as_height(dim);
+            return;
+        }
+        std::array<Node*, 3> trunk = {root, pair[0], pair[1]};
+        pair = {nullptr, nullptr};
+        root_count_ -= 2;
+        std::sort(trunk.begin(), trunk.end(), [this](const Node* a, const Node* b) { return compare_(a->key, b->key); });
+        add_child(trunk[0], trunk[1]);
+        add_child(trunk[1], trunk[2]);
+        stats_.on_link();
+        stats_.on_link();
+        trunk[0]->dim = dim + 1;
+        if (min_ == trunk[1] || min_ == trunk[2]) min_ = trunk[0];
+        root = trunk[0];
+    }
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void TwoThreeHeap<Key, Value, Compare, Alloc, Stats>::remove_tree(Node* root) {
+    auto& pair = trees_[root->dim];
+    (pair[0] == root ? pair[0] : pair[1]) = nullptr;
+    --root_count_;
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void TwoThreeHeap<Key, Value, Compare, Alloc, Stats>::find_min() {
+    min_ = nullptr;
+    for (const auto& pair : trees_) {
+        for (Node* root : pair) {
+            if (root && (!min_ || compare_(root->key, min_->key))) min_ = root;
+        }
+    }
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+HeapHandle TwoThreeHeap<Key, Value, Compare, Alloc, Stats>::insert(Key key, Value value) {
+    auto* node = allocate_node<Node>(alloc_);
+    node->child = nullptr;
+    node->left = node->right = node;
+    node->key = key;
+    node->value = value;
+    node->dim = 0;
+    const HeapHandle handle = slots_.acquire(node);
+    node->slot = handle.slot;
+    if (!min_ || compare_(key, min_->key)) min_ = node;
+    add_tree(node);
+    ++size_;
+    update_size_metrics();
+    return handle;
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+std::pair<Key, Value> TwoThreeHeap<Key, Value, Compare, Alloc, Stats>::extract_min() {
+    if (!min_) {
+        throw std::runtime_error("extract_min from empty TwoThreeHeap");
+    }
+    stats_.on_consolidation();
+
+    Node* z = min_;
+    remove_tree(z);
+    min_ = nullptr;
+    // Each level-k child heads a dim k+1 tree when its trunk has a second
+    // node, and a dim k tree otherwise.
+    while (Node* child = z->child) {
+        remove_child(z, child);
+        if (child_at(child, child->dim)) child->dim++;
+        add_tree(child);
+    }
+    find_min();
+    --size_;
+    stats_.on_roots(root_count_);
+    update_size_metrics();
+
+    std::pair<Key, Value> result(z->key, z->value);
+    slots_.release(z->slot);
+    destroy_node(alloc_, z);
+    return result;
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+std::pair<Key, Value> TwoThreeHeap<Key, Value, Compare, Alloc, Stats>::peek_min() const {
+    if (!min_) {
+        throw std::runtime_error("peek_min from empty TwoThreeHeap");
+    }
+    return {min_->key, min_->value};
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void TwoThreeHeap<Key, Value, Compare, Alloc, Stats>::decrease_key(HeapHandle handle, Key new_key) {
+    Node* node = slots_.resolve(handle);
+    if (!node) {
+        throw std::invalid_argument("node is null");
+    }
+    if (compare_(node->key, new_key)) {
+        throw std::invalid_argument("new_key is greater than current key");
+    }
+    node->key = new_key;
+
+    Node* parent = node->parent;
+    if (!parent || !compare_(node->key, parent->key)) {
+        if (compare_(node->key, min_->key)) min_ = node;
+        return;
+    }
+
+    // The node leaves its trunk with its lower levels; its trunk successor,
+    // if any, takes its place.
+    const std::uint32_t level = node->dim;
+    Node* successor = child_at(node, level);
+    remove_child(parent, node);
+    if (successor) {
+        remove_child(node, successor);
+        add_child(parent, successor);
+    } else if (parent->dim != level) {
+        // The parent heads the trunk and is now alone in it.
+        fix_deficiency(parent, level);
+    }
+    if (compare_(node->key, min_->key)) min_ = node;
+    add_tree(node);
+    stats_.on_roots(root_count_);
+}
+
+// node heads level j but has no level-j child. Its level-(j+1) trunk and
+// their level-j children are regrouped; only three nodes leave a single
+// trunk, which moves the deficiency one level up.
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void TwoThreeHeap<Key, Value, Compare, Alloc, Stats>::fix_deficiency(Node* node, std::uint32_t level) {
+    while (true) {
+        Node* head = node;
+        if (node->dim == level + 1) {
+            if (!node->parent) {
+                // A root that lost its top level simply drops a dimension.
+                remove_tree(node);
+                node->dim = level;
+                add_tree(node);
+                return;
+            }
+            head = node->parent->dim == level + 1 ? node->parent->parent : node->parent;
+        }
+
+        std::array<Node*, 3> members = {head, child_at(head, level + 1), nullptr};
+        members[2] = child_at(members[1], level + 1);
+
+        std::array<Node*, 7> work{};
+        std::size_t count = 0;
+        for (Node* member : members) {
+            if (!member) continue;
+            work[count++] = member;
+            Node* second = child_at(member, level);
+            if (!second) continue;
+            Node* third = child_at(second, level);
+            if (third) remove_child(second, third);
+            remove_child(member, second);
+            work[count++] = second;
+            if (third) work[count++] = third;
+        }
+        if (members[2]) remove_child(members[1], members[2]);
+        remove_child(head, members[1]);
+
+        // At most six nodes follow the head; insertion sort them.
+        for (std::size_t i = 2; i < count; ++i) {
+            Node* moving = work[i];
+            std::size_t j = i;
+            for (; j > 1 && compare_(moving->key, work[j - 1]->key); --j) work[j] = work[j - 1];
+            work[j] = moving;
+        }
+        for (std::size_t i = 1; i < count; ++i) work[i]->dim = level;
+
+        if (count == 3) {
+            add_child(work[0], work[1]);
+            add_child(work[1], work[2]);
+            stats_.on_link();
+            stats_.on_link();
+            node = head;
+            ++level;
+            continue;
+        }
+
+        // Contiguous groups of two or three keep each group head no larger
+        // than its members, and head order matches group order.
+        static constexpr std::array<std::array<std::uint8_t, 3>, 8> kGroups = {{
+            {0, 0, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0},
+            {2, 2, 0}, {3, 2, 0}, {3, 3, 0}, {3, 2, 2},
+        }};
+        Node* previous_head = nullptr;
+        std::size_t start = 0;
+        for (std::uint8_t group : kGroups[count]) {
+            if (group == 0) break;
+            Node* group_head = work[start];
+            for (std::size_t i = start + 1; i < start + group; ++i) {
+                add_child(work[i - 1], work[i]);
+                stats_.on_link();
+            }
+            if (previous_head) {
+                group_head->dim = level + 1;
+                add_child(previous_head, group_head);
+                stats_.on_link();
+            }
+            previous_head = group_head;
+            start += group;
+        }
+        return;
+    }
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void TwoThreeHeap<Key, Value, Compare, Alloc, Stats>::merge(Base& other_base) {
+    auto* other = dynamic_cast<TwoThreeHeap*>(&other_base);
+    if (!other) throw std::invalid_argument("merge requires another TwoThreeHeap");
+    if (other == this || !other->min_) return;
+
+    if (!min_ || compare_(other->min_->key, min_->key)) min_ = other->min_;
+    for (auto& pair : other->trees_) {
+        for (Node*& root : pair) {
+            if (root) add_tree(root);
+            root = nullptr;
+        }
+    }
+    size_ += other->size_;
+    stats_.on_roots(root_count_);
+    update_size_metrics();
+
+    const std::uint32_t slot_offset = slots_.absorb(other->slots_);
+    for (std::uint32_t slot = slot_offset; slot < slots_.size(); ++slot) {
+        if (Node* node = slots_[slot]) node->slot = slot;
+    }
+
+    other->min_ = nullptr;
+    other->size_ = 0;
+    other->root_count_ = 0;
+    alloc_.absorb(other->alloc_);
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void TwoThreeHeap<Key, Value, Compare, Alloc, Stats>::delete_all(Node* node) {
+    if (!node) return;
+    while (Node* child = node->child) {
+        remove_child(node, child);
+        delete_all(child);
+    }
+    destroy_node(alloc_, node);
+}
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void TwoThreeHeap<Key, Value, Compare, Alloc, Stats>::update_size_metrics() {
+    if (!stats_.should_sample()) return;
+    stats_.on_roots(root_count_);
+    stats_.on_size(size_, size_ * sizeof(Node) + slots_.capacity_bytes());
+}
+
+// Each dimension adds a trunk of at most three nodes, so a dim d tree is at
+// most 2d + 1 levels deep.
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Stats>
+void TwoThreeHeap<Key, Value, Compare, Alloc, Stats>::note_dim_as_height(std::uint32_t dim) {
+    stats_.on_height(2 * static_cast<std::size_t>(dim) + 1);
+}
+
+// The instantiations used by the driver are compiled once in TwoThreeHeap.cpp.
+extern template class TwoThreeHeap<long long, int>;
+extern template class TwoThreeHeap<std::uint32_t, int>;
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+// Runs body(worker, index) for every index in [0, count) on `threads`
+// worker threads. Each worker starts with a contiguous share of the
+// indices and takes them from the front; a worker that runs dry steals the
+// back half of the fullest share, so uneven items still spread evenly.
+// Workers bump a shared atomic count after each item, and the calling
+// thread, which does no items itself, passes it to progress every
+// progress_ms while they run and once at the end. The first exception a
+// body throws stops the remaining items and is rethrown here.
+void run_work_stealing(std::size_t count, std::size_t threads,
+                       const std::function<void(std::size_t worker, std::size_t index)>& body,
+                       const std::function<void(std::size_t completed)>& progress = {},
+                       unsigned progress_ms = 200);
@@ -0,0 +1,138 @@
+#include "ArcFlags.h"
+
+#include <algorithm>
+#include <bitset>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+constexpr long long kInfinity = std::numeric_limits<long long>::max() / 4;
+} // namespace
+
+ArcFlags ArcFlags::build(const Graph& graph, std::size_t regions, PartitionMethod method, DijkstraQueue& queue,
+                         std::uint32_t seed) {
+    if (graph.empty()) {
+        throw std::invalid_argument("Graph is empty");
+    }
+    if (regions == 0 || regions > kMaxRegions) {
+        throw std::invalid_argument("arc flags support 1 to 32 regions");
+    }
+    const std::size_t n = graph.node_count();
+    regions = std::min(regions, n);
+
+    ArcFlags flags;
+    flags.region_count_ = regions;
+    const std::vector<int> region = method == PartitionMethod::kInertial
+                                        ? inertial_partition(graph, regions)
+                                        : bfs_grown_partition(undirected_adjacency(graph), regions, seed);
+    flags.region_.assign(region.begin(), region.end());
+
+    flags.offsets_.assign(n + 1, 0);
+    for (std::size_t v = 0; v < n; ++v) {
+        flags.offsets_[v + 1] = flags.offsets_[v] + graph.neighbors(static_cast<int>(v)).size();
+    }
+    flags.arcs_.reserve(flags.offsets_[n]);
+    for (std::size_t v = 0; v < n; ++v) {
+        for (const auto& edge : graph.neighbors(static_cast<int>(v))) {
+            Arc arc;
+            arc.to = edge.to;
+            arc.weight = edge.weight;
+            arc.flags = 1u << flags.region_[static_cast<std::size_t>(edge.to)];
+            flags.arcs_.push_back(arc);
+        }
+    }
+
+    // Tree arcs of the backward search from each boundary vertex b lie on a
+    // shortest path into b's region.
+    const Graph reverse = graph.reversed();
+    for (std::size_t b = 0; b < n; ++b) {
+        const std::uint8_t r = flags.region_[b];
+        const auto& incoming = graph.reverse_neighbors(static_cast<int>(b));
+        const bool boundary = std::any_of(incoming.begin(), incoming.end(), [&](const GraphEdge& edge) {
+            return flags.region_[static_cast<std::size_t>(edge.to)] != r;
+        });
+        if (!boundary) continue;
+        flags.boundary_count_++;
+
+        const DijkstraResult tree = run_dijkstra(reverse, static_cast<int>(b), queue);
+        const std::uint32_t bit = 1u << r;
+        for (std::size_t u = 0; u < n; ++u) {
+            const int w = tree.parents[u];
+            if (w < 0) continue;
+            const long long weight = tree.distances[u] - tree.distances[static_cast<std::size_t>(w)];
+            for (std::size_t i = flags.offsets_[u]; i < flags.offsets_[u + 1]; ++i) {
+                Arc& arc = flags.arcs_[i];
+                if (arc.to == w && arc.weight == weight) {
+                    arc.flags |= bit;
+                    break;
+                }
+            }
+        }
+    }
+    return flags;
+}
+
+double ArcFlags::flag_density() const {
+    if (arcs_.empty() || region_count_ == 0) return 0.0;
+    std::size_t set = 0;
+    for (const auto& arc : arcs_) set += std::bitset<32>(arc.flags).count();
+    return static_cast<double>(set) / static_cast<double>(arcs_.size() * region_count_);
+}
+
+PointToPointResult ArcFlags::query(int source, int target, DijkstraQueue& queue) const {
+    const std::size_t n = node_count();
+    if (n == 0) {
+        throw std::invalid_argument("Arc flags are empty");
+    }
+    if (source < 0 || static_cast<std::size_t>(source) >= n || target < 0 || static_cast<std::size_t>(target) >= n) {
+        throw std::out_of_range("Query vertex out of range");
+    }
+    if (distances_.size() != n) {
+        distances_.assign(n, kInfinity);
+        parents_.assign(n, -1);
+    }
+
+    const std::uint32_t bit = 1u << region_[static_cast<std::size_t>(target)];
+    PointToPointResult result;
+    queue.reset(n);
+    distances_[static_cast<std::size_t>(source)] = 0;
+    touched_.push_back(source);
+    queue.push_or_decrease(source, 0);
+    while (!queue.empty()) {
+        auto [dist_u, u] = queue.extract_min();
+        if (dist_u > distances_[static_cast<std::size_t>(u)]) {
+            continue;
+        }
+        result.settled++;
+        if (u == target) {
+            result.distance = dist_u;
+            for (int v = target; v >= 0; v = parents_[static_cast<std::size_t>(v)]) {
+                result.path.push_back(v);
+            }
+            std::reverse(result.path.begin(), result.path.end());
+            break;
+        }
+        const auto ui = static_cast<std::size_t>(u);
+        for (std::size_t i = offsets_[ui]; i < offsets_[ui + 1]; ++i) {
+            const Arc& arc = arcs_[i];
+            if (!(arc.flags & bit) || arc.weight >= kInfinity || dist_u > kInfinity - arc.weight) {
+                continue;
+            }
+            const long long candidate = dist_u + arc.weight;
+            auto& current = distances_[static_cast<std::size_t>(arc.to)];
+            if (candidate < current) {
+                if (current == kInfinity) touched_.push_back(arc.to);
+                current = candidate;
+                parents_[static_cast<std::size_t>(arc.to)] = u;
+                queue.push_or_decrease(arc.to, candidate);
+            }
+        }
+    }
+
+    for (int v : touched_) {
+        distances_[static_cast<std::size_t>(v)] = kInfinity;
+        parents_[static_cast<std::size_t>(v)] = -1;
+    }
+    touched_.clear();
+    return result;
+}
@@ -0,0 +1,4 @@
+#include "BHeap.h"
+
+template class BHeap<long long, int>;
+template class BHeap<std::uint32_t, int>;
@@ -0,0 +1,161 @@
+#include "BatchedSearch.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define BATCHED_AVX2 1
+#endif
+
+namespace {
+constexpr long long kInfinity = std::numeric_limits<long long>::max() / 4;
+
+std::size_t lowest_bit(std::uint32_t value) {
+#if defined(__GNUC__)
+    return static_cast<std::size_t>(__builtin_ctz(value));
+#else
+    std::size_t bit = 0;
+    while (!(value & 1u)) {
+        value >>= 1;
+        ++bit;
+    }
+    return bit;
+#endif
+}
+
+// Sets to[i] = min(to[i], from[i] + weight) over the lanes and returns a
+// bit per improved lane. An unreached lane stays unreached: kInfinity plus
+// any admitted weight is still above kInfinity.
+std::uint32_t relax_scalar(const long long* from, long long weight, long long* to, std::size_t lanes) {
+    std::uint32_t improved = 0;
+    for (std::size_t i = 0; i < lanes; ++i) {
+        const long long candidate = from[i] + weight;
+        if (candidate < to[i]) {
+            to[i] = candidate;
+            improved |= 1u << i;
+        }
+    }
+    return improved;
+}
+
+#ifdef BATCHED_AVX2
+// AVX2 has no 64-bit min, so a compare picks the lanes to blend.
+__attribute__((target("avx2"))) std::uint32_t relax_avx2(const long long* from, long long weight, long long* to,
+                                                          std::size_t lanes) {
+    const __m256i w = _mm256_set1_epi64x(weight);
+    std::uint32_t improved = 0;
+    for (std::size_t i = 0; i < lanes; i += 4) {
+        const __m256i candidate =
+            _mm256_add_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(from + i)), w);
+        const __m256i current = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(to + i));
+        const __m256i smaller = _mm256_cmpgt_epi64(current, candidate);
+        const auto mask = static_cast<std::uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(smaller)));
+        if (mask != 0) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(to + i), _mm256_blendv_epi8(current, candidate, smaller));
+            improved |= mask << i;
+        }
+    }
+    return improved;
+}
+
+bool has_avx2() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+#endif
+
+using RelaxFunction = std::uint32_t (*)(const long long*, long long, long long*, std::size_t);
+
+RelaxFunction pick_relax() {
+#ifdef BATCHED_AVX2
+    if (has_avx2()) return relax_avx2;
+#endif
+    return relax_scalar;
+}
+} // namespace
+
+bool batched_search_uses_simd() {
+    return pick_relax() != relax_scalar;
+}
+
+void run_batched_dijkstra(const Graph& graph, const int* sources, std::size_t count, DijkstraQueue& queue,
+                          BatchedResult& result) {
+    const std::size_t n = graph.node_count();
+    if (n == 0) {
+        throw std::invalid_argument("Graph is empty");
+    }
+    if (count == 0 || count > kMaxBatchSources) {
+        throw std::invalid_argument("A batch needs between 1 and 16 sources");
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        if (sources[i] < 0 || static_cast<std::size_t>(sources[i]) >= n) {
+            throw std::out_of_range("Source vertex out of range");
+        }
+    }
+    const std::size_t lanes = count <= 8 ? 8 : 16;
+    const RelaxFunction relax = pick_relax();
+
+    result.lanes = lanes;
+    result.scans = 0;
+    result.distances.assign(n * lanes, kInfinity);
+    // The key each vertex was last queued with, or kInfinity once scanned;
+    // an extract with any other key is a superseded entry.
+    std::vector<long long> pending(n, kInfinity);
+    queue.reset(n);
+
+    std::size_t stale_live = 0;
+    std::size_t stale_extracts = 0;
+    std::size_t peak_stale = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto s = static_cast<std::size_t>(sources[i]);
+        result.distances[s * lanes + i] = 0;
+        if (pending[s] != 0) {
+            pending[s] = 0;
+            queue.push(sources[i], 0);
+        }
+    }
+
+    while (!queue.empty()) {
+        auto [key, u] = queue.extract_min();
+        const auto ui = static_cast<std::size_t>(u);
+        if (key != pending[ui]) {
+            stale_extracts++;
+            stale_live--;
+            continue;
+        }
+        pending[ui] = kInfinity;
+        result.scans++;
+        const long long* from = &result.distances[ui * lanes];
+        for (const auto& edge : graph.neighbors(u)) {
+            if (edge.weight >= kInfinity) {
+                continue;
+            }
+            const auto vi = static_cast<std::size_t>(edge.to);
+            long long* to = &result.distances[vi * lanes];
+            std::uint32_t improved = relax(from, edge.weight, to, lanes);
+            if (improved == 0) {
+                continue;
+            }
+            long long best = pending[vi];
+            for (; improved != 0; improved &= improved - 1) {
+                best = std::min(best, to[lowest_bit(improved)]);
+            }
+            if (best < pending[vi]) {
+                if (pending[vi] != kInfinity) {
+                    peak_stale = std::max(peak_stale, ++stale_live);
+                }
+                pending[vi] = best;
+                queue.push(edge.to, best);
+            }
+        }
+    }
+
+    result.metrics = queue.metrics();
+    result.metrics.stale_extract_count = stale_extracts;
+    result.metrics.peak_stale_entries = peak_stale;
+    result.structure = queue.structure_stats();
+    result.allocation = queue.allocation_stats();
+}
@@ -0,0 +1,106 @@
+#include "BoundedSearch.h"
+
+#include <limits>
+#include <stdexcept>
+
+namespace {
+constexpr long long kInfinity = std::numeric_limits<long long>::max() / 4;
+} // namespace
+
+BoundedSearch::BoundedSearch(const Graph& graph)
+    : graph_(graph), distances_(graph.node_count(), kInfinity), parents_(graph.node_count(), -1),
+      targets_(graph.node_count(), 0) {}
+
+BoundedResult BoundedSearch::run(int source, const SearchBounds& bounds, DijkstraQueue& queue) {
+    const std::size_t n = graph_.node_count();
+    if (n == 0) {
+        throw std::invalid_argument("Graph is empty");
+    }
+    if (distances_.size() != n) {
+        throw std::invalid_argument("graph changed size since the search was created");
+    }
+    if (source < 0 || static_cast<std::size_t>(source) >= n) {
+        throw std::out_of_range("Source vertex out of range");
+    }
+    for (int target : bounds.targets) {
+        if (target < 0 || static_cast<std::size_t>(target) >= n) {
+            throw std::out_of_range("Target vertex out of range");
+        }
+    }
+
+    BoundedResult result;
+    try {
+        search(source, bounds, queue, result);
+    } catch (...) {
+        clear_labels(bounds);
+        throw;
+    }
+    result.touched = touched_.size();
+    clear_labels(bounds);
+    return result;
+}
+
+void BoundedSearch::search(int source, const SearchBounds& bounds, DijkstraQueue& queue, BoundedResult& result) {
+    std::size_t remaining = 0;
+    for (int target : bounds.targets) {
+        auto& flag = targets_[static_cast<std::size_t>(target)];
+        if (!flag) {
+            flag = 1;
+            remaining++;
+        }
+    }
+    const bool by_targets = remaining > 0;
+    const long long radius = bounds.radius < 0 ? kInfinity : bounds.radius;
+
+    queue.reset(distances_.size());
+    distances_[static_cast<std::size_t>(source)] = 0;
+    touched_.push_back(source);
+    queue.push_or_decrease(source, 0);
+    while (!queue.empty()) {
+        auto [dist_u, u] = queue.extract_min();
+        const auto ui = static_cast<std::size_t>(u);
+        if (dist_u > distances_[ui]) {
+            continue;
+        }
+        if (dist_u > radius) {
+            break;
+        }
+        result.vertices.push_back(u);
+        result.distances.push_back(dist_u);
+        result.parents.push_back(parents_[ui]);
+        if (bounds.nearest > 0 && result.vertices.size() >= bounds.nearest) {
+            break;
+        }
+        if (by_targets && targets_[ui] && --remaining == 0) {
+            break;
+        }
+
+        for (const auto& edge : graph_.neighbors(u)) {
+            if (edge.weight >= kInfinity || dist_u > kInfinity - edge.weight) {
+                continue;
+            }
+            const long long candidate = dist_u + edge.weight;
+            if (candidate > radius) {
+                continue;
+            }
+            auto& current = distances_[static_cast<std::size_t>(edge.to)];
+            if (candidate < current) {
+                if (current == kInfinity) touched_.push_back(edge.to);
+                current = candidate;
+                parents_[static_cast<std::size_t>(edge.to)] = u;
+                queue.push_or_decrease(edge.to, candidate);
+            }
+        }
+    }
+}
+
+void BoundedSearch::clear_labels(const SearchBounds& bounds) {
+    for (int v : touched_) {
+        distances_[static_cast<std::size_t>(v)] = kInfinity;
+        parents_[static_cast<std::size_t>(v)] = -1;
+    }
+    touched_.clear();
+    for (int target : bounds.targets) {
+        targets_[static_cast<std::size_t>(target)] = 0;
+    }
+}
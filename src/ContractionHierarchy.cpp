@@ -0,0 +1,449 @@
+#include "ContractionHierarchy.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+constexpr long long kInfinity = std::numeric_limits<long long>::max() / 4;
+
+// Witness searches give up after this many settled vertices. A search that
+// stops early only costs an unneeded shortcut, never a wrong distance.
+constexpr std::size_t kWitnessSettleLimit = 500;
+
+struct DynamicArc {
+    int to;
+    long long weight;
+    int middle;
+};
+
+// Keeps the lightest of any parallel arcs and drops self-loops.
+void add_or_improve(std::vector<DynamicArc>& arcs, int to, long long weight, int middle) {
+    for (auto& arc : arcs) {
+        if (arc.to == to) {
+            if (weight < arc.weight) {
+                arc.weight = weight;
+                arc.middle = middle;
+            }
+            return;
+        }
+    }
+    arcs.push_back(DynamicArc{to, weight, middle});
+}
+
+void remove_arcs_to(std::vector<DynamicArc>& arcs, int to) {
+    arcs.erase(std::remove_if(arcs.begin(), arcs.end(), [to](const DynamicArc& arc) { return arc.to == to; }),
+               arcs.end());
+}
+
+// Remaining graph during contraction. in[v] holds arcs u -> v with to = u.
+class Contractor {
+public:
+    Contractor(const Graph& graph, DijkstraQueue& queue)
+        : queue_(queue), out_(graph.node_count()), in_(graph.node_count()),
+          distances_(graph.node_count(), kInfinity) {
+        for (std::size_t from = 0; from < graph.node_count(); ++from) {
+            const int u = static_cast<int>(from);
+            for (const auto& edge : graph.neighbors(u)) {
+                if (edge.to == u || edge.weight >= kInfinity) continue;
+                add_or_improve(out_[from], edge.to, edge.weight, -1);
+                add_or_improve(in_[static_cast<std::size_t>(edge.to)], u, edge.weight, -1);
+            }
+        }
+    }
+
+    const std::vector<DynamicArc>& out(int v) const { return out_[static_cast<std::size_t>(v)]; }
+    const std::vector<DynamicArc>& in(int v) const { return in_[static_cast<std::size_t>(v)]; }
+    std::size_t witness_searches() const { return witness_searches_; }
+    std::size_t witness_settled() const { return witness_settled_; }
+
+    // Shortcuts that contracting v would add; with `apply` they are added.
+    std::size_t shortcuts_for(int v, bool apply) {
+        const auto& in_arcs = in_[static_cast<std::size_t>(v)];
+        const auto& out_arcs = out_[static_cast<std::size_t>(v)];
+        if (out_arcs.empty()) return 0;
+        long long max_out = 0;
+        for (const auto& arc : out_arcs) max_out = std::max(max_out, arc.weight);
+
+        std::size_t count = 0;
+        pending_.clear();
+        for (const auto& in_arc : in_arcs) {
+            const int u = in_arc.to;
+            witness_search(u, v, in_arc.weight + max_out);
+            for (const auto& out_arc : out_arcs) {
+                const int w = out_arc.to;
+                if (w == u) continue;
+                const long long via = in_arc.weight + out_arc.weight;
+                if (distances_[static_cast<std::size_t>(w)] <= via) continue;
+                ++count;
+                if (apply) pending_.push_back(DynamicArc{w, via, u});
+            }
+            clear_search();
+        }
+        // Added after all searches so witnesses never run over new shortcuts
+        // through v itself. pending_ reuses `middle` for the tail.
+        for (const auto& shortcut : pending_) {
+            add_or_improve(out_[static_cast<std::size_t>(shortcut.middle)], shortcut.to, shortcut.weight, v);
+            add_or_improve(in_[static_cast<std::size_t>(shortcut.to)], shortcut.middle, shortcut.weight, v);
+        }
+        return count;
+    }
+
+    // Detaches v from the remaining graph, leaving its own arc lists intact.
+    void remove(int v) {
+        for (const auto& arc : out_[static_cast<std::size_t>(v)]) {
+            remove_arcs_to(in_[static_cast<std::size_t>(arc.to)], v);
+        }
+        for (const auto& arc : in_[static_cast<std::size_t>(v)]) {
+            remove_arcs_to(out_[static_cast<std::size_t>(arc.to)], v);
+        }
+    }
+
+    void release(int v) {
+        std::vector<DynamicArc>().swap(out_[static_cast<std::size_t>(v)]);
+        std::vector<DynamicArc>().swap(in_[static_cast<std::size_t>(v)]);
+    }
+
+private:
+    // Dijkstra from source over the remaining graph minus `excluded`, up to
+    // distance `limit` or kWitnessSettleLimit settled vertices.
+    void witness_search(int source, int excluded, long long limit) {
+        ++witness_searches_;
+        queue_.reset(distances_.size());
+        distances_[static_cast<std::size_t>(source)] = 0;
+        touched_.push_back(source);
+        queue_.push_or_decrease(source, 0);
+        std::size_t settled = 0;
+        while (!queue_.empty()) {
+            auto [dist_u, u] = queue_.extract_min();
+            if (dist_u > distances_[static_cast<std::size_t>(u)]) continue;
+            if (dist_u > limit || ++settled > kWitnessSettleLimit) break;
+            for (const auto& arc : out_[static_cast<std::size_t>(u)]) {
+                if (arc.to == excluded) continue;
+                const long long candidate = dist_u + arc.weight;
+                auto& current = distances_[static_cast<std::size_t>(arc.to)];
+                if (candidate < current) {
+                    if (current == kInfinity) touched_.push_back(arc.to);
+                    current = candidate;
+                    queue_.push_or_decrease(arc.to, candidate);
+                }
+            }
+        }
+        witness_settled_ += settled;
+    }
+
+    void clear_search() {
+        for (int v : touched_) distances_[static_cast<std::size_t>(v)] = kInfinity;
+        touched_.clear();
+    }
+
+    DijkstraQueue& queue_;
+    std::vector<std::vector<DynamicArc>> out_;
+    std::vector<std::vector<DynamicArc>> in_;
+    std::vector<long long> distances_;
+    std::vector<int> touched_;
+    std::vector<DynamicArc> pending_;
+    std::size_t witness_searches_ = 0;
+    std::size_t witness_settled_ = 0;
+};
+} // namespace
+
+ContractionHierarchy ContractionHierarchy::build(const Graph& graph, DijkstraQueue& queue) {
+    if (graph.empty()) {
+        throw std::invalid_argument("Graph is empty");
+    }
+    const std::size_t n = graph.node_count();
+    Contractor contractor(graph, queue);
+
+    // Edge difference plus the number of already contracted neighbors, which
+    // spreads contraction evenly over the graph.
+    std::vector<int> contracted_neighbors(n, 0);
+    auto priority = [&](int v) {
+        const auto added = static_cast<long long>(contractor.shortcuts_for(v, false));
+        const auto removed = static_cast<long long>(contractor.in(v).size() + contractor.out(v).size());
+        return added - removed + contracted_neighbors[static_cast<std::size_t>(v)];
+    };
+
+    // Lazy updates: a popped vertex is re-evaluated and pushed back if it is
+    // no longer the minimum. current holds the latest queued priority.
+    using Entry = std::pair<long long, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> order;
+    std::vector<long long> current(n);
+    for (std::size_t v = 0; v < n; ++v) {
+        current[v] = priority(static_cast<int>(v));
+        order.emplace(current[v], static_cast<int>(v));
+    }
+
+    ContractionHierarchy hierarchy;
+    hierarchy.rank_.assign(n, -1);
+    std::vector<std::vector<Arc>> upward_out(n);
+    std::vector<std::vector<Arc>> upward_in(n);
+    int next_rank = 0;
+    std::vector<int> neighbors;
+    while (!order.empty()) {
+        const auto [queued, v] = order.top();
+        order.pop();
+        const auto vi = static_cast<std::size_t>(v);
+        if (hierarchy.rank_[vi] >= 0 || queued != current[vi]) continue;
+        const long long updated = priority(v);
+        if (!order.empty() && updated > order.top().first) {
+            current[vi] = updated;
+            order.emplace(updated, v);
+            continue;
+        }
+
+        contractor.shortcuts_for(v, true);
+        hierarchy.rank_[vi] = next_rank++;
+        neighbors.clear();
+        for (const auto& arc : contractor.out(v)) {
+            upward_out[vi].push_back(Arc{arc.to, arc.weight, arc.middle});
+            neighbors.push_back(arc.to);
+        }
+        for (const auto& arc : contractor.in(v)) {
+            upward_in[vi].push_back(Arc{arc.to, arc.weight, arc.middle});
+            neighbors.push_back(arc.to);
+        }
+        contractor.remove(v);
+        contractor.release(v);
+
+        std::sort(neighbors.begin(), neighbors.end());
+        neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+        for (int w : neighbors) {
+            const auto wi = static_cast<std::size_t>(w);
+            contracted_neighbors[wi]++;
+            current[wi] = priority(w);
+            order.emplace(current[wi], w);
+        }
+    }
+
+    auto flatten = [n](std::vector<std::vector<Arc>>& lists, std::vector<std::size_t>& offsets,
+                       std::vector<Arc>& arcs) {
+        offsets.assign(n + 1, 0);
+        for (std::size_t v = 0; v < n; ++v) offsets[v + 1] = offsets[v] + lists[v].size();
+        arcs.clear();
+        arcs.reserve(offsets[n]);
+        for (auto& list : lists) {
+            // Sorted by far end so unpacking finds an arc by binary search.
+            std::sort(list.begin(), list.end(), [](const Arc& a, const Arc& b) { return a.to < b.to; });
+            arcs.insert(arcs.end(), list.begin(), list.end());
+            std::vector<Arc>().swap(list);
+        }
+    };
+    flatten(upward_out, hierarchy.forward_offsets_, hierarchy.forward_arcs_);
+    flatten(upward_in, hierarchy.backward_offsets_, hierarchy.backward_arcs_);
+
+    for (const auto* arcs : {&hierarchy.forward_arcs_, &hierarchy.backward_arcs_}) {
+        for (const auto& arc : *arcs) {
+            if (arc.middle >= 0) hierarchy.stats_.shortcuts++;
+        }
+    }
+    hierarchy.stats_.witness_searches = contractor.witness_searches();
+    hierarchy.stats_.witness_settled = contractor.witness_settled();
+    hierarchy.unpacking_.resize(hierarchy.forward_arcs_.size() + hierarchy.backward_arcs_.size());
+    for (std::size_t v = 0; v < n; ++v) {
+        const int vertex = static_cast<int>(v);
+        for (const Arc* arc = hierarchy.forward_begin(vertex); arc != hierarchy.forward_end(vertex); ++arc) {
+            auto& entry = hierarchy.unpacking_[static_cast<std::size_t>(hierarchy.arc_id(arc))];
+            entry.tail = vertex;
+            entry.head = arc->to;
+        }
+        for (const Arc* arc = hierarchy.backward_begin(vertex); arc != hierarchy.backward_end(vertex); ++arc) {
+            auto& entry = hierarchy.unpacking_[static_cast<std::size_t>(hierarchy.arc_id(arc))];
+            entry.tail = arc->to;
+            entry.head = vertex;
+        }
+    }
+    for (std::size_t id = 0; id < hierarchy.unpacking_.size(); ++id) {
+        const Arc& arc = id < hierarchy.forward_arcs_.size()
+                             ? hierarchy.forward_arcs_[id]
+                             : hierarchy.backward_arcs_[id - hierarchy.forward_arcs_.size()];
+        if (arc.middle < 0) continue;
+        auto& entry = hierarchy.unpacking_[id];
+        entry.first = hierarchy.find_arc(entry.tail, arc.middle);
+        entry.second = hierarchy.find_arc(arc.middle, entry.head);
+    }
+    for (auto& side : hierarchy.sides_) {
+        side.distances.assign(n, kInfinity);
+        side.parents.assign(n, -1);
+    }
+    return hierarchy;
+}
+
+auto ContractionHierarchy::forward_begin(int vertex) const -> const Arc* {
+    return forward_arcs_.data() + forward_offsets_[static_cast<std::size_t>(vertex)];
+}
+
+auto ContractionHierarchy::forward_end(int vertex) const -> const Arc* {
+    return forward_arcs_.data() + forward_offsets_[static_cast<std::size_t>(vertex) + 1];
+}
+
+auto ContractionHierarchy::backward_begin(int vertex) const -> const Arc* {
+    return backward_arcs_.data() + backward_offsets_[static_cast<std::size_t>(vertex)];
+}
+
+auto ContractionHierarchy::backward_end(int vertex) const -> const Arc* {
+    return backward_arcs_.data() + backward_offsets_[static_cast<std::size_t>(vertex) + 1];
+}
+
+int ContractionHierarchy::arc_id(const Arc* arc) const {
+    if (arc >= forward_arcs_.data() && arc < forward_arcs_.data() + forward_arcs_.size()) {
+        return static_cast<int>(arc - forward_arcs_.data());
+    }
+    return static_cast<int>(forward_arcs_.size()) + static_cast<int>(arc - backward_arcs_.data());
+}
+
+// The arc tail -> head lives at whichever endpoint ranks lower.
+int ContractionHierarchy::find_arc(int tail, int head) const {
+    const bool upward = rank(tail) < rank(head);
+    const Arc* begin = upward ? forward_begin(tail) : backward_begin(head);
+    const Arc* end = upward ? forward_end(tail) : backward_end(head);
+    const int to = upward ? head : tail;
+    const Arc* arc = std::lower_bound(begin, end, to, [](const Arc& a, int vertex) { return a.to < vertex; });
+    if (arc == end || arc->to != to) {
+        throw std::logic_error("contraction hierarchy is missing a shortcut half");
+    }
+    return arc_id(arc);
+}
+
+// Appends the original vertices after the arc's tail up to its head.
+// Iterative: shortcut nesting follows the hierarchy depth.
+void ContractionHierarchy::unpack(int arc, std::vector<int>& path) const {
+    auto& stack = unpack_stack_;
+    stack.assign(1, arc);
+    while (!stack.empty()) {
+        const Unpacking& entry = unpacking_[static_cast<std::size_t>(stack.back())];
+        stack.pop_back();
+        if (entry.first < 0) {
+            path.push_back(entry.head);
+            continue;
+        }
+        stack.push_back(entry.second);
+        stack.push_back(entry.first);
+    }
+}
+
+PointToPointResult ContractionHierarchy::query(int source, int target, DijkstraQueue& queue_fwd,
+                                               DijkstraQueue& queue_bwd) const {
+    const std::size_t n = rank_.size();
+    if (n == 0) {
+        throw std::invalid_argument("Contraction hierarchy is empty");
+    }
+    if (source < 0 || static_cast<std::size_t>(source) >= n || target < 0 || static_cast<std::size_t>(target) >= n) {
+        throw std::out_of_range("Query vertex out of range");
+    }
+    if (&queue_fwd == &queue_bwd) {
+        throw std::invalid_argument("bidirectional search needs two distinct queues");
+    }
+
+    PointToPointResult result;
+    try {
+        search(source, target, queue_fwd, queue_bwd, result);
+    } catch (...) {
+        clear_sides();
+        throw;
+    }
+    clear_sides();
+    return result;
+}
+
+void ContractionHierarchy::search(int source, int target, DijkstraQueue& queue_fwd, DijkstraQueue& queue_bwd,
+                                  PointToPointResult& result) const {
+    const std::size_t n = rank_.size();
+    DijkstraQueue* queues[2] = {&queue_fwd, &queue_bwd};
+    const int roots[2] = {source, target};
+    for (int i = 0; i < 2; ++i) {
+        queues[i]->reset(n);
+        sides_[i].distances[static_cast<std::size_t>(roots[i])] = 0;
+        sides_[i].touched.push_back(roots[i]);
+        queues[i]->push_or_decrease(roots[i], 0);
+    }
+
+    long long best = kInfinity;
+    int meet = -1;
+    bool active[2] = {true, true};
+    int turn = 0;
+    while (active[0] || active[1]) {
+        turn = active[1 - turn] ? 1 - turn : turn;
+        Side& side = sides_[turn];
+        const Side& other = sides_[1 - turn];
+        DijkstraQueue& queue = *queues[turn];
+        if (queue.empty()) {
+            active[turn] = false;
+            continue;
+        }
+        auto [dist_u, u] = queue.extract_min();
+        const auto ui = static_cast<std::size_t>(u);
+        if (dist_u > side.distances[ui]) continue;
+        // Upward searches cannot stop at the first meeting; a side is done
+        // once its radius reaches the best path found.
+        if (dist_u >= best) {
+            active[turn] = false;
+            continue;
+        }
+        result.settled++;
+        if (other.distances[ui] < kInfinity && dist_u + other.distances[ui] < best) {
+            best = dist_u + other.distances[ui];
+            meet = u;
+        }
+
+        // Stall-on-demand: u is reached suboptimally if a higher vertex
+        // already has a shorter way down to it, so its arcs are not relaxed.
+        const Arc* down_begin = turn == 0 ? backward_begin(u) : forward_begin(u);
+        const Arc* down_end = turn == 0 ? backward_end(u) : forward_end(u);
+        bool stalled = false;
+        for (const Arc* arc = down_begin; arc != down_end; ++arc) {
+            const long long higher = side.distances[static_cast<std::size_t>(arc->to)];
+            if (higher < kInfinity && higher + arc->weight < dist_u) {
+                stalled = true;
+                break;
+            }
+        }
+        if (stalled) continue;
+
+        const Arc* up_begin = turn == 0 ? forward_begin(u) : backward_begin(u);
+        const Arc* up_end = turn == 0 ? forward_end(u) : backward_end(u);
+        for (const Arc* arc = up_begin; arc != up_end; ++arc) {
+            const long long candidate = dist_u + arc->weight;
+            auto& current = side.distances[static_cast<std::size_t>(arc->to)];
+            if (candidate < current) {
+                if (current == kInfinity) side.touched.push_back(arc->to);
+                current = candidate;
+                side.parents[static_cast<std::size_t>(arc->to)] = arc_id(arc);
+                queue.push_or_decrease(arc->to, candidate);
+            }
+        }
+    }
+
+    if (meet >= 0) {
+        result.distance = best;
+        std::vector<int> arcs;
+        for (int v = meet; sides_[0].parents[static_cast<std::size_t>(v)] >= 0;) {
+            const int arc = sides_[0].parents[static_cast<std::size_t>(v)];
+            arcs.push_back(arc);
+            v = unpacking_[static_cast<std::size_t>(arc)].tail;
+        }
+        std::reverse(arcs.begin(), arcs.end());
+        for (int v = meet; sides_[1].parents[static_cast<std::size_t>(v)] >= 0;) {
+            const int arc = sides_[1].parents[static_cast<std::size_t>(v)];
+            arcs.push_back(arc);
+            v = unpacking_[static_cast<std::size_t>(arc)].head;
+        }
+        result.path.push_back(source);
+        for (int arc : arcs) {
+            unpack(arc, result.path);
+        }
+    }
+}
+
+void ContractionHierarchy::clear_sides() const {
+    for (auto& side : sides_) {
+        for (int v : side.touched) {
+            side.distances[static_cast<std::size_t>(v)] = kInfinity;
+            side.parents[static_cast<std::size_t>(v)] = -1;
+        }
+        side.touched.clear();
+    }
+}
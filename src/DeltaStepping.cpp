@@ -0,0 +1,265 @@
+#include "DeltaStepping.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+constexpr long long kInfinity = std::numeric_limits<long long>::max() / 4;
+constexpr long long kNoBucket = -1;
+constexpr std::size_t kMaxSlots = std::size_t{1} << 16;
+
+// Reusable barrier; C++17 has none.
+class Barrier {
+public:
+    explicit Barrier(std::size_t count) : count_(count) {}
+
+    void wait() {
+        if (count_ == 1) return;
+        std::unique_lock<std::mutex> lock(mutex_);
+        const std::size_t generation = generation_;
+        if (++waiting_ == count_) {
+            waiting_ = 0;
+            generation_++;
+            released_.notify_all();
+            return;
+        }
+        released_.wait(lock, [&] { return generation != generation_; });
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable released_;
+    std::size_t count_;
+    std::size_t waiting_ = 0;
+    std::size_t generation_ = 0;
+};
+
+struct Request {
+    int vertex = -1;
+    int parent = -1;
+    long long distance = 0;
+};
+
+// One thread's vertices: their buckets, the requests it posts to each
+// owner, and what it removed from the current bucket.
+struct Worker {
+    std::vector<std::vector<int>> slots;
+    std::vector<std::vector<Request>> outbox;
+    std::vector<int> frontier;
+    std::vector<int> removed;
+    std::size_t inserts = 0;
+    std::size_t extracts = 0;
+    std::size_t stale = 0;
+    std::size_t requests = 0;
+};
+} // namespace
+
+long long DeltaStepping::suggest_delta(const Graph& graph) {
+    long long total = 0;
+    long long heaviest = 0;
+    std::size_t count = 0;
+    for (std::size_t v = 0; v < graph.node_count(); ++v) {
+        for (const auto& edge : graph.neighbors(static_cast<int>(v))) {
+            if (edge.weight >= kInfinity) continue;
+            total += edge.weight;
+            heaviest = std::max(heaviest, edge.weight);
+            count++;
+        }
+    }
+    const long long mean = count == 0 ? 1 : total / static_cast<long long>(count);
+    const long long floor = heaviest / static_cast<long long>(kMaxSlots - 2) + 1;
+    return std::max({8 * mean, floor, 1LL});
+}
+
+DeltaStepping DeltaStepping::build(const Graph& graph, long long delta) {
+    if (graph.empty()) {
+        throw std::invalid_argument("Graph is empty");
+    }
+    if (delta < 0) {
+        throw std::invalid_argument("delta must not be negative");
+    }
+    DeltaStepping engine;
+    engine.delta_ = delta == 0 ? suggest_delta(graph) : delta;
+
+    const std::size_t n = graph.node_count();
+    long long heaviest = 0;
+    engine.offsets_.assign(n + 1, 0);
+    engine.heavy_begin_.assign(n, 0);
+    engine.arcs_.reserve(graph.edge_count());
+    for (std::size_t v = 0; v < n; ++v) {
+        const auto& edges = graph.neighbors(static_cast<int>(v));
+        for (const auto& edge : edges) {
+            if (edge.weight <= engine.delta_) engine.arcs_.push_back(edge);
+        }
+        engine.heavy_begin_[v] = engine.arcs_.size();
+        for (const auto& edge : edges) {
+            if (edge.weight > engine.delta_ && edge.weight < kInfinity) {
+                engine.arcs_.push_back(edge);
+                heaviest = std::max(heaviest, edge.weight);
+            }
+        }
+        engine.light_edges_ += engine.heavy_begin_[v] - engine.offsets_[v];
+        engine.offsets_[v + 1] = engine.arcs_.size();
+    }
+    // A live entry is never more than one heaviest edge past the current
+    // bucket, so this many slots never alias.
+    const auto span = static_cast<std::size_t>(std::max(heaviest, engine.delta_) / engine.delta_) + 2;
+    if (span > kMaxSlots) {
+        throw std::invalid_argument("delta too small for the heaviest edge");
+    }
+    while (engine.slots_ < span) engine.slots_ <<= 1;
+    return engine;
+}
+
+DijkstraResult DeltaStepping::run(int source, std::size_t threads, RunStats* stats) const {
+    const std::size_t n = node_count();
+    if (n == 0) {
+        throw std::invalid_argument("Graph is empty");
+    }
+    if (source < 0 || static_cast<std::size_t>(source) >= n) {
+        throw std::out_of_range("Source vertex out of range");
+    }
+    threads = std::clamp<std::size_t>(threads, 1, n);
+
+    DijkstraResult result;
+    result.distances.assign(n, kInfinity);
+    result.parents.assign(n, -1);
+    std::vector<long long> bucket_of(n, kNoBucket);
+    const std::size_t block = (n + threads - 1) / threads;
+    auto owner = [block](int v) { return static_cast<std::size_t>(v) / block; };
+    const std::size_t mask = slots_ - 1;
+
+    std::vector<Worker> workers(threads);
+    for (auto& worker : workers) {
+        worker.slots.resize(slots_);
+        worker.outbox.resize(threads);
+    }
+    // Per-thread answers to the collective questions between barriers.
+    std::vector<long long> next_bucket(threads, kNoBucket);
+    std::vector<char> bucket_left(threads, 0);
+    RunStats totals;
+    Barrier barrier(threads);
+
+    result.distances[static_cast<std::size_t>(source)] = 0;
+    bucket_of[static_cast<std::size_t>(source)] = 0;
+    workers[owner(source)].slots[0].push_back(source);
+    workers[owner(source)].inserts++;
+
+    auto work = [&](std::size_t t) {
+        Worker& self = workers[t];
+        auto post = [&](int u, std::size_t begin, std::size_t end) {
+            const long long dist_u = result.distances[static_cast<std::size_t>(u)];
+            for (std::size_t i = begin; i < end; ++i) {
+                const GraphEdge& edge = arcs_[i];
+                if (dist_u > kInfinity - edge.weight) continue;
+                Request request;
+                request.vertex = edge.to;
+                request.parent = u;
+                request.distance = dist_u + edge.weight;
+                self.outbox[owner(edge.to)].push_back(request);
+                self.requests++;
+            }
+        };
+        // Applies every request posted to this thread's vertices.
+        auto apply = [&] {
+            for (auto& sender : workers) {
+                for (const Request& request : sender.outbox[t]) {
+                    const auto v = static_cast<std::size_t>(request.vertex);
+                    if (request.distance >= result.distances[v]) continue;
+                    result.distances[v] = request.distance;
+                    result.parents[v] = request.parent;
+                    const long long bucket = request.distance / delta_;
+                    bucket_of[v] = bucket;
+                    self.slots[static_cast<std::size_t>(bucket) & mask].push_back(request.vertex);
+                    self.inserts++;
+                }
+            }
+        };
+        auto clear_inbox = [&] {
+            for (auto& sender : workers) sender.outbox[t].clear();
+        };
+
+        long long current = 0;
+        while (true) {
+            // The next bucket is the lowest non-empty slot of any thread.
+            next_bucket[t] = kNoBucket;
+            for (std::size_t offset = 0; offset < slots_; ++offset) {
+                if (!self.slots[static_cast<std::size_t>(current + static_cast<long long>(offset)) & mask].empty()) {
+                    next_bucket[t] = current + static_cast<long long>(offset);
+                    break;
+                }
+            }
+            barrier.wait();
+            long long bucket = kNoBucket;
+            for (long long candidate : next_bucket) {
+                if (candidate != kNoBucket && (bucket == kNoBucket || candidate < bucket)) bucket = candidate;
+            }
+            barrier.wait();
+            if (bucket == kNoBucket) break;
+            current = bucket;
+            if (t == 0) totals.buckets++;
+
+            auto& slot = self.slots[static_cast<std::size_t>(bucket) & mask];
+            while (true) {
+                for (int v : slot) {
+                    auto& label = bucket_of[static_cast<std::size_t>(v)];
+                    if (label != bucket) {
+                        self.stale++;
+                        continue;
+                    }
+                    label = kNoBucket;
+                    self.extracts++;
+                    self.frontier.push_back(v);
+                    self.removed.push_back(v);
+                }
+                slot.clear();
+                for (int u : self.frontier) {
+                    const auto ui = static_cast<std::size_t>(u);
+                    post(u, offsets_[ui], heavy_begin_[ui]);
+                }
+                self.frontier.clear();
+                barrier.wait();
+                apply();
+                bucket_left[t] = slot.empty() ? 0 : 1;
+                barrier.wait();
+                clear_inbox();
+                if (t == 0) totals.light_rounds++;
+                const bool more = std::any_of(bucket_left.begin(), bucket_left.end(), [](char c) { return c != 0; });
+                barrier.wait();
+                if (!more) break;
+            }
+
+            // Heavy edges cannot land in this bucket, so one pass settles it.
+            for (int u : self.removed) {
+                const auto ui = static_cast<std::size_t>(u);
+                post(u, heavy_begin_[ui], offsets_[ui + 1]);
+            }
+            self.removed.clear();
+            barrier.wait();
+            apply();
+            barrier.wait();
+            clear_inbox();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (std::size_t t = 1; t < threads; ++t) {
+        pool.emplace_back(work, t);
+    }
+    work(0);
+    for (auto& thread : pool) thread.join();
+
+    for (const auto& worker : workers) {
+        result.metrics.insert_count += worker.inserts;
+        result.metrics.extract_count += worker.extracts + worker.stale;
+        result.metrics.stale_extract_count += worker.stale;
+        totals.requests += worker.requests;
+    }
+    if (stats) *stats = totals;
+    return result;
+}
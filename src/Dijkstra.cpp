@@ -1,30 +1,54 @@
 #include "Dijkstra.h"
 
+#include "BHeap.h"
 #include "BinaryHeap.h"
 #include "FibonacciHeap.h"
+#include "FlatSpillHeap.h"
 #include "HollowHeap.h"
+#include "IndexedFibonacciHeap.h"
+#include "IndexedHollowHeap.h"
+#include "LeftistHeap.h"
+#include "SkewHeap.h"
+#include "ThinHeap.h"
+#include "TwoThreeHeap.h"
 
 #include <algorithm>
 #include <chrono>
+#include <cstdint>
+#include <functional>
 #include <limits>
 #include <memory>
+#include <queue>
 #include <stdexcept>
 #include <vector>
 
 namespace {
 constexpr long long kInfinity = std::numeric_limits<long long>::max() / 4;
 
-template <typename HeapType, typename HandleType>
+template <typename HeapType>
 class HeapAdapter : public DijkstraQueue {
 public:
     using Clock = std::chrono::steady_clock;
+    using HandleType = typename HeapType::handle_type;
+    using HeapKey = typename HeapType::key_type;
 
     HeapAdapter() : heap_(std::make_unique<HeapType>()) {}
 
+    // Reuses the heap and the handle table: the heap keeps its storage and
+    // bumping the epoch invalidates every entry without touching it.
     void reset(std::size_t node_count) override {
-        heap_ = std::make_unique<HeapType>();
-        handles_.assign(node_count, nullptr);
+        const auto start = Clock::now();
+        heap_->clear();
+        if (++epoch_ == 0) {
+            std::fill(handles_.begin(), handles_.end(), HandleEntry{});
+            epoch_ = 1;
+        }
+        if (handles_.size() < node_count) {
+            handles_.resize(node_count, HandleEntry{});
+        }
+        const auto end = Clock::now();
         metrics_ = {};
+        metrics_.reset_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
     }
 
     void push_or_decrease(int vertex, long long key) override {
@@ -32,36 +56,50 @@ public:
             throw std::invalid_argument("vertex must be non-negative");
         }
         if (static_cast<std::size_t>(vertex) >= handles_.size()) {
-            handles_.resize(static_cast<std::size_t>(vertex) + 1, nullptr);
+            handles_.resize(static_cast<std::size_t>(vertex) + 1, HandleEntry{});
         }
 
-        auto*& handle = handles_[static_cast<std::size_t>(vertex)];
-        if (!handle) {
+        auto& entry = handles_[static_cast<std::size_t>(vertex)];
+        if (entry.epoch != epoch_) {
             const auto start = Clock::now();
-            handle = heap_->insert(key, vertex);
+            entry.handle = heap_->insert(static_cast<HeapKey>(key), vertex);
+            entry.epoch = epoch_;
             const auto end = Clock::now();
+            const long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
             metrics_.insert_count++;
-            metrics_.insert_time_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+            metrics_.insert_time_ns += ns;
+            metrics_.insert_latency.record(ns);
         } else {
             const auto start = Clock::now();
-            heap_->decrease_key(handle, key);
+            heap_->decrease_key(entry.handle, static_cast<HeapKey>(key));
             const auto end = Clock::now();
+            const long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
             metrics_.decrease_count++;
-            metrics_.decrease_time_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+            metrics_.decrease_time_ns += ns;
+            metrics_.decrease_latency.record(ns);
         }
     }
 
+    // The handle is dropped: a duplicate is never decreased.
+    void push(int vertex, long long key) override {
+        const auto start = Clock::now();
+        heap_->insert(static_cast<HeapKey>(key), vertex);
+        const auto end = Clock::now();
+        const long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        metrics_.insert_count++;
+        metrics_.insert_time_ns += ns;
+        metrics_.insert_latency.record(ns);
+    }
+
     std::pair<long long, int> extract_min() override {
         const auto start = Clock::now();
-        auto result = heap_->extract_min();
+        auto extracted = heap_->extract_min();
         const auto end = Clock::now();
+        const long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
         metrics_.extract_count++;
-        metrics_.extract_time_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
-        int vertex = result.second;
-        if (vertex >= 0 && static_cast<std::size_t>(vertex) < handles_.size()) {
-            handles_[static_cast<std::size_t>(vertex)] = nullptr;
-        }
-        return result;
+        metrics_.extract_time_ns += ns;
+        metrics_.extract_latency.record(ns);
+        return {static_cast<long long>(extracted.first), extracted.second};
     }
 
     bool empty() const override {
@@ -74,48 +112,458 @@ public:
         return heap_->structure_stats();
     }
 
+    const AllocationStats& allocation_stats() const override {
+        return heap_->allocation_stats();
+    }
+
 private:
+    struct HandleEntry {
+        HandleType handle;
+        std::uint32_t epoch = 0; // entry is live only while it equals epoch_
+    };
+
     std::unique_ptr<HeapType> heap_;
-    std::vector<HandleType*> handles_;
+    // Left in place after extract_min: a settled vertex is never pushed again,
+    // and debug builds reject the stale handle if it were.
+    std::vector<HandleEntry> handles_;
+    std::uint32_t epoch_ = 1;
     QueueMetrics metrics_;
 };
-} // namespace
 
-std::unique_ptr<DijkstraQueue> make_queue_adapter(HeapSelection selection) {
+void fold_structure(HeapStructureStats& dest, const HeapStructureStats& src) {
+    dest.current_nodes += src.current_nodes;
+    dest.max_nodes = std::max(dest.max_nodes, src.max_nodes);
+    dest.max_tree_height = std::max(dest.max_tree_height, src.max_tree_height);
+    dest.max_roots = std::max(dest.max_roots, src.max_roots);
+    dest.consolidation_passes += src.consolidation_passes;
+    dest.link_operations += src.link_operations;
+    dest.current_bytes += src.current_bytes;
+    dest.max_bytes = std::max(dest.max_bytes, src.max_bytes);
+}
+
+void fold_allocation(AllocationStats& dest, const AllocationStats& src) {
+    dest.allocations += src.allocations;
+    dest.deallocations += src.deallocations;
+    dest.system_allocations += src.system_allocations;
+    dest.reserved_bytes += src.reserved_bytes;
+    dest.max_reserved_bytes = std::max(dest.max_reserved_bytes, src.max_reserved_bytes);
+}
+
+// Runs on CompactHeap and moves to DecreaseHeap while the last kWindow ops
+// were decrease-heavy over a large frontier, and back once they are not.
+// Migration drains the active heap in key order into the other one and
+// remaps every queued vertex's handle; the thresholds have hysteresis so a
+// mix near the boundary does not migrate every window.
+template <typename CompactHeap, typename DecreaseHeap>
+class AdaptiveAdapter : public DijkstraQueue {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Heap = PriorityQueue<long long, int>;
+
+    static constexpr std::size_t kWindow = 4096;
+    // Calibrated on the random workload: the binary heap keeps up until about
+    // half the ops are decreases and the frontier is in the tens of thousands.
+    static constexpr std::size_t kEnterDecreasePct = 45;
+    static constexpr std::size_t kLeaveDecreasePct = 30;
+    static constexpr std::size_t kEnterFrontier = 8192;
+    static constexpr std::size_t kLeaveFrontier = 2048;
+
+    AdaptiveAdapter()
+        : compact_(std::make_unique<CompactHeap>()),
+          decrease_(std::make_unique<DecreaseHeap>()),
+          active_(compact_.get()) {}
+
+    void reset(std::size_t node_count) override {
+        const auto start = Clock::now();
+        compact_->clear();
+        decrease_->clear();
+        active_ = compact_.get();
+        if (++epoch_ == 0) {
+            std::fill(handles_.begin(), handles_.end(), HandleEntry{});
+            epoch_ = 1;
+        }
+        if (handles_.size() < node_count) {
+            handles_.resize(node_count, HandleEntry{});
+        }
+        live_ = 0;
+        start_window();
+        retired_structure_ = {};
+        retired_allocation_ = {};
+        const auto end = Clock::now();
+        metrics_ = {};
+        metrics_.reset_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    }
+
+    void push_or_decrease(int vertex, long long key) override {
+        if (vertex < 0) {
+            throw std::invalid_argument("vertex must be non-negative");
+        }
+        if (static_cast<std::size_t>(vertex) >= handles_.size()) {
+            handles_.resize(static_cast<std::size_t>(vertex) + 1, HandleEntry{});
+        }
+
+        auto& entry = handles_[static_cast<std::size_t>(vertex)];
+        if (entry.epoch != epoch_) {
+            const auto start = Clock::now();
+            entry.handle = active_->insert(key, vertex);
+            entry.epoch = epoch_;
+            const auto end = Clock::now();
+            const long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+            metrics_.insert_count++;
+            metrics_.insert_time_ns += ns;
+            metrics_.insert_latency.record(ns);
+            live_++;
+        } else {
+            const auto start = Clock::now();
+            active_->decrease_key(entry.handle, key);
+            const auto end = Clock::now();
+            const long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+            metrics_.decrease_count++;
+            metrics_.decrease_time_ns += ns;
+            metrics_.decrease_latency.record(ns);
+            window_decreases_++;
+        }
+        observe_op();
+    }
+
+    // Migration remaps one handle per vertex, so duplicates are not allowed.
+    void push(int vertex, long long key) override { push_or_decrease(vertex, key); }
+
+    std::pair<long long, int> extract_min() override {
+        const auto start = Clock::now();
+        auto extracted = active_->extract_min();
+        const auto end = Clock::now();
+        const long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        metrics_.extract_count++;
+        metrics_.extract_time_ns += ns;
+        metrics_.extract_latency.record(ns);
+        live_--;
+        observe_op();
+        return extracted;
+    }
+
+    bool empty() const override {
+        return active_->is_empty();
+    }
+
+    const QueueMetrics& metrics() const override { return metrics_; }
+
+    // Peaks over both heaps, including contents they held before a migration.
+    const HeapStructureStats& structure_stats() const override {
+        combined_structure_ = retired_structure_;
+        fold_structure(combined_structure_, compact_->structure_stats());
+        fold_structure(combined_structure_, decrease_->structure_stats());
+        return combined_structure_;
+    }
+
+    const AllocationStats& allocation_stats() const override {
+        combined_allocation_ = retired_allocation_;
+        fold_allocation(combined_allocation_, compact_->allocation_stats());
+        fold_allocation(combined_allocation_, decrease_->allocation_stats());
+        return combined_allocation_;
+    }
+
+private:
+    struct HandleEntry {
+        HeapHandle handle;
+        std::uint32_t epoch = 0; // entry is live only while it equals epoch_
+    };
+
+    bool on_decrease_heap() const { return active_ == decrease_.get(); }
+
+    void start_window() {
+        window_ops_ = 0;
+        window_decreases_ = 0;
+        window_frontier_sum_ = 0;
+    }
+
+    void observe_op() {
+        window_frontier_sum_ += live_;
+        if (++window_ops_ < kWindow) {
+            return;
+        }
+        const std::size_t decrease_pct = window_decreases_ * 100 / kWindow;
+        const std::size_t frontier = window_frontier_sum_ / kWindow;
+        if (!on_decrease_heap()) {
+            if (decrease_pct >= kEnterDecreasePct && frontier >= kEnterFrontier) {
+                migrate();
+            }
+        } else if (decrease_pct < kLeaveDecreasePct || frontier < kLeaveFrontier) {
+            migrate();
+        }
+        start_window();
+    }
+
+    void migrate() {
+        const auto start = Clock::now();
+        Heap* target = on_decrease_heap() ? static_cast<Heap*>(compact_.get()) : decrease_.get();
+        // clear() resets the target's counters; keep what it reported so far.
+        if (target == compact_.get()) {
+            fold_structure(retired_structure_, compact_->structure_stats());
+            fold_allocation(retired_allocation_, compact_->allocation_stats());
+        } else {
+            fold_structure(retired_structure_, decrease_->structure_stats());
+            fold_allocation(retired_allocation_, decrease_->allocation_stats());
+        }
+        retired_structure_.current_nodes = 0;
+        retired_structure_.current_bytes = 0;
+        target->clear();
+
+        drained_.clear();
+        while (!active_->is_empty()) {
+            drained_.push_back(active_->extract_min());
+        }
+        // Ascending keys: each insert lands at the bottom of the new heap.
+        for (const auto& [key, vertex] : drained_) {
+            handles_[static_cast<std::size_t>(vertex)].handle = target->insert(key, vertex);
+        }
+        active_ = target;
+
+        const auto end = Clock::now();
+        metrics_.migration_count++;
+        metrics_.migration_time_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    }
+
+    std::unique_ptr<CompactHeap> compact_;
+    std::unique_ptr<DecreaseHeap> decrease_;
+    Heap* active_;
+    std::vector<HandleEntry> handles_;
+    std::uint32_t epoch_ = 1;
+    std::vector<std::pair<long long, int>> drained_;
+
+    std::size_t live_ = 0;
+    std::size_t window_ops_ = 0;
+    std::size_t window_decreases_ = 0;
+    std::size_t window_frontier_sum_ = 0;
+
+    QueueMetrics metrics_;
+    HeapStructureStats retired_structure_;
+    AllocationStats retired_allocation_;
+    mutable HeapStructureStats combined_structure_;
+    mutable AllocationStats combined_allocation_;
+};
+
+// std::priority_queue baseline. There is no decrease-key, so
+// push_or_decrease pushes a duplicate like push does. No per-node
+// allocations; the structure stats track the entry vector.
+template <typename Stats>
+class StdPriorityQueueAdapter : public DijkstraQueue {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Entry = std::pair<long long, int>;
+
+    void reset(std::size_t) override {
+        const auto start = Clock::now();
+        queue_.clear();
+        structure_ = {};
+        const auto end = Clock::now();
+        metrics_ = {};
+        metrics_.reset_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    }
+
+    void push_or_decrease(int vertex, long long key) override { push(vertex, key); }
+
+    void push(int vertex, long long key) override {
+        if (vertex < 0) {
+            throw std::invalid_argument("vertex must be non-negative");
+        }
+        const auto start = Clock::now();
+        queue_.emplace(key, vertex);
+        const auto end = Clock::now();
+        const long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        metrics_.insert_count++;
+        metrics_.insert_time_ns += ns;
+        metrics_.insert_latency.record(ns);
+        if constexpr (Stats::kEnabled) {
+            structure_.current_nodes = queue_.size();
+            structure_.max_nodes = std::max(structure_.max_nodes, queue_.size());
+            structure_.current_bytes = queue_.capacity() * sizeof(Entry);
+            structure_.max_bytes = std::max(structure_.max_bytes, structure_.current_bytes);
+            structure_.max_tree_height = std::max(structure_.max_tree_height, height_of(queue_.size()));
+            structure_.max_roots = 1;
+        }
+    }
+
+    std::pair<long long, int> extract_min() override {
+        if (queue_.empty()) {
+            throw std::runtime_error("extract_min from empty std::priority_queue");
+        }
+        const auto start = Clock::now();
+        Entry top = queue_.top();
+        queue_.pop();
+        const auto end = Clock::now();
+        const long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        metrics_.extract_count++;
+        metrics_.extract_time_ns += ns;
+        metrics_.extract_latency.record(ns);
+        if constexpr (Stats::kEnabled) structure_.current_nodes = queue_.size();
+        return top;
+    }
+
+    bool empty() const override { return queue_.empty(); }
+    const QueueMetrics& metrics() const override { return metrics_; }
+    const HeapStructureStats& structure_stats() const override { return structure_; }
+    const AllocationStats& allocation_stats() const override { return allocation_; }
+
+private:
+    // Exposes the container so reset() keeps its capacity.
+    struct Queue : std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> {
+        void clear() { c.clear(); }
+        std::size_t capacity() const { return c.capacity(); }
+    };
+
+    static std::size_t height_of(std::size_t size) {
+        std::size_t height = 0;
+        while (size) {
+            size >>= 1;
+            ++height;
+        }
+        return height;
+    }
+
+    Queue queue_;
+    QueueMetrics metrics_;
+    HeapStructureStats structure_;
+    AllocationStats allocation_;
+};
+
+template <typename Alloc, typename Stats>
+std::unique_ptr<DijkstraQueue> make_queue_adapter_with(HeapSelection selection) {
+    using Key = long long;
+    using Compare = std::less<Key>;
     switch (selection) {
         case HeapSelection::kBinary:
-            return std::make_unique<HeapAdapter<BinaryHeap, BinaryHeapNode>>();
+            return std::make_unique<HeapAdapter<BinaryHeap<Key, int, Compare, Alloc, Stats>>>();
         case HeapSelection::kFibonacci:
-            return std::make_unique<HeapAdapter<FibonacciHeap, FibonacciHeapNode>>();
+            return std::make_unique<HeapAdapter<FibonacciHeap<Key, int, Compare, Alloc, Stats>>>();
         case HeapSelection::kHollow:
-            return std::make_unique<HeapAdapter<HollowHeap, HollowHeapNode>>();
+            return std::make_unique<HeapAdapter<HollowHeap<Key, int, Compare, Alloc, Stats>>>();
+        // The index-based heaps (and the B-heap below) keep nodes in their own
+        // arrays; no allocator policy applies.
+        case HeapSelection::kFibonacciIndexed:
+            return std::make_unique<HeapAdapter<IndexedFibonacciHeap<Key, int, Compare, Stats>>>();
+        case HeapSelection::kHollowIndexed:
+            return std::make_unique<HeapAdapter<IndexedHollowHeap<Key, int, Compare, Stats>>>();
+        case HeapSelection::kAdaptive:
+            return std::make_unique<AdaptiveAdapter<BinaryHeap<Key, int, Compare, Alloc, Stats>,
+                                                    IndexedFibonacciHeap<Key, int, Compare, Stats>>>();
+        case HeapSelection::kFlat:
+            return std::make_unique<HeapAdapter<FlatSpillHeap<Key, int, Compare, Alloc, Stats>>>();
+        case HeapSelection::kBHeap:
+            return std::make_unique<HeapAdapter<BHeap<Key, int, Compare, Stats>>>();
+        case HeapSelection::kThin:
+            return std::make_unique<HeapAdapter<ThinHeap<Key, int, Compare, Alloc, Stats>>>();
+        case HeapSelection::kTwoThree:
+            return std::make_unique<HeapAdapter<TwoThreeHeap<Key, int, Compare, Alloc, Stats>>>();
+        case HeapSelection::kFibonacciBounded:
+            return std::make_unique<HeapAdapter<BoundedFibonacciHeap<Key, int, Compare, Alloc, Stats>>>();
+        case HeapSelection::kLeftist:
+            return std::make_unique<HeapAdapter<LeftistHeap<Key, int, Compare, Alloc, Stats>>>();
+        case HeapSelection::kSkew:
+            return std::make_unique<HeapAdapter<SkewHeap<Key, int, Compare, Alloc, Stats>>>();
+        case HeapSelection::kStdPriorityQueue:
+            return std::make_unique<StdPriorityQueueAdapter<Stats>>();
         default:
             throw std::invalid_argument("Unknown heap selection");
     }
 }
 
-DijkstraResult run_dijkstra(const Graph& graph, int source, DijkstraQueue& queue) {
+template <typename Stats>
+std::unique_ptr<DijkstraQueue> make_queue_adapter_for(HeapSelection selection, AllocatorPolicy allocator) {
+    switch (allocator) {
+        case AllocatorPolicy::kNewDelete:
+            return make_queue_adapter_with<NewDeleteAllocator, Stats>(selection);
+        case AllocatorPolicy::kPool:
+            return make_queue_adapter_with<PoolAllocator, Stats>(selection);
+        case AllocatorPolicy::kArena:
+            return make_queue_adapter_with<MonotonicArenaAllocator, Stats>(selection);
+        case AllocatorPolicy::kHugePageArena:
+            return make_queue_adapter_with<HugePageArenaAllocator, Stats>(selection);
+        default:
+            throw std::invalid_argument("Unknown allocator policy");
+    }
+}
+} // namespace
+
+std::unique_ptr<DijkstraQueue> make_queue_adapter(HeapSelection selection, AllocatorPolicy allocator,
+                                                  StatsPolicy stats) {
+    switch (stats) {
+        case StatsPolicy::kFull:
+            return make_queue_adapter_for<FullStats>(selection, allocator);
+        case StatsPolicy::kSampled:
+            return make_queue_adapter_for<SampledStats>(selection, allocator);
+        case StatsPolicy::kNone:
+            return make_queue_adapter_for<NoStats>(selection, allocator);
+        default:
+            throw std::invalid_argument("Unknown stats policy");
+    }
+}
+
+namespace {
+// Lazy pushes duplicates instead of decreasing. A stale entry surfaces with
+// a key above its vertex's settled distance and is skipped either way, so
+// the eager search also runs on queues that only insert. Every source is
+// seeded at its offset; when owners is set, each vertex records the index
+// of the source its shortest path starts from.
+template <bool Lazy>
+void run_search(const Graph& graph, const SearchSource* sources, std::size_t source_count, DijkstraQueue& queue,
+                std::vector<int>* owners, DijkstraResult& result) {
     if (graph.empty()) {
         throw std::invalid_argument("Graph is empty");
     }
-    if (source < 0 || static_cast<std::size_t>(source) >= graph.node_count()) {
-        throw std::out_of_range("Source vertex out of range");
+    if (source_count == 0) {
+        throw std::invalid_argument("search needs at least one source");
+    }
+    for (std::size_t i = 0; i < source_count; ++i) {
+        if (sources[i].vertex < 0 || static_cast<std::size_t>(sources[i].vertex) >= graph.node_count()) {
+            throw std::out_of_range("Source vertex out of range");
+        }
+        if (sources[i].offset < 0 || sources[i].offset >= kInfinity) {
+            throw std::invalid_argument("source offset out of range");
+        }
     }
 
     const std::size_t n = graph.node_count();
-    DijkstraResult result;
     result.distances.assign(n, kInfinity);
     result.parents.assign(n, -1);
 
-    queue.reset(n);
-    result.distances[static_cast<std::size_t>(source)] = 0;
-    queue.push_or_decrease(source, 0);
+    auto push = [&queue](int vertex, long long key) {
+        if constexpr (Lazy) {
+            queue.push(vertex, key);
+        } else {
+            queue.push_or_decrease(vertex, key);
+        }
+    };
 
+    if (owners) {
+        owners->assign(n, -1);
+    }
+
+    // Entries queued minus vertices still open is the stale count; it is
+    // zero unless the queue holds duplicates. A vertex listed twice keeps
+    // its smaller offset.
+    queue.reset(n);
+    std::size_t open = 0;
+    for (std::size_t i = 0; i < source_count; ++i) {
+        const auto vertex = static_cast<std::size_t>(sources[i].vertex);
+        auto& current = result.distances[vertex];
+        if (sources[i].offset >= current) {
+            continue;
+        }
+        if (current == kInfinity) open++;
+        current = sources[i].offset;
+        if (owners) (*owners)[vertex] = static_cast<int>(i);
+        push(sources[i].vertex, sources[i].offset);
+    }
+    std::size_t stale_extracts = 0;
+    std::size_t peak_stale = 0;
     while (!queue.empty()) {
         auto [dist_u, u] = queue.extract_min();
         if (dist_u > result.distances[static_cast<std::size_t>(u)]) {
+            stale_extracts++;
             continue;
         }
+        open--;
 
         for (const auto& edge : graph.neighbors(u)) {
             if (edge.weight >= kInfinity) {
@@ -128,14 +576,268 @@ DijkstraResult run_dijkstra(const Graph& graph, int source, DijkstraQueue& queue
             long long candidate = dist_u + edge.weight;
             auto& current = result.distances[static_cast<std::size_t>(edge.to)];
             if (candidate < current) {
+                if (current == kInfinity) open++;
                 current = candidate;
                 result.parents[static_cast<std::size_t>(edge.to)] = u;
-                queue.push_or_decrease(edge.to, candidate);
+                if (owners) (*owners)[static_cast<std::size_t>(edge.to)] = (*owners)[static_cast<std::size_t>(u)];
+                push(edge.to, candidate);
             }
         }
+        const QueueMetrics& metrics = queue.metrics();
+        const std::size_t queued = metrics.insert_count - metrics.extract_count;
+        peak_stale = std::max(peak_stale, queued - open);
     }
 
     result.metrics = queue.metrics();
+    result.metrics.stale_extract_count = stale_extracts;
+    result.metrics.peak_stale_entries = peak_stale;
     result.structure = queue.structure_stats();
+    result.allocation = queue.allocation_stats();
+}
+} // namespace
+
+DijkstraResult run_dijkstra(const Graph& graph, int source, DijkstraQueue& queue) {
+    DijkstraResult result;
+    run_dijkstra(graph, source, queue, result);
+    return result;
+}
+
+void run_dijkstra(const Graph& graph, int source, DijkstraQueue& queue, DijkstraResult& result) {
+    const SearchSource root{source, 0};
+    run_search<false>(graph, &root, 1, queue, nullptr, result);
+}
+
+DijkstraResult run_lazy_dijkstra(const Graph& graph, int source, DijkstraQueue& queue) {
+    const SearchSource root{source, 0};
+    DijkstraResult result;
+    run_search<true>(graph, &root, 1, queue, nullptr, result);
+    return result;
+}
+
+DijkstraResult run_multi_source_dijkstra(const Graph& graph, const std::vector<SearchSource>& sources,
+                                         DijkstraQueue& queue, std::vector<int>* owners) {
+    DijkstraResult result;
+    run_search<false>(graph, sources.data(), sources.size(), queue, owners, result);
+    return result;
+}
+
+namespace {
+void check_endpoints(const Graph& graph, int source, int target) {
+    if (graph.empty()) {
+        throw std::invalid_argument("Graph is empty");
+    }
+    if (source < 0 || static_cast<std::size_t>(source) >= graph.node_count() || target < 0 ||
+        static_cast<std::size_t>(target) >= graph.node_count()) {
+        throw std::out_of_range("Query vertex out of range");
+    }
+}
+
+// One direction of a point-to-point search. Backward searches run over the
+// reverse adjacency, so parents point toward the target.
+struct SearchSide {
+    const Graph& graph;
+    DijkstraQueue& queue;
+    bool backward;
+    std::vector<long long> distances;
+    std::vector<int> parents;
+    long long radius = 0; // key of the last vertex settled
+    std::size_t settled = 0;
+
+    SearchSide(const Graph& g, DijkstraQueue& q, bool is_backward, int root)
+        : graph(g), queue(q), backward(is_backward), distances(g.node_count(), kInfinity),
+          parents(g.node_count(), -1) {
+        queue.reset(g.node_count());
+        distances[static_cast<std::size_t>(root)] = 0;
+        queue.push_or_decrease(root, 0);
+    }
+
+    const std::vector<GraphEdge>& edges(int vertex) const {
+        return backward ? graph.reverse_neighbors(vertex) : graph.neighbors(vertex);
+    }
+
+    // Settles the next vertex, or returns -1 when the queue runs dry.
+    int settle_next() {
+        while (!queue.empty()) {
+            auto [dist_u, u] = queue.extract_min();
+            if (dist_u > distances[static_cast<std::size_t>(u)]) {
+                continue;
+            }
+            radius = dist_u;
+            settled++;
+            return u;
+        }
+        return -1;
+    }
+
+    void relax(int u) {
+        const long long dist_u = distances[static_cast<std::size_t>(u)];
+        for (const auto& edge : edges(u)) {
+            if (edge.weight >= kInfinity || dist_u > kInfinity - edge.weight) {
+                continue;
+            }
+            const long long candidate = dist_u + edge.weight;
+            auto& current = distances[static_cast<std::size_t>(edge.to)];
+            if (candidate < current) {
+                current = candidate;
+                parents[static_cast<std::size_t>(edge.to)] = u;
+                queue.push_or_decrease(edge.to, candidate);
+            }
+        }
+    }
+};
+} // namespace
+
+PointToPointResult run_point_to_point(const Graph& graph, int source, int target, DijkstraQueue& queue) {
+    check_endpoints(graph, source, target);
+    SearchSide forward(graph, queue, false, source);
+    PointToPointResult result;
+    for (int u = forward.settle_next(); u >= 0; u = forward.settle_next()) {
+        if (u == target) {
+            result.distance = forward.radius;
+            for (int v = target; v >= 0; v = forward.parents[static_cast<std::size_t>(v)]) {
+                result.path.push_back(v);
+            }
+            std::reverse(result.path.begin(), result.path.end());
+            break;
+        }
+        forward.relax(u);
+    }
+    result.settled = forward.settled;
+    return result;
+}
+
+namespace {
+// Dijkstra on reduced costs: queue keys are distance + potential(v), where
+// potential is a consistent lower bound on the distance from v to target.
+// Potentials are computed once per reached vertex; one of kInfinity or more
+// marks a vertex that cannot reach target, which is never queued. Settled
+// vertices are never pushed again, even if a potential is not consistent.
+template <typename Potential>
+PointToPointResult run_goal_directed(const Graph& graph, int source, int target, DijkstraQueue& queue,
+                                     Potential potential) {
+    const std::size_t n = graph.node_count();
+    std::vector<long long> distances(n, kInfinity);
+    std::vector<long long> potentials(n, -1);
+    std::vector<int> parents(n, -1);
+    std::vector<char> settled(n, 0);
+    auto potential_of = [&](int vertex) {
+        long long& cached = potentials[static_cast<std::size_t>(vertex)];
+        if (cached < 0) cached = potential(vertex);
+        return cached;
+    };
+
+    PointToPointResult result;
+    queue.reset(n);
+    distances[static_cast<std::size_t>(source)] = 0;
+    if (potential_of(source) >= kInfinity) {
+        return result;
+    }
+    queue.push_or_decrease(source, potential_of(source));
+    while (!queue.empty()) {
+        auto [key_u, u] = queue.extract_min();
+        const long long dist_u = distances[static_cast<std::size_t>(u)];
+        if (settled[static_cast<std::size_t>(u)] || key_u > dist_u + potential_of(u)) {
+            continue;
+        }
+        settled[static_cast<std::size_t>(u)] = 1;
+        result.settled++;
+        if (u == target) {
+            result.distance = dist_u;
+            for (int v = target; v >= 0; v = parents[static_cast<std::size_t>(v)]) {
+                result.path.push_back(v);
+            }
+            std::reverse(result.path.begin(), result.path.end());
+            break;
+        }
+        for (const auto& edge : graph.neighbors(u)) {
+            if (edge.weight >= kInfinity || dist_u > kInfinity - edge.weight) {
+                continue;
+            }
+            const long long candidate = dist_u + edge.weight;
+            auto& current = distances[static_cast<std::size_t>(edge.to)];
+            if (candidate < current && !settled[static_cast<std::size_t>(edge.to)]) {
+                const long long to_target = potential_of(edge.to);
+                if (to_target >= kInfinity) {
+                    continue;
+                }
+                current = candidate;
+                parents[static_cast<std::size_t>(edge.to)] = u;
+                queue.push_or_decrease(edge.to, candidate + to_target);
+            }
+        }
+    }
+    return result;
+}
+} // namespace
+
+PointToPointResult run_astar(const Graph& graph, int source, int target, DijkstraQueue& queue) {
+    check_endpoints(graph, source, target);
+    if (!graph.has_coordinates()) {
+        throw std::invalid_argument("A* needs vertex coordinates");
+    }
+    return run_goal_directed(graph, source, target, queue,
+                             [&graph, target](int vertex) { return graph.distance_lower_bound(vertex, target); });
+}
+
+PointToPointResult run_astar(const Graph& graph, int source, int target, DijkstraQueue& queue,
+                             const std::function<long long(int)>& potential) {
+    check_endpoints(graph, source, target);
+    return run_goal_directed(graph, source, target, queue, potential);
+}
+
+PointToPointResult run_bidirectional(const Graph& graph, int source, int target, DijkstraQueue& queue_fwd,
+                                     DijkstraQueue& queue_bwd) {
+    check_endpoints(graph, source, target);
+    if (&queue_fwd == &queue_bwd) {
+        throw std::invalid_argument("bidirectional search needs two distinct queues");
+    }
+    SearchSide sides[2] = {SearchSide(graph, queue_fwd, false, source), SearchSide(graph, queue_bwd, true, target)};
+
+    // The best path is tracked by the edge (tail, head) joining the two
+    // searches: source..tail forward, head..target backward.
+    long long best = source == target ? 0 : kInfinity;
+    int meet_tail = source;
+    int meet_head = target;
+    while (best > 0) {
+        const int side_index = sides[0].radius <= sides[1].radius ? 0 : 1;
+        SearchSide& side = sides[side_index];
+        const SearchSide& other = sides[1 - side_index];
+        const int u = side.settle_next();
+        if (u < 0 || side.radius + other.radius >= best) {
+            break;
+        }
+        side.relax(u);
+        const long long dist_u = side.distances[static_cast<std::size_t>(u)];
+        for (const auto& edge : side.edges(u)) {
+            const long long other_dist = other.distances[static_cast<std::size_t>(edge.to)];
+            if (other_dist >= kInfinity || edge.weight >= kInfinity) {
+                continue;
+            }
+            const long long length = dist_u + edge.weight + other_dist;
+            if (length < best) {
+                best = length;
+                meet_tail = side.backward ? edge.to : u;
+                meet_head = side.backward ? u : edge.to;
+            }
+        }
+    }
+
+    PointToPointResult result;
+    result.settled = sides[0].settled + sides[1].settled;
+    if (best >= kInfinity) {
+        return result;
+    }
+    result.distance = best;
+    if (source == target) {
+        result.path.push_back(source);
+        return result;
+    }
+    for (int v = meet_tail; v >= 0; v = sides[0].parents[static_cast<std::size_t>(v)]) {
+        result.path.push_back(v);
+    }
+    std::reverse(result.path.begin(), result.path.end());
+    for (int v = meet_head; v >= 0; v = sides[1].parents[static_cast<std::size_t>(v)]) {
+        result.path.push_back(v);
+    }
     return result;
 }
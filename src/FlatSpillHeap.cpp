@@ -0,0 +1,115 @@
+#include "FlatSpillHeap.h"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define FLAT_SCAN_AVX2 1
+#endif
+
+namespace {
+template <typename Key>
+std::size_t argmin_scalar(const Key* keys, std::size_t count) {
+    std::size_t best = 0;
+    for (std::size_t i = 1; i < count; ++i) {
+        if (keys[i] < keys[best]) best = i;
+    }
+    return best;
+}
+
+#ifdef FLAT_SCAN_AVX2
+// Picks the first smallest of the lane minima; lanes hold their own first
+// minimum, so the lowest index among equal keys wins.
+template <typename Key, std::size_t Lanes>
+std::size_t reduce_lanes(const Key (&lane_keys)[Lanes], const long long (&lane_index)[Lanes]) {
+    std::size_t best = 0;
+    for (std::size_t lane = 1; lane < Lanes; ++lane) {
+        if (lane_keys[lane] < lane_keys[best] ||
+            (lane_keys[lane] == lane_keys[best] && lane_index[lane] < lane_index[best])) {
+            best = lane;
+        }
+    }
+    return static_cast<std::size_t>(lane_index[best]);
+}
+
+__attribute__((target("avx2"))) std::size_t argmin_avx2(const long long* keys, std::size_t count) {
+    if (count < 8) return argmin_scalar(keys, count);
+    const __m256i step = _mm256_set1_epi64x(4);
+    __m256i index = _mm256_setr_epi64x(0, 1, 2, 3);
+    __m256i best = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys));
+    __m256i best_index = index;
+    std::size_t i = 4;
+    for (; i + 4 <= count; i += 4) {
+        index = _mm256_add_epi64(index, step);
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i));
+        const __m256i smaller = _mm256_cmpgt_epi64(best, v);
+        best = _mm256_blendv_epi8(best, v, smaller);
+        best_index = _mm256_blendv_epi8(best_index, index, smaller);
+    }
+    alignas(32) long long lane_keys[4];
+    alignas(32) long long lane_index[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lane_keys), best);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lane_index), best_index);
+    std::size_t result = reduce_lanes(lane_keys, lane_index);
+    for (; i < count; ++i) {
+        if (keys[i] < keys[result]) result = i;
+    }
+    return result;
+}
+
+__attribute__((target("avx2"))) std::size_t argmin_avx2(const std::uint32_t* keys, std::size_t count) {
+    if (count < 16) return argmin_scalar(keys, count);
+    // Unsigned order via signed compares on sign-flipped keys.
+    const __m256i flip = _mm256_set1_epi32(static_cast<int>(0x80000000u));
+    const __m256i step = _mm256_set1_epi32(8);
+    __m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i best = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys)), flip);
+    __m256i best_index = index;
+    std::size_t i = 8;
+    for (; i + 8 <= count; i += 8) {
+        index = _mm256_add_epi32(index, step);
+        const __m256i v = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i)), flip);
+        const __m256i smaller = _mm256_cmpgt_epi32(best, v);
+        best = _mm256_blendv_epi8(best, v, smaller);
+        best_index = _mm256_blendv_epi8(best_index, index, smaller);
+    }
+    alignas(32) std::uint32_t flipped[8];
+    alignas(32) std::int32_t index32[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(flipped), best);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(index32), best_index);
+    std::uint32_t lane_keys[8];
+    long long lane_index[8];
+    for (std::size_t lane = 0; lane < 8; ++lane) {
+        lane_keys[lane] = flipped[lane] ^ 0x80000000u;
+        lane_index[lane] = index32[lane];
+    }
+    std::size_t result = reduce_lanes(lane_keys, lane_index);
+    for (; i < count; ++i) {
+        if (keys[i] < keys[result]) result = i;
+    }
+    return result;
+}
+
+bool has_avx2() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+#endif
+
+template <typename Key>
+std::size_t dispatch_argmin(const Key* keys, std::size_t count) {
+#ifdef FLAT_SCAN_AVX2
+    if (has_avx2()) return argmin_avx2(keys, count);
+#endif
+    return argmin_scalar(keys, count);
+}
+} // namespace
+
+std::size_t flat_argmin(const long long* keys, std::size_t count) {
+    return dispatch_argmin(keys, count);
+}
+
+std::size_t flat_argmin(const std::uint32_t* keys, std::size_t count) {
+    return dispatch_argmin(keys, count);
+}
+
+template class FlatSpillHeap<long long, int>;
+template class FlatSpillHeap<std::uint32_t, int>;
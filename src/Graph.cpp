@@ -5,6 +5,7 @@
 #include <fstream>
 #include <limits>
 #include <sstream>
+#include <stdexcept>
 
 namespace {
 constexpr long long kMaxWeight = std::numeric_limits<long long>::max() / 4;
@@ -85,10 +86,163 @@ bool Graph::load_from_file(const std::string& path, std::string* error_message)
         adjacency_.resize(static_cast<std::size_t>(max_node_id) + 1);
     }
 
+    build_reverse_adjacency();
     return true;
 }
 
+void Graph::build_reverse_adjacency() {
+    std::vector<std::size_t> in_degree(adjacency_.size(), 0);
+    for (const auto& edges : adjacency_) {
+        for (const auto& edge : edges) {
+            in_degree[static_cast<std::size_t>(edge.to)]++;
+        }
+    }
+    reverse_adjacency_.assign(adjacency_.size(), {});
+    for (std::size_t node = 0; node < adjacency_.size(); ++node) {
+        reverse_adjacency_[node].reserve(in_degree[node]);
+    }
+    for (std::size_t from = 0; from < adjacency_.size(); ++from) {
+        for (const auto& edge : adjacency_[from]) {
+            reverse_adjacency_[static_cast<std::size_t>(edge.to)].push_back(
+                GraphEdge{static_cast<int>(from), edge.weight});
+        }
+    }
+}
+
+bool Graph::load_coordinates(const std::string& path, CoordinateSystem system, std::string* error_message) {
+    auto fail = [error_message](const std::string& message) {
+        if (error_message) {
+            *error_message = message;
+        }
+        return false;
+    };
+    if (adjacency_.empty()) {
+        return fail("Load the graph before its coordinates.");
+    }
+    std::ifstream input(path);
+    if (!input) {
+        return fail("Failed to open coordinate file: " + path);
+    }
+
+    constexpr double kDegreesToRadians = 3.14159265358979323846 / 180.0;
+    std::vector<Point> points(adjacency_.size());
+    std::vector<char> seen(adjacency_.size(), 0);
+    std::string line;
+    std::size_t line_number = 0;
+    while (std::getline(input, line)) {
+        ++line_number;
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream iss(line);
+        if (line[0] == 'v') {
+            std::string tag;
+            iss >> tag;
+        }
+        long long id = -1;
+        Point point;
+        if (!(iss >> id >> point.x >> point.y)) {
+            std::ostringstream oss;
+            oss << "Failed to parse coordinate line " << line_number << ": " << line;
+            return fail(oss.str());
+        }
+        if (id < 0 || static_cast<std::size_t>(id) >= points.size()) {
+            std::ostringstream oss;
+            oss << "Coordinate for unknown vertex on line " << line_number;
+            return fail(oss.str());
+        }
+        if (system == CoordinateSystem::kLonLatDegrees) {
+            point.x *= kDegreesToRadians;
+            point.y *= kDegreesToRadians;
+        }
+        points[static_cast<std::size_t>(id)] = point;
+        seen[static_cast<std::size_t>(id)] = 1;
+    }
+    for (std::size_t node = 0; node < seen.size(); ++node) {
+        if (!seen[node]) {
+            std::ostringstream oss;
+            oss << "Coordinate file has no position for vertex " << node;
+            return fail(oss.str());
+        }
+    }
+
+    coordinates_ = std::move(points);
+    coordinate_system_ = system;
+    update_bound_scale();
+    return true;
+}
+
+void Graph::update_bound_scale() {
+    if (coordinates_.empty()) {
+        bound_scale_ = 0.0;
+        return;
+    }
+    // Edge weights are rounded and need not follow the geometry exactly;
+    // scaling by the tightest edge keeps the bound admissible regardless.
+    double scale = std::numeric_limits<double>::infinity();
+    for (std::size_t from = 0; from < adjacency_.size(); ++from) {
+        for (const auto& edge : adjacency_[from]) {
+            const double length =
+                straight_line_distance(coordinates_[from], coordinates_[static_cast<std::size_t>(edge.to)]);
+            if (length > 0.0) {
+                scale = std::min(scale, static_cast<double>(edge.weight) / length);
+            }
+        }
+    }
+    // The slack absorbs floating-point error in the triangle inequality.
+    bound_scale_ = std::isfinite(scale) ? scale * (1.0 - 1e-9) : 0.0;
+}
+
+double Graph::straight_line_distance(const Point& a, const Point& b) const {
+    if (coordinate_system_ == CoordinateSystem::kPlanar) {
+        return std::hypot(a.x - b.x, a.y - b.y);
+    }
+    // Haversine on the mean Earth radius, in meters.
+    constexpr double kEarthRadiusMeters = 6371008.8;
+    const double sin_lat = std::sin((b.y - a.y) / 2.0);
+    const double sin_lon = std::sin((b.x - a.x) / 2.0);
+    const double h = sin_lat * sin_lat + std::cos(a.y) * std::cos(b.y) * sin_lon * sin_lon;
+    return 2.0 * kEarthRadiusMeters * std::asin(std::min(1.0, std::sqrt(h)));
+}
+
+long long Graph::distance_lower_bound(int from, int to) const {
+    if (coordinates_.empty()) {
+        return 0;
+    }
+    const double length = straight_line_distance(coordinates_[static_cast<std::size_t>(from)],
+                                                 coordinates_[static_cast<std::size_t>(to)]);
+    return static_cast<long long>(std::floor(bound_scale_ * length));
+}
+
+Graph Graph::reversed() const {
+    Graph graph;
+    graph.adjacency_ = reverse_adjacency_;
+    graph.reverse_adjacency_ = adjacency_;
+    graph.edge_count_ = edge_count_;
+    graph.coordinates_ = coordinates_;
+    graph.coordinate_system_ = coordinate_system_;
+    graph.bound_scale_ = bound_scale_;
+    return graph;
+}
+
+void Graph::reweight(const std::function<long long(int, const GraphEdge&)>& weight) {
+    for (std::size_t from = 0; from < adjacency_.size(); ++from) {
+        for (auto& edge : adjacency_[from]) {
+            const long long updated = weight(static_cast<int>(from), edge);
+            if (updated < 0 || updated > kMaxWeight) {
+                throw std::invalid_argument("Edge weight out of range");
+            }
+            edge.weight = updated;
+        }
+    }
+    build_reverse_adjacency();
+    update_bound_scale();
+}
+
 void Graph::reset() {
     adjacency_.clear();
+    reverse_adjacency_.clear();
+    coordinates_.clear();
+    bound_scale_ = 0.0;
     edge_count_ = 0;
 }
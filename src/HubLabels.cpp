@@ -0,0 +1,295 @@
+#include "HubLabels.h"
+
+#include "ContractionHierarchy.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define HUB_MERGE_AVX2 1
+#endif
+
+namespace {
+constexpr long long kInfinity = std::numeric_limits<long long>::max() / 4;
+constexpr std::uint32_t kNoPath = 0xFFFFFFFFu;
+constexpr long long kMaxLabelDistance = 0x7FFFFFFF;
+constexpr char kMagic[8] = {'H', 'U', 'B', 'L', 'A', 'B', 'L', '1'};
+
+struct FileHeader {
+    char magic[8];
+    std::uint64_t node_count;
+    std::uint32_t ordering;
+    std::uint32_t reserved;
+    std::uint64_t out_entries;
+    std::uint64_t in_entries;
+};
+
+// Minimum d_a + d_b over hubs present in both sorted labels, or kNoPath.
+std::uint32_t min_common_scalar(const std::uint32_t* a_hubs, const std::uint32_t* a_dist, std::size_t a_count,
+                                const std::uint32_t* b_hubs, const std::uint32_t* b_dist, std::size_t b_count) {
+    std::uint32_t best = kNoPath;
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (i < a_count && j < b_count) {
+        if (a_hubs[i] < b_hubs[j]) {
+            ++i;
+        } else if (b_hubs[j] < a_hubs[i]) {
+            ++j;
+        } else {
+            best = std::min(best, a_dist[i] + b_dist[j]);
+            ++i;
+            ++j;
+        }
+    }
+    return best;
+}
+
+#ifdef HUB_MERGE_AVX2
+// Block merge: compares 8 hubs of a against all 8 of b by rotating b seven
+// times, then advances whichever block ends lower (both on a tie). Distances
+// stay below 2^31, so a sum never reaches kNoPath.
+__attribute__((target("avx2"))) std::uint32_t min_common_avx2(const std::uint32_t* a_hubs,
+                                                               const std::uint32_t* a_dist, std::size_t a_count,
+                                                               const std::uint32_t* b_hubs,
+                                                               const std::uint32_t* b_dist, std::size_t b_count) {
+    const __m256i rotate = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+    const __m256i none = _mm256_set1_epi32(-1);
+    __m256i best = none;
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (i + 8 <= a_count && j + 8 <= b_count) {
+        const __m256i hubs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a_hubs + i));
+        const __m256i dist = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a_dist + i));
+        __m256i other_hubs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b_hubs + j));
+        __m256i other_dist = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b_dist + j));
+        for (int r = 0; r < 8; ++r) {
+            const __m256i equal = _mm256_cmpeq_epi32(hubs, other_hubs);
+            const __m256i sum = _mm256_add_epi32(dist, other_dist);
+            best = _mm256_min_epu32(best, _mm256_or_si256(sum, _mm256_andnot_si256(equal, none)));
+            other_hubs = _mm256_permutevar8x32_epi32(other_hubs, rotate);
+            other_dist = _mm256_permutevar8x32_epi32(other_dist, rotate);
+        }
+        const std::uint32_t a_last = a_hubs[i + 7];
+        const std::uint32_t b_last = b_hubs[j + 7];
+        if (a_last <= b_last) i += 8;
+        if (b_last <= a_last) j += 8;
+    }
+    alignas(32) std::uint32_t lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), best);
+    std::uint32_t result = *std::min_element(lanes, lanes + 8);
+    return std::min(result, min_common_scalar(a_hubs + i, a_dist + i, a_count - i, b_hubs + j, b_dist + j,
+                                              b_count - j));
+}
+
+bool has_avx2() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+#endif
+
+std::uint32_t min_common(const std::uint32_t* a_hubs, const std::uint32_t* a_dist, std::size_t a_count,
+                         const std::uint32_t* b_hubs, const std::uint32_t* b_dist, std::size_t b_count) {
+#ifdef HUB_MERGE_AVX2
+    if (has_avx2()) return min_common_avx2(a_hubs, a_dist, a_count, b_hubs, b_dist, b_count);
+#endif
+    return min_common_scalar(a_hubs, a_dist, a_count, b_hubs, b_dist, b_count);
+}
+
+using Label = std::vector<std::pair<std::uint32_t, std::uint32_t>>; // (hub, distance)
+
+// One pruned Dijkstra from hub `root` (processing index `hub`). A vertex v
+// settled at d is pruned when the labels so far already give d(root, v) <= d
+// (forward; mirrored backward). Otherwise (hub, d) joins v's label.
+class PrunedSearch {
+public:
+    PrunedSearch(std::size_t n, DijkstraQueue& queue)
+        : queue_(queue), distances_(n, kInfinity), root_label_(n, kInfinity) {}
+
+    void run(const Graph& graph, bool backward, int root, std::uint32_t hub, const Label& root_label,
+             std::vector<Label>& labels) {
+        for (const auto& [h, d] : root_label) root_label_[h] = d;
+        queue_.reset(distances_.size());
+        distances_[static_cast<std::size_t>(root)] = 0;
+        touched_.push_back(root);
+        queue_.push_or_decrease(root, 0);
+        while (!queue_.empty()) {
+            auto [dist_u, u] = queue_.extract_min();
+            const auto ui = static_cast<std::size_t>(u);
+            if (dist_u > distances_[ui]) continue;
+            bool covered = false;
+            for (const auto& [h, d] : labels[ui]) {
+                if (root_label_[h] + d <= dist_u) {
+                    covered = true;
+                    break;
+                }
+            }
+            if (covered) continue;
+            if (dist_u > kMaxLabelDistance) {
+                throw std::runtime_error("hub label distance exceeds 31 bits");
+            }
+            labels[ui].emplace_back(hub, static_cast<std::uint32_t>(dist_u));
+            const auto& edges = backward ? graph.reverse_neighbors(u) : graph.neighbors(u);
+            for (const auto& edge : edges) {
+                if (edge.weight >= kInfinity || dist_u > kInfinity - edge.weight) continue;
+                const long long candidate = dist_u + edge.weight;
+                auto& current = distances_[static_cast<std::size_t>(edge.to)];
+                if (candidate < current) {
+                    if (current == kInfinity) touched_.push_back(edge.to);
+                    current = candidate;
+                    queue_.push_or_decrease(edge.to, candidate);
+                }
+            }
+        }
+        for (int v : touched_) distances_[static_cast<std::size_t>(v)] = kInfinity;
+        touched_.clear();
+        for (const auto& entry : root_label) root_label_[entry.first] = kInfinity;
+    }
+
+private:
+    DijkstraQueue& queue_;
+    std::vector<long long> distances_;
+    std::vector<long long> root_label_; // root's opposite label, by hub
+    std::vector<int> touched_;
+};
+
+// Each label becomes its hub ids followed by its distances.
+void flatten(std::vector<Label>& labels, std::vector<std::uint64_t>& offsets, std::vector<std::uint32_t>& words) {
+    offsets.assign(labels.size() + 1, 0);
+    for (std::size_t v = 0; v < labels.size(); ++v) offsets[v + 1] = offsets[v] + labels[v].size();
+    words.assign(2 * offsets.back(), 0);
+    for (std::size_t v = 0; v < labels.size(); ++v) {
+        std::uint32_t* hubs = words.data() + 2 * offsets[v];
+        std::uint32_t* distances = hubs + labels[v].size();
+        for (std::size_t i = 0; i < labels[v].size(); ++i) {
+            hubs[i] = labels[v][i].first;
+            distances[i] = labels[v][i].second;
+        }
+        Label().swap(labels[v]);
+    }
+}
+
+template <typename T>
+void write_array(std::ofstream& output, const std::vector<T>& values) {
+    output.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+}
+
+template <typename T>
+void read_array(std::ifstream& input, std::vector<T>& values, std::size_t count) {
+    values.resize(count);
+    input.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(count * sizeof(T)));
+}
+} // namespace
+
+HubLabels HubLabels::build(const Graph& graph, HubOrdering ordering, DijkstraQueue& queue) {
+    if (graph.empty()) {
+        throw std::invalid_argument("Graph is empty");
+    }
+    const std::size_t n = graph.node_count();
+    std::vector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    if (ordering == HubOrdering::kContraction) {
+        const ContractionHierarchy hierarchy = ContractionHierarchy::build(graph, queue);
+        std::sort(order.begin(), order.end(), [&](int a, int b) { return hierarchy.rank(a) > hierarchy.rank(b); });
+    } else {
+        auto degree = [&graph](int v) { return graph.neighbors(v).size() + graph.reverse_neighbors(v).size(); };
+        std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return degree(a) > degree(b); });
+    }
+
+    std::vector<Label> out_labels(n);
+    std::vector<Label> in_labels(n);
+    PrunedSearch search(n, queue);
+    for (std::size_t i = 0; i < n; ++i) {
+        const int root = order[i];
+        const auto hub = static_cast<std::uint32_t>(i);
+        const auto ri = static_cast<std::size_t>(root);
+        search.run(graph, false, root, hub, out_labels[ri], in_labels);
+        search.run(graph, true, root, hub, in_labels[ri], out_labels);
+    }
+
+    HubLabels labels;
+    labels.ordering_ = ordering;
+    flatten(out_labels, labels.out_offsets_, labels.out_labels_);
+    flatten(in_labels, labels.in_offsets_, labels.in_labels_);
+    return labels;
+}
+
+long long HubLabels::distance(int source, int target) const {
+    const std::size_t n = node_count();
+    if (source < 0 || static_cast<std::size_t>(source) >= n || target < 0 || static_cast<std::size_t>(target) >= n) {
+        throw std::out_of_range("Query vertex out of range");
+    }
+    const auto s = static_cast<std::size_t>(source);
+    const auto t = static_cast<std::size_t>(target);
+    const auto out_count = static_cast<std::size_t>(out_offsets_[s + 1] - out_offsets_[s]);
+    const auto in_count = static_cast<std::size_t>(in_offsets_[t + 1] - in_offsets_[t]);
+    const std::uint32_t* out_hubs = out_labels_.data() + 2 * out_offsets_[s];
+    const std::uint32_t* in_hubs = in_labels_.data() + 2 * in_offsets_[t];
+    const std::uint32_t best =
+        min_common(out_hubs, out_hubs + out_count, out_count, in_hubs, in_hubs + in_count, in_count);
+    return best == kNoPath ? -1 : static_cast<long long>(best);
+}
+
+std::size_t HubLabels::label_bytes() const {
+    return (out_offsets_.size() + in_offsets_.size()) * sizeof(std::uint64_t) +
+           (out_labels_.size() + in_labels_.size()) * sizeof(std::uint32_t);
+}
+
+void HubLabels::save(const std::string& path) const {
+    std::ofstream output(path, std::ios::binary);
+    if (!output) {
+        throw std::runtime_error("Failed to open hub label file for writing: " + path);
+    }
+    FileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.node_count = node_count();
+    header.ordering = static_cast<std::uint32_t>(ordering_);
+    header.out_entries = out_entries();
+    header.in_entries = in_entries();
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    write_array(output, out_offsets_);
+    write_array(output, out_labels_);
+    write_array(output, in_offsets_);
+    write_array(output, in_labels_);
+    if (!output) {
+        throw std::runtime_error("Failed to write hub label file: " + path);
+    }
+}
+
+HubLabels HubLabels::load(const std::string& path, const Graph& graph) {
+    std::ifstream input(path, std::ios::binary);
+    if (!input) {
+        throw std::runtime_error("Failed to open hub label file: " + path);
+    }
+    FileHeader header{};
+    input.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!input || std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error("Not a hub label file: " + path);
+    }
+    if (header.node_count != graph.node_count()) {
+        throw std::runtime_error("Hub label file was built for a graph with a different vertex count: " + path);
+    }
+
+    const auto n = static_cast<std::size_t>(header.node_count);
+    HubLabels labels;
+    labels.ordering_ = static_cast<HubOrdering>(header.ordering);
+    read_array(input, labels.out_offsets_, n + 1);
+    read_array(input, labels.out_labels_, 2 * static_cast<std::size_t>(header.out_entries));
+    read_array(input, labels.in_offsets_, n + 1);
+    read_array(input, labels.in_labels_, 2 * static_cast<std::size_t>(header.in_entries));
+    if (!input) {
+        throw std::runtime_error("Truncated hub label file: " + path);
+    }
+    for (const auto* offsets : {&labels.out_offsets_, &labels.in_offsets_}) {
+        const std::uint64_t entries = offsets == &labels.out_offsets_ ? header.out_entries : header.in_entries;
+        if (offsets->front() != 0 || offsets->back() != entries || !std::is_sorted(offsets->begin(), offsets->end())) {
+            throw std::runtime_error("Corrupt hub label offsets: " + path);
+        }
+    }
+    return labels;
+}
@@ -0,0 +1,4 @@
+#include "IndexedFibonacciHeap.h"
+
+template class IndexedFibonacciHeap<long long, int>;
+template class IndexedFibonacciHeap<std::uint32_t, int>;
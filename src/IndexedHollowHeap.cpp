@@ -0,0 +1,4 @@
+#include "IndexedHollowHeap.h"
+
+template class IndexedHollowHeap<long long, int>;
+template class IndexedHollowHeap<std::uint32_t, int>;
@@ -0,0 +1,309 @@
+#include "Landmarks.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+constexpr long long kInfinity = std::numeric_limits<long long>::max() / 4;
+constexpr char kMagic[8] = {'A', 'L', 'T', 'T', 'A', 'B', 'L', '1'};
+
+struct FileHeader {
+    char magic[8];
+    std::uint64_t node_count;
+    std::uint32_t landmark_count;
+    std::uint32_t selection;
+};
+
+std::uint32_t to_entry(long long distance) {
+    if (distance >= kInfinity) {
+        return LandmarkTable::kUnreachable;
+    }
+    if (distance >= static_cast<long long>(LandmarkTable::kUnreachable)) {
+        throw std::runtime_error("landmark distance exceeds the 32-bit table range");
+    }
+    return static_cast<std::uint32_t>(distance);
+}
+
+// The leaf reached by always stepping into the child subtree of largest
+// size; sizes are zero for subtrees that already hold a landmark.
+int descend_largest(int root, const std::vector<std::size_t>& child_begin, const std::vector<int>& children,
+                    const std::vector<long long>& size) {
+    int node = root;
+    while (true) {
+        int next = -1;
+        long long best = 0;
+        const auto u = static_cast<std::size_t>(node);
+        for (std::size_t i = child_begin[u]; i < child_begin[u + 1]; ++i) {
+            const int child = children[i];
+            if (size[static_cast<std::size_t>(child)] > best) {
+                best = size[static_cast<std::size_t>(child)];
+                next = child;
+            }
+        }
+        if (next < 0) return node;
+        node = next;
+    }
+}
+} // namespace
+
+long long LandmarkTable::bound_via(std::size_t landmark, const std::uint32_t* from, const std::uint32_t* to) const {
+    long long bound = 0;
+    const std::uint32_t from_l = from[landmark];
+    const std::uint32_t to_l = to[landmark];
+    if (from_l != kUnreachable && to_l != kUnreachable) {
+        bound = std::max(bound, static_cast<long long>(to_l) - static_cast<long long>(from_l));
+    }
+    const std::uint32_t l_from = from[stride_ + landmark];
+    const std::uint32_t l_to = to[stride_ + landmark];
+    if (l_from == kUnreachable && l_to != kUnreachable) {
+        // `to` reaches the landmark and `from` does not, so `from` cannot
+        // reach `to` either. A finite bound here would break consistency.
+        return kInfinity;
+    }
+    if (l_from != kUnreachable && l_to != kUnreachable) {
+        bound = std::max(bound, static_cast<long long>(l_from) - static_cast<long long>(l_to));
+    }
+    return bound;
+}
+
+long long LandmarkTable::lower_bound(int from, int to, const std::vector<std::size_t>& subset) const {
+    const std::uint32_t* from_row = row(from);
+    const std::uint32_t* to_row = row(to);
+    long long bound = 0;
+    for (std::size_t landmark : subset) {
+        bound = std::max(bound, bound_via(landmark, from_row, to_row));
+    }
+    return bound;
+}
+
+long long LandmarkTable::lower_bound(int from, int to) const {
+    const std::uint32_t* from_row = row(from);
+    const std::uint32_t* to_row = row(to);
+    long long bound = 0;
+    for (std::size_t landmark = 0; landmark < landmarks_.size(); ++landmark) {
+        bound = std::max(bound, bound_via(landmark, from_row, to_row));
+    }
+    return bound;
+}
+
+std::vector<std::size_t> LandmarkTable::best_landmarks(int source, int target, std::size_t limit) const {
+    const std::uint32_t* source_row = row(source);
+    const std::uint32_t* target_row = row(target);
+    std::vector<std::pair<long long, std::size_t>> ranked;
+    ranked.reserve(landmarks_.size());
+    for (std::size_t landmark = 0; landmark < landmarks_.size(); ++landmark) {
+        ranked.emplace_back(bound_via(landmark, source_row, target_row), landmark);
+    }
+    limit = std::min(limit, ranked.size());
+    std::partial_sort(ranked.begin(), ranked.begin() + static_cast<std::ptrdiff_t>(limit), ranked.end(),
+                      [](const auto& a, const auto& b) { return a.first > b.first; });
+    std::vector<std::size_t> best;
+    best.reserve(limit);
+    for (std::size_t i = 0; i < limit; ++i) {
+        best.push_back(ranked[i].second);
+    }
+    return best;
+}
+
+LandmarkTable LandmarkTable::build(const Graph& graph, std::size_t count, LandmarkSelection selection,
+                                   DijkstraQueue& queue, std::uint32_t seed) {
+    if (graph.empty()) {
+        throw std::invalid_argument("Graph is empty");
+    }
+    const std::size_t n = graph.node_count();
+    count = std::min(count, n);
+
+    LandmarkTable table;
+    table.node_count_ = n;
+    table.stride_ = count;
+    table.selection_ = selection;
+    table.rows_.assign(n * 2 * count, kUnreachable);
+
+    const Graph reverse = graph.reversed();
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> vertex_dist(0, static_cast<int>(n) - 1);
+    std::vector<char> is_landmark(n, 0);
+    // Farthest: distance from the nearest landmark chosen so far.
+    std::vector<long long> nearest(n, kInfinity);
+
+    auto add_landmark = [&](int landmark) {
+        const std::size_t column = table.landmarks_.size();
+        const DijkstraResult forward = run_dijkstra(graph, landmark, queue);
+        const DijkstraResult backward = run_dijkstra(reverse, landmark, queue);
+        for (std::size_t v = 0; v < n; ++v) {
+            std::uint32_t* entries = table.rows_.data() + v * 2 * count;
+            entries[column] = to_entry(forward.distances[v]);
+            entries[count + column] = to_entry(backward.distances[v]);
+            nearest[v] = std::min(nearest[v], forward.distances[v]);
+        }
+        is_landmark[static_cast<std::size_t>(landmark)] = 1;
+        table.landmarks_.push_back(landmark);
+    };
+
+    // The reachable non-landmark vertex maximizing `score`, or -1.
+    auto argmax = [&](const std::vector<long long>& score) {
+        int best = -1;
+        for (std::size_t v = 0; v < n; ++v) {
+            if (is_landmark[v] || score[v] >= kInfinity) continue;
+            if (best < 0 || score[v] > score[static_cast<std::size_t>(best)]) best = static_cast<int>(v);
+        }
+        return best;
+    };
+
+    std::vector<std::size_t> child_begin;
+    std::vector<int> children;
+    std::vector<long long> size(n);
+    std::vector<int> order;
+    while (table.landmarks_.size() < count) {
+        const int root = vertex_dist(rng);
+        const DijkstraResult tree = run_dijkstra(graph, root, queue);
+        int next = -1;
+        if (selection == LandmarkSelection::kFarthest || table.landmarks_.empty()) {
+            // The first landmark is the vertex farthest from a random root.
+            next = argmax(table.landmarks_.empty() ? tree.distances : nearest);
+        } else {
+            // Subtree sizes of (d(root, v) - bound(root, v)), zeroed below
+            // any landmark, accumulated deepest-first into parents.
+            order.clear();
+            for (std::size_t v = 0; v < n; ++v) {
+                if (tree.distances[v] < kInfinity) order.push_back(static_cast<int>(v));
+            }
+            std::sort(order.begin(), order.end(), [&](int a, int b) {
+                return tree.distances[static_cast<std::size_t>(a)] > tree.distances[static_cast<std::size_t>(b)];
+            });
+            std::vector<char> holds_landmark(n, 0);
+            for (int v : order) {
+                const auto u = static_cast<std::size_t>(v);
+                size[u] = tree.distances[u] - table.lower_bound(root, v);
+            }
+            for (int v : order) {
+                const auto u = static_cast<std::size_t>(v);
+                if (is_landmark[u]) holds_landmark[u] = 1;
+                if (holds_landmark[u]) size[u] = 0;
+                const int parent = tree.parents[u];
+                if (parent < 0) continue;
+                const auto p = static_cast<std::size_t>(parent);
+                holds_landmark[p] |= holds_landmark[u];
+                size[p] += size[u];
+            }
+
+            child_begin.assign(n + 1, 0);
+            for (int v : order) {
+                const int parent = tree.parents[static_cast<std::size_t>(v)];
+                if (parent >= 0) child_begin[static_cast<std::size_t>(parent) + 1]++;
+            }
+            for (std::size_t v = 0; v < n; ++v) child_begin[v + 1] += child_begin[v];
+            children.assign(child_begin[n], -1);
+            std::vector<std::size_t> fill(child_begin.begin(), child_begin.end() - 1);
+            for (int v : order) {
+                const int parent = tree.parents[static_cast<std::size_t>(v)];
+                if (parent >= 0) children[fill[static_cast<std::size_t>(parent)]++] = v;
+            }
+
+            // Descend from the vertex with the largest size (the root's own
+            // subtree usually holds a landmark and so scores zero).
+            int start = -1;
+            for (int v : order) {
+                const auto u = static_cast<std::size_t>(v);
+                if (size[u] > 0 && (start < 0 || size[u] > size[static_cast<std::size_t>(start)])) start = v;
+            }
+            if (start >= 0) {
+                next = descend_largest(start, child_begin, children, size);
+            }
+            if (next >= 0 && is_landmark[static_cast<std::size_t>(next)]) next = -1;
+            if (next < 0) next = argmax(nearest);
+        }
+        if (next < 0) {
+            break; // every reachable vertex is already a landmark
+        }
+        add_landmark(next);
+    }
+
+    if (table.landmarks_.size() < count) {
+        // Fewer landmarks than columns: repack the rows to the found count.
+        const std::size_t found = table.landmarks_.size();
+        std::vector<std::uint32_t> packed(n * 2 * found);
+        for (std::size_t v = 0; v < n; ++v) {
+            const std::uint32_t* old_row = table.rows_.data() + v * 2 * count;
+            std::copy(old_row, old_row + found, packed.data() + v * 2 * found);
+            std::copy(old_row + count, old_row + count + found, packed.data() + v * 2 * found + found);
+        }
+        table.rows_ = std::move(packed);
+        table.stride_ = found;
+    }
+    return table;
+}
+
+void LandmarkTable::save(const std::string& path) const {
+    std::ofstream output(path, std::ios::binary);
+    if (!output) {
+        throw std::runtime_error("Failed to open landmark file for writing: " + path);
+    }
+    FileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.node_count = node_count_;
+    header.landmark_count = static_cast<std::uint32_t>(landmarks_.size());
+    header.selection = static_cast<std::uint32_t>(selection_);
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    output.write(reinterpret_cast<const char*>(landmarks_.data()),
+                 static_cast<std::streamsize>(landmarks_.size() * sizeof(int)));
+    output.write(reinterpret_cast<const char*>(rows_.data()),
+                 static_cast<std::streamsize>(rows_.size() * sizeof(std::uint32_t)));
+    if (!output) {
+        throw std::runtime_error("Failed to write landmark file: " + path);
+    }
+}
+
+LandmarkTable LandmarkTable::load(const std::string& path, const Graph& graph) {
+    std::ifstream input(path, std::ios::binary);
+    if (!input) {
+        throw std::runtime_error("Failed to open landmark file: " + path);
+    }
+    FileHeader header{};
+    input.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!input || std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error("Not a landmark file: " + path);
+    }
+    if (header.node_count != graph.node_count()) {
+        throw std::runtime_error("Landmark file was built for a graph with a different vertex count: " + path);
+    }
+
+    LandmarkTable table;
+    table.node_count_ = static_cast<std::size_t>(header.node_count);
+    table.stride_ = header.landmark_count;
+    table.selection_ = static_cast<LandmarkSelection>(header.selection);
+    table.landmarks_.resize(header.landmark_count);
+    table.rows_.resize(table.node_count_ * 2 * table.stride_);
+    input.read(reinterpret_cast<char*>(table.landmarks_.data()),
+               static_cast<std::streamsize>(table.landmarks_.size() * sizeof(int)));
+    input.read(reinterpret_cast<char*>(table.rows_.data()),
+               static_cast<std::streamsize>(table.rows_.size() * sizeof(std::uint32_t)));
+    if (!input) {
+        throw std::runtime_error("Truncated landmark file: " + path);
+    }
+    for (int landmark : table.landmarks_) {
+        if (landmark < 0 || static_cast<std::size_t>(landmark) >= table.node_count_) {
+            throw std::runtime_error("Landmark file names an out-of-range vertex: " + path);
+        }
+    }
+    return table;
+}
+
+PointToPointResult run_alt(const Graph& graph, const LandmarkTable& table, int source, int target,
+                           DijkstraQueue& queue) {
+    if (table.empty()) {
+        throw std::invalid_argument("ALT needs a non-empty landmark table");
+    }
+    if (source < 0 || target < 0 || static_cast<std::size_t>(source) >= graph.node_count() ||
+        static_cast<std::size_t>(target) >= graph.node_count()) {
+        throw std::out_of_range("Query vertex out of range");
+    }
+    const std::vector<std::size_t> active = table.best_landmarks(source, target, kActiveLandmarks);
+    return run_astar(graph, source, target, queue,
+                     [&table, &active, target](int vertex) { return table.lower_bound(vertex, target, active); });
+}
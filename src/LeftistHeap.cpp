@@ -0,0 +1,4 @@
+#include "LeftistHeap.h"
+
+template class LeftistHeap<long long, int>;
+template class LeftistHeap<std::uint32_t, int>;
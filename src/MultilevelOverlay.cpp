@@ -0,0 +1,322 @@
+#include "MultilevelOverlay.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+#include "Partition.h"
+
+namespace {
+constexpr long long kInfinity = std::numeric_limits<long long>::max() / 4;
+} // namespace
+
+MultilevelOverlay MultilevelOverlay::build(const Graph& graph, const std::vector<std::size_t>& cell_sizes,
+                                           std::uint32_t seed) {
+    if (graph.empty()) {
+        throw std::invalid_argument("Graph is empty");
+    }
+    if (cell_sizes.empty()) {
+        throw std::invalid_argument("overlay needs at least one level");
+    }
+    for (std::size_t i = 0; i < cell_sizes.size(); ++i) {
+        if (cell_sizes[i] < 2 || (i > 0 && cell_sizes[i] <= cell_sizes[i - 1])) {
+            throw std::invalid_argument("cell sizes must start at 2 or more and increase level by level");
+        }
+    }
+    const std::size_t n = graph.node_count();
+
+    // Each level partitions the cells of the one below, so cells nest.
+    MultilevelOverlay overlay;
+    UnitAdjacency units = undirected_adjacency(graph);
+    std::vector<int> unit_of(n);
+    for (std::size_t v = 0; v < n; ++v) unit_of[v] = static_cast<int>(v);
+    for (std::size_t level = 0; level < cell_sizes.size(); ++level) {
+        const std::size_t regions = std::clamp<std::size_t>((n + cell_sizes[level] - 1) / cell_sizes[level], 1,
+                                                            units.size());
+        const std::vector<int> part =
+            bfs_grown_partition(units, regions, seed + static_cast<std::uint32_t>(level));
+
+        Level cells;
+        cells.cell.resize(n);
+        for (std::size_t v = 0; v < n; ++v) {
+            cells.cell[v] = part[static_cast<std::size_t>(unit_of[v])];
+            unit_of[v] = cells.cell[v];
+        }
+        UnitAdjacency quotient(regions);
+        for (std::size_t u = 0; u < units.size(); ++u) {
+            const int from = part[u];
+            for (int w : units[u]) {
+                const int to = part[static_cast<std::size_t>(w)];
+                if (to != from) quotient[static_cast<std::size_t>(from)].push_back(to);
+            }
+        }
+        for (auto& neighbors : quotient) {
+            std::sort(neighbors.begin(), neighbors.end());
+            neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+        }
+        units = std::move(quotient);
+
+        // Boundary vertices have an arc into or out of their cell.
+        std::vector<std::size_t> counts(regions + 1, 0);
+        std::vector<char> on_boundary(n, 0);
+        for (std::size_t v = 0; v < n; ++v) {
+            const int c = cells.cell[v];
+            auto crosses = [&](const GraphEdge& edge) { return cells.cell[static_cast<std::size_t>(edge.to)] != c; };
+            const auto& out = graph.neighbors(static_cast<int>(v));
+            const auto& in = graph.reverse_neighbors(static_cast<int>(v));
+            if (std::any_of(out.begin(), out.end(), crosses) || std::any_of(in.begin(), in.end(), crosses)) {
+                on_boundary[v] = 1;
+                counts[static_cast<std::size_t>(c) + 1]++;
+            }
+        }
+        cells.boundary_offsets.assign(regions + 1, 0);
+        cells.clique_offsets.assign(regions + 1, 0);
+        for (std::size_t c = 0; c < regions; ++c) {
+            cells.boundary_offsets[c + 1] = cells.boundary_offsets[c] + counts[c + 1];
+            cells.clique_offsets[c + 1] = cells.clique_offsets[c] + counts[c + 1] * counts[c + 1];
+        }
+        cells.boundary.resize(cells.boundary_offsets[regions]);
+        cells.boundary_index.assign(n, -1);
+        std::vector<std::size_t> fill(cells.boundary_offsets.begin(), cells.boundary_offsets.end() - 1);
+        for (std::size_t v = 0; v < n; ++v) {
+            if (!on_boundary[v]) continue;
+            const auto c = static_cast<std::size_t>(cells.cell[v]);
+            cells.boundary_index[v] = static_cast<int>(fill[c] - cells.boundary_offsets[c]);
+            cells.boundary[fill[c]++] = static_cast<int>(v);
+        }
+        cells.cliques.assign(cells.clique_offsets[regions], kInfinity);
+        overlay.levels_.push_back(std::move(cells));
+    }
+    return overlay;
+}
+
+std::size_t MultilevelOverlay::clique_entries() const {
+    std::size_t entries = 0;
+    for (const auto& level : levels_) entries += level.cliques.size();
+    return entries;
+}
+
+void MultilevelOverlay::customize(const Graph& graph, HeapSelection selection, AllocatorPolicy allocator,
+                                  std::size_t threads) {
+    const std::size_t n = node_count();
+    if (n == 0) {
+        throw std::invalid_argument("Overlay is empty");
+    }
+    if (graph.node_count() != n) {
+        throw std::invalid_argument("graph does not match the overlay");
+    }
+    threads = std::max<std::size_t>(threads, 1);
+
+    std::vector<Worker> workers(threads);
+    for (auto& worker : workers) {
+        worker.queue = make_queue_adapter(selection, allocator, StatsPolicy::kNone);
+        worker.distances.assign(n, kInfinity);
+    }
+    // A level reads the cliques of the one below, so levels are barriers.
+    for (std::size_t level = 0; level < levels_.size(); ++level) {
+        const std::size_t cells = cell_count(level);
+        std::atomic<std::size_t> next{0};
+        auto work = [&](Worker& worker) {
+            for (std::size_t cell = next++; cell < cells; cell = next++) {
+                customize_cell(graph, level, cell, worker);
+            }
+        };
+        std::vector<std::thread> pool;
+        for (std::size_t t = 1; t < threads; ++t) {
+            pool.emplace_back(work, std::ref(workers[t]));
+        }
+        work(workers[0]);
+        for (auto& thread : pool) thread.join();
+    }
+    customized_ = true;
+}
+
+// One search per boundary vertex, confined to the cell: over original arcs
+// on the finest level, otherwise over the cliques of the subcells and the
+// arcs between them.
+void MultilevelOverlay::customize_cell(const Graph& graph, std::size_t level, std::size_t cell, Worker& worker) {
+    Level& cells = levels_[level];
+    const Level* lower = level > 0 ? &levels_[level - 1] : nullptr;
+    const int c = static_cast<int>(cell);
+    const std::size_t first = cells.boundary_offsets[cell];
+    const std::size_t k = cells.boundary_offsets[cell + 1] - first;
+    DijkstraQueue& queue = *worker.queue;
+    auto& distances = worker.distances;
+
+    for (std::size_t i = 0; i < k; ++i) {
+        const int root = cells.boundary[first + i];
+        queue.reset(distances.size());
+        distances[static_cast<std::size_t>(root)] = 0;
+        worker.touched.push_back(root);
+        queue.push_or_decrease(root, 0);
+        auto relax = [&](long long dist_u, int w, long long weight) {
+            if (weight >= kInfinity || dist_u > kInfinity - weight) return;
+            const long long candidate = dist_u + weight;
+            auto& current = distances[static_cast<std::size_t>(w)];
+            if (candidate < current) {
+                if (current == kInfinity) worker.touched.push_back(w);
+                current = candidate;
+                queue.push_or_decrease(w, candidate);
+            }
+        };
+
+        std::size_t remaining = k;
+        while (!queue.empty()) {
+            auto [dist_u, u] = queue.extract_min();
+            const auto ui = static_cast<std::size_t>(u);
+            if (dist_u > distances[ui]) continue;
+            if (cells.boundary_index[ui] >= 0 && --remaining == 0) break;
+            if (!lower) {
+                for (const auto& edge : graph.neighbors(u)) {
+                    if (cells.cell[static_cast<std::size_t>(edge.to)] == c) relax(dist_u, edge.to, edge.weight);
+                }
+                continue;
+            }
+            const int sub = lower->cell[ui];
+            const auto sub_index = static_cast<std::size_t>(sub);
+            const std::size_t sub_first = lower->boundary_offsets[sub_index];
+            const std::size_t sub_k = lower->boundary_offsets[sub_index + 1] - sub_first;
+            const long long* row = lower->cliques.data() + lower->clique_offsets[sub_index] +
+                                   static_cast<std::size_t>(lower->boundary_index[ui]) * sub_k;
+            for (std::size_t j = 0; j < sub_k; ++j) {
+                relax(dist_u, lower->boundary[sub_first + j], row[j]);
+            }
+            for (const auto& edge : graph.neighbors(u)) {
+                const auto to = static_cast<std::size_t>(edge.to);
+                if (lower->cell[to] != sub && cells.cell[to] == c) relax(dist_u, edge.to, edge.weight);
+            }
+        }
+
+        long long* row = cells.cliques.data() + cells.clique_offsets[cell] + i * k;
+        for (std::size_t j = 0; j < k; ++j) {
+            row[j] = distances[static_cast<std::size_t>(cells.boundary[first + j])];
+        }
+        for (int v : worker.touched) distances[static_cast<std::size_t>(v)] = kInfinity;
+        worker.touched.clear();
+    }
+}
+
+PointToPointResult MultilevelOverlay::query(const Graph& graph, int source, int target, DijkstraQueue& queue_fwd,
+                                            DijkstraQueue& queue_bwd) const {
+    const std::size_t n = node_count();
+    if (n == 0 || !customized_) {
+        throw std::invalid_argument("Overlay is not customized");
+    }
+    if (graph.node_count() != n) {
+        throw std::invalid_argument("graph does not match the overlay");
+    }
+    if (source < 0 || static_cast<std::size_t>(source) >= n || target < 0 || static_cast<std::size_t>(target) >= n) {
+        throw std::out_of_range("Query vertex out of range");
+    }
+    if (&queue_fwd == &queue_bwd) {
+        throw std::invalid_argument("bidirectional search needs two distinct queues");
+    }
+    for (auto& side : sides_) {
+        if (side.distances.size() != n) {
+            side.distances.assign(n, kInfinity);
+            side.parents.assign(n, -1);
+        }
+    }
+
+    // A vertex is searched on the highest level whose cell holds neither
+    // endpoint; level 0 means original arcs.
+    const std::size_t levels = levels_.size();
+    auto search_level = [&](int v) {
+        for (std::size_t level = levels; level > 0; --level) {
+            const auto& cell = levels_[level - 1].cell;
+            const int c = cell[static_cast<std::size_t>(v)];
+            if (c != cell[static_cast<std::size_t>(source)] && c != cell[static_cast<std::size_t>(target)]) {
+                return level;
+            }
+        }
+        return std::size_t{0};
+    };
+
+    DijkstraQueue* queues[2] = {&queue_fwd, &queue_bwd};
+    const int roots[2] = {source, target};
+    long long radius[2] = {0, 0};
+    for (int i = 0; i < 2; ++i) {
+        queues[i]->reset(n);
+        sides_[i].distances[static_cast<std::size_t>(roots[i])] = 0;
+        sides_[i].touched.push_back(roots[i]);
+        queues[i]->push_or_decrease(roots[i], 0);
+    }
+
+    PointToPointResult result;
+    long long best = source == target ? 0 : kInfinity;
+    int meet = source == target ? source : -1;
+    while (best > 0) {
+        const int turn = radius[0] <= radius[1] ? 0 : 1;
+        Side& side = sides_[turn];
+        const Side& other = sides_[1 - turn];
+        DijkstraQueue& queue = *queues[turn];
+        if (queue.empty()) break;
+        auto [dist_u, u] = queue.extract_min();
+        const auto ui = static_cast<std::size_t>(u);
+        if (dist_u > side.distances[ui]) continue;
+        radius[turn] = dist_u;
+        if (radius[0] + radius[1] >= best) break;
+        result.settled++;
+
+        auto relax = [&](int w, long long weight) {
+            if (weight >= kInfinity) return;
+            const auto wi = static_cast<std::size_t>(w);
+            auto& current = side.distances[wi];
+            if (dist_u + weight < current) {
+                if (current == kInfinity) side.touched.push_back(w);
+                current = dist_u + weight;
+                side.parents[wi] = u;
+                queue.push_or_decrease(w, current);
+            }
+            if (other.distances[wi] < kInfinity && current + other.distances[wi] < best) {
+                best = current + other.distances[wi];
+                meet = w;
+            }
+        };
+        const std::size_t level = search_level(u);
+        const auto& edges = turn == 0 ? graph.neighbors(u) : graph.reverse_neighbors(u);
+        if (level == 0) {
+            for (const auto& edge : edges) relax(edge.to, edge.weight);
+            continue;
+        }
+        // Clique row forward, column backward, then arcs leaving the cell.
+        const Level& cells = levels_[level - 1];
+        const int c = cells.cell[ui];
+        const auto cell = static_cast<std::size_t>(c);
+        const std::size_t first = cells.boundary_offsets[cell];
+        const std::size_t k = cells.boundary_offsets[cell + 1] - first;
+        const auto index = static_cast<std::size_t>(cells.boundary_index[ui]);
+        const long long* clique = cells.cliques.data() + cells.clique_offsets[cell];
+        for (std::size_t j = 0; j < k; ++j) {
+            if (j == index) continue;
+            relax(cells.boundary[first + j], turn == 0 ? clique[index * k + j] : clique[j * k + index]);
+        }
+        for (const auto& edge : edges) {
+            if (cells.cell[static_cast<std::size_t>(edge.to)] != c) relax(edge.to, edge.weight);
+        }
+    }
+
+    if (best < kInfinity) {
+        result.distance = best;
+        for (int v = meet; v >= 0; v = sides_[0].parents[static_cast<std::size_t>(v)]) {
+            result.path.push_back(v);
+        }
+        std::reverse(result.path.begin(), result.path.end());
+        for (int v = sides_[1].parents[static_cast<std::size_t>(meet)]; v >= 0;
+             v = sides_[1].parents[static_cast<std::size_t>(v)]) {
+            result.path.push_back(v);
+        }
+    }
+
+    for (auto& side : sides_) {
+        for (int v : side.touched) {
+            side.distances[static_cast<std::size_t>(v)] = kInfinity;
+            side.parents[static_cast<std::size_t>(v)] = -1;
+        }
+        side.touched.clear();
+    }
+    return result;
+}
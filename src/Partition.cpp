@@ -0,0 +1,183 @@
+#include "Partition.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+namespace {
+constexpr int kUnassigned = -1;
+
+// Hop distances from every unit in `sources`.
+std::vector<int> hop_distances(const UnitAdjacency& adjacency, const std::vector<int>& sources) {
+    std::vector<int> hops(adjacency.size(), std::numeric_limits<int>::max());
+    std::vector<int> frontier;
+    for (int source : sources) {
+        hops[static_cast<std::size_t>(source)] = 0;
+        frontier.push_back(source);
+    }
+    for (std::size_t head = 0; head < frontier.size(); ++head) {
+        const int u = frontier[head];
+        const int next = hops[static_cast<std::size_t>(u)] + 1;
+        for (int w : adjacency[static_cast<std::size_t>(u)]) {
+            auto& hop = hops[static_cast<std::size_t>(w)];
+            if (hop == std::numeric_limits<int>::max()) {
+                hop = next;
+                frontier.push_back(w);
+            }
+        }
+    }
+    return hops;
+}
+
+// Splits vertices[lo, hi) into `count` regions numbered from `first`.
+void inertial_split(const std::vector<std::pair<double, double>>& points, std::vector<int>& vertices,
+                    std::size_t lo, std::size_t hi, std::size_t first, std::size_t count,
+                    std::vector<int>& region) {
+    if (count == 1 || hi - lo <= 1) {
+        for (std::size_t i = lo; i < hi; ++i) {
+            region[static_cast<std::size_t>(vertices[i])] = static_cast<int>(first);
+        }
+        return;
+    }
+    double mean_x = 0.0;
+    double mean_y = 0.0;
+    for (std::size_t i = lo; i < hi; ++i) {
+        mean_x += points[static_cast<std::size_t>(vertices[i])].first;
+        mean_y += points[static_cast<std::size_t>(vertices[i])].second;
+    }
+    mean_x /= static_cast<double>(hi - lo);
+    mean_y /= static_cast<double>(hi - lo);
+    double xx = 0.0;
+    double xy = 0.0;
+    double yy = 0.0;
+    for (std::size_t i = lo; i < hi; ++i) {
+        const double dx = points[static_cast<std::size_t>(vertices[i])].first - mean_x;
+        const double dy = points[static_cast<std::size_t>(vertices[i])].second - mean_y;
+        xx += dx * dx;
+        xy += dx * dy;
+        yy += dy * dy;
+    }
+    // Principal axis of the 2x2 covariance.
+    const double angle = 0.5 * std::atan2(2.0 * xy, xx - yy);
+    const double axis_x = std::cos(angle);
+    const double axis_y = std::sin(angle);
+    auto projection = [&](int v) {
+        const auto& point = points[static_cast<std::size_t>(v)];
+        return point.first * axis_x + point.second * axis_y;
+    };
+
+    const std::size_t left = count / 2;
+    const std::size_t mid = lo + (hi - lo) * left / count;
+    std::nth_element(vertices.begin() + static_cast<std::ptrdiff_t>(lo),
+                     vertices.begin() + static_cast<std::ptrdiff_t>(mid),
+                     vertices.begin() + static_cast<std::ptrdiff_t>(hi),
+                     [&](int a, int b) { return projection(a) < projection(b); });
+    inertial_split(points, vertices, lo, mid, first, left, region);
+    inertial_split(points, vertices, mid, hi, first + left, count - left, region);
+}
+
+} // namespace
+
+UnitAdjacency undirected_adjacency(const Graph& graph) {
+    UnitAdjacency adjacency(graph.node_count());
+    for (std::size_t v = 0; v < graph.node_count(); ++v) {
+        const int vertex = static_cast<int>(v);
+        for (const auto& edge : graph.neighbors(vertex)) adjacency[v].push_back(edge.to);
+        for (const auto& edge : graph.reverse_neighbors(vertex)) adjacency[v].push_back(edge.to);
+    }
+    return adjacency;
+}
+
+std::vector<int> bfs_grown_partition(const UnitAdjacency& adjacency, std::size_t regions, std::uint32_t seed) {
+    if (regions == 0 || regions > adjacency.size()) {
+        throw std::invalid_argument("partition needs between 1 and node-count regions");
+    }
+    const std::size_t n = adjacency.size();
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> vertex_dist(0, static_cast<int>(n) - 1);
+
+    // Each further seed is the reached vertex most hops from the seeds so
+    // far; other components are absorbed by the smallest regions below.
+    std::vector<int> seeds{vertex_dist(rng)};
+    while (seeds.size() < regions) {
+        const std::vector<int> hops = hop_distances(adjacency, seeds);
+        int farthest = -1;
+        for (std::size_t v = 0; v < n; ++v) {
+            if (hops[v] == std::numeric_limits<int>::max()) continue;
+            if (farthest < 0 || hops[v] > hops[static_cast<std::size_t>(farthest)]) farthest = static_cast<int>(v);
+        }
+        if (hops[static_cast<std::size_t>(farthest)] == 0) {
+            // The component is all seeds; fall back to any free vertex.
+            farthest = static_cast<int>(std::find(hops.begin(), hops.end(), std::numeric_limits<int>::max()) -
+                                        hops.begin());
+        }
+        seeds.push_back(farthest);
+    }
+
+    std::vector<int> region(n, kUnassigned);
+    std::vector<std::vector<int>> frontier(regions);
+    std::vector<std::size_t> head(regions, 0);
+    std::vector<std::size_t> size(regions, 0);
+    auto claim = [&](int vertex, std::size_t r) {
+        region[static_cast<std::size_t>(vertex)] = static_cast<int>(r);
+        frontier[r].push_back(vertex);
+        size[r]++;
+    };
+    for (std::size_t r = 0; r < regions; ++r) claim(seeds[r], r);
+
+    // The smallest region with a frontier grows by one vertex's neighbors.
+    std::size_t assigned = regions;
+    std::size_t scan = 0;
+    while (assigned < n) {
+        std::size_t best = regions;
+        for (std::size_t r = 0; r < regions; ++r) {
+            if (head[r] < frontier[r].size() && (best == regions || size[r] < size[best])) best = r;
+        }
+        if (best == regions) {
+            // Every frontier is exhausted: restart the smallest region in an
+            // unreached component.
+            while (region[scan] != kUnassigned) ++scan;
+            best = static_cast<std::size_t>(std::min_element(size.begin(), size.end()) - size.begin());
+            claim(static_cast<int>(scan), best);
+            ++assigned;
+            continue;
+        }
+        const int u = frontier[best][head[best]++];
+        for (int w : adjacency[static_cast<std::size_t>(u)]) {
+            if (region[static_cast<std::size_t>(w)] == kUnassigned) {
+                claim(w, best);
+                ++assigned;
+            }
+        }
+    }
+    return region;
+}
+
+std::vector<int> inertial_partition(const Graph& graph, std::size_t regions) {
+    if (regions == 0 || regions > graph.node_count()) {
+        throw std::invalid_argument("partition needs between 1 and node-count regions");
+    }
+    if (!graph.has_coordinates()) {
+        throw std::invalid_argument("inertial partition needs vertex coordinates");
+    }
+    const std::size_t n = graph.node_count();
+    std::vector<std::pair<double, double>> points(n);
+    double mean_latitude = 0.0;
+    for (std::size_t v = 0; v < n; ++v) {
+        points[v] = graph.coordinate(static_cast<int>(v));
+        mean_latitude += points[v].second;
+    }
+    // Longitude degrees shrink with latitude; an equirectangular projection
+    // is close enough for a city.
+    if (graph.coordinate_system() == CoordinateSystem::kLonLatDegrees) {
+        const double scale = std::cos(mean_latitude / static_cast<double>(n));
+        for (auto& point : points) point.first *= scale;
+    }
+    std::vector<int> vertices(n);
+    for (std::size_t v = 0; v < n; ++v) vertices[v] = static_cast<int>(v);
+    std::vector<int> region(n, 0);
+    inertial_split(points, vertices, 0, n, 0, regions, region);
+    return region;
+}
@@ -0,0 +1,4 @@
+#include "SkewHeap.h"
+
+template class SkewHeap<long long, int>;
+template class SkewHeap<std::uint32_t, int>;
@@ -0,0 +1,4 @@
+#include "ThinHeap.h"
+
+template class ThinHeap<long long, int>;
+template class ThinHeap<std::uint32_t, int>;
@@ -0,0 +1,4 @@
+#include "TwoThreeHeap.h"
+
+template class TwoThreeHeap<long long, int>;
+template class TwoThreeHeap<std::uint32_t, int>;
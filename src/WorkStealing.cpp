@@ -0,0 +1,117 @@
+#include "WorkStealing.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+// Indices [begin, end) still owed by one worker. The owner takes from
+// begin, thieves cut from end; both hold the lock, which is uncontended
+// unless a steal is under way.
+struct Share {
+    std::mutex mutex;
+    std::size_t begin = 0;
+    std::size_t end = 0;
+};
+} // namespace
+
+void run_work_stealing(std::size_t count, std::size_t threads,
+                       const std::function<void(std::size_t worker, std::size_t index)>& body,
+                       const std::function<void(std::size_t completed)>& progress, unsigned progress_ms) {
+    if (count == 0) {
+        return;
+    }
+    threads = std::clamp<std::size_t>(threads, 1, count);
+
+    std::vector<Share> shares(threads);
+    for (std::size_t t = 0; t < threads; ++t) {
+        shares[t].begin = count * t / threads;
+        shares[t].end = count * (t + 1) / threads;
+    }
+    std::atomic<std::size_t> completed{0};
+    std::atomic<bool> failed{false};
+    std::size_t finished = 0;
+    std::mutex finished_mutex;
+    std::condition_variable all_finished;
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    auto take = [&](std::size_t t, std::size_t& index) {
+        std::lock_guard<std::mutex> lock(shares[t].mutex);
+        if (shares[t].begin == shares[t].end) return false;
+        index = shares[t].begin++;
+        return true;
+    };
+    // Moves the back half of the fullest other share to worker t.
+    auto steal = [&](std::size_t t) {
+        while (true) {
+            std::size_t victim = threads;
+            std::size_t most = 0;
+            for (std::size_t v = 0; v < threads; ++v) {
+                if (v == t) continue;
+                std::lock_guard<std::mutex> lock(shares[v].mutex);
+                const std::size_t left = shares[v].end - shares[v].begin;
+                if (left > most) {
+                    most = left;
+                    victim = v;
+                }
+            }
+            if (victim == threads) return false;
+            std::scoped_lock lock(shares[t].mutex, shares[victim].mutex);
+            Share& from = shares[victim];
+            const std::size_t left = from.end - from.begin;
+            if (left == 0) continue; // drained meanwhile; look again
+            const std::size_t mid = from.begin + left / 2;
+            shares[t].begin = mid;
+            shares[t].end = from.end;
+            from.end = mid;
+            return true;
+        }
+    };
+
+    auto work = [&](std::size_t t) {
+        try {
+            std::size_t index = 0;
+            while (!failed.load(std::memory_order_relaxed)) {
+                if (!take(t, index)) {
+                    if (!steal(t)) break;
+                    continue;
+                }
+                body(t, index);
+                completed.fetch_add(1, std::memory_order_relaxed);
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) error = std::current_exception();
+            failed = true;
+        }
+        std::lock_guard<std::mutex> lock(finished_mutex);
+        if (++finished == threads) all_finished.notify_one();
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads);
+    for (std::size_t t = 0; t < threads; ++t) {
+        pool.emplace_back(work, t);
+    }
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(finished_mutex);
+            if (all_finished.wait_for(lock, std::chrono::milliseconds(progress_ms),
+                                      [&] { return finished == threads; })) {
+                break;
+            }
+        }
+        if (progress) progress(completed.load(std::memory_order_relaxed));
+    }
+    for (auto& thread : pool) thread.join();
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    if (progress) progress(completed.load());
+}
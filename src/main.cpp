@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cctype>
 #include <cstdint>
@@ -7,23 +8,45 @@
 #include <iomanip>
 #include <iostream>
 #include <limits>
+#include <memory>
 #include <sstream>
 #include <system_error>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 #include <random>
 
+#include "ArcFlags.h"
+#include "BatchedSearch.h"
+#include "BHeap.h"
+#include "BoundedSearch.h"
 #include "BinaryHeap.h"
+#include "ContractionHierarchy.h"
+#include "DeltaStepping.h"
 #include "Dijkstra.h"
 #include "FibonacciHeap.h"
+#include "FlatSpillHeap.h"
 #include "Graph.h"
 #include "HollowHeap.h"
+#include "HubLabels.h"
+#include "IndexedFibonacciHeap.h"
+#include "IndexedHollowHeap.h"
+#include "LatencyHistogram.h"
+#include "Landmarks.h"
+#include "LeftistHeap.h"
+#include "MultilevelOverlay.h"
+#include "PerfCounters.hpp"
+#include "SkewHeap.h"
+#include "ThinHeap.h"
+#include "TwoThreeHeap.h"
+#include "WorkStealing.h"
 
 namespace {
 struct DatasetOption {
     std::string name;
     std::string path;
+    std::string coordinates_path; // optional lon/lat per vertex, enables A*
 };
 
 constexpr long long kInfinity = std::numeric_limits<long long>::max() / 4;
@@ -107,28 +130,112 @@ std::string heap_name(HeapSelection selection) {
         case HeapSelection::kBinary: return "Binary";
         case HeapSelection::kFibonacci: return "Fibonacci";
         case HeapSelection::kHollow: return "Hollow";
+        case HeapSelection::kFibonacciIndexed: return "Fib-Idx";
+        case HeapSelection::kHollowIndexed: return "Hollow-Idx";
+        case HeapSelection::kAdaptive: return "Adaptive";
+        case HeapSelection::kFlat: return "Flat";
+        case HeapSelection::kBHeap: return "B-Heap";
+        case HeapSelection::kThin: return "Thin";
+        case HeapSelection::kTwoThree: return "2-3";
+        case HeapSelection::kFibonacciBounded: return "Fib-Bounded";
+        case HeapSelection::kLeftist: return "Leftist";
+        case HeapSelection::kSkew: return "Skew";
+        case HeapSelection::kStdPriorityQueue: return "std::pq";
         default: return "Unknown";
     }
 }
 
+const std::vector<HeapSelection>& all_heap_selections() {
+    static const std::vector<HeapSelection> selections = {
+        HeapSelection::kBinary,
+        HeapSelection::kFibonacci,
+        HeapSelection::kHollow,
+        HeapSelection::kFibonacciIndexed,
+        HeapSelection::kHollowIndexed,
+        HeapSelection::kAdaptive,
+        HeapSelection::kFlat,
+        HeapSelection::kBHeap,
+        HeapSelection::kThin,
+        HeapSelection::kTwoThree,
+        HeapSelection::kFibonacciBounded,
+        HeapSelection::kLeftist,
+        HeapSelection::kSkew,
+        HeapSelection::kStdPriorityQueue,
+    };
+    return selections;
+}
+
+HeapSelection prompt_heap_selection() {
+    std::cout << "Select heap implementation:" << std::endl;
+    for (HeapSelection selection : all_heap_selections()) {
+        std::cout << "  [" << static_cast<int>(selection) << "] " << heap_name(selection) << " Heap" << std::endl;
+    }
+    int heap_choice = read_int_with_default("Choice [default: 3]: ", 3);
+    const auto& selections = all_heap_selections();
+    auto match = std::find_if(selections.begin(), selections.end(),
+                              [heap_choice](HeapSelection s) { return static_cast<int>(s) == heap_choice; });
+    if (match == selections.end()) {
+        std::cout << "Invalid selection. Using Hollow Heap." << std::endl;
+        return HeapSelection::kHollow;
+    }
+    return *match;
+}
+
+std::string format_misses_per_op(long long misses, const QueueMetrics& metrics) {
+    const std::size_t ops = metrics.insert_count + metrics.decrease_count + metrics.extract_count;
+    if (misses < 0 || ops == 0) {
+        return "n/a";
+    }
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(3) << static_cast<double>(misses) / static_cast<double>(ops);
+    return oss.str();
+}
+
+std::string allocator_name(AllocatorPolicy policy) {
+    switch (policy) {
+        case AllocatorPolicy::kNewDelete: return "new/delete";
+        case AllocatorPolicy::kPool: return "pool";
+        case AllocatorPolicy::kArena: return "arena";
+        case AllocatorPolicy::kHugePageArena: return "hugepage";
+        default: return "unknown";
+    }
+}
+
 struct RunSummary {
     HeapSelection heap;
+    AllocatorPolicy allocator = AllocatorPolicy::kNewDelete;
     long long elapsed_ms = 0;
+    long long elapsed_ns = 0; // same time, for sums over many short runs
     std::size_t reachable_nodes = 0;
     int farthest_node = -1;
     long long farthest_distance = 0;
+    long long cache_misses = -1; // LLC misses over the whole run, -1 if unavailable
     QueueMetrics metrics;
     HeapStructureStats structure;
+    AllocationStats allocation;
 };
 
 struct WorkloadStats {
     HeapSelection heap;
+    AllocatorPolicy allocator = AllocatorPolicy::kNewDelete;
     std::size_t operations = 0;
+    std::size_t node_bytes = 0; // sizeof the heap's per-element node type(s)
     QueueMetrics metrics;
     long long total_runtime_ms = 0;
+    long long cache_misses = -1; // LLC misses over the whole run, -1 if unavailable
     HeapStructureStats structure;
+    AllocationStats allocation;
+};
+
+enum class WorkloadKeyType {
+    kInt64 = 1,
+    kUInt32 = 2
 };
 
+std::string key_type_name(WorkloadKeyType key_type) {
+    return key_type == WorkloadKeyType::kUInt32 ? "uint32" : "int64";
+}
+
 struct WorkloadMix {
     int insert_pct = 40;
     int decrease_pct = 35;
@@ -142,15 +249,100 @@ struct WorkloadMix {
     }
 };
 
+// Meld-heavy workload: many small heaps paired off and melded round by round
+// until one is left, with a little insert/extract traffic after each meld.
+struct MeldWorkloadStats {
+    HeapSelection heap;
+    AllocatorPolicy allocator = AllocatorPolicy::kNewDelete;
+    std::size_t heap_count = 0;
+    std::size_t heap_size = 0;
+    std::size_t melds = 0;
+    long long meld_time_ns = 0;
+    LatencyHistogram meld_latency;
+    QueueMetrics metrics;
+    long long total_runtime_ms = 0;
+};
+
 struct AggregateStats {
     HeapSelection heap;
+    AllocatorPolicy allocator = AllocatorPolicy::kNewDelete;
     std::size_t runs = 0;
-    long long total_runtime_ms = 0;
-    long long max_runtime_ms = 0;
+    long long total_runtime_ns = 0;
+    long long max_runtime_ns = 0;
     std::size_t total_reachable = 0;
     std::size_t max_reachable = 0;
     QueueMetrics total_metrics;
     HeapStructureStats structure;
+    AllocationStats allocation;
+};
+
+// The same sources searched with decrease-key and with lazy insertion.
+struct LazyComparison {
+    HeapSelection heap;
+    AggregateStats eager;
+    AggregateStats lazy;
+};
+
+// Point-to-point query method run over a fixed set of s-t pairs.
+struct QueryStats {
+    HeapSelection heap;
+    std::string method;
+    std::size_t queries = 0;
+    std::size_t settled_total = 0;
+    long long total_ns = 0;
+    LatencyHistogram latency;
+};
+
+// Contraction hierarchy preprocessing with one heap behind the witness
+// searches.
+struct HierarchyStats {
+    HeapSelection heap;
+    long long prep_ms = 0;
+    std::size_t shortcuts = 0;
+    std::size_t upward_arcs = 0;
+    std::size_t witness_searches = 0;
+};
+
+// Overlay customization with one heap behind the cell searches: on the
+// loaded weights, then again after every weight is replaced.
+struct CustomizationStats {
+    HeapSelection heap;
+    double customize_ms = 0.0;
+    double reload_ms = 0.0;
+    double recustomize_ms = 0.0;
+};
+
+// One stopping rule run from a fixed source set; Touched counts labelled
+// vertices, the work a bounded search clears afterwards.
+struct BoundedStats {
+    HeapSelection heap;
+    std::string method;
+    std::size_t queries = 0;
+    std::size_t settled_total = 0;
+    std::size_t touched_total = 0;
+    long long total_ns = 0;
+    LatencyHistogram latency;
+};
+
+// Nearest-source assignment for one source count: one run per source
+// merged by minimum against a single multi-source run.
+struct MultiSourceStats {
+    std::size_t sources = 0;
+    long long per_source_ns = 0;
+    long long multi_source_ns = 0;
+    std::size_t largest_cell = 0;
+    std::size_t unreached = 0;
+};
+
+// Delta-stepping over a fixed source set with one thread count.
+struct DeltaSteppingStats {
+    std::size_t threads = 0;
+    std::size_t runs = 0;
+    long long total_ns = 0;
+    std::size_t buckets = 0;
+    std::size_t light_rounds = 0;
+    std::size_t removals = 0; // bucket removals of live entries
+    std::size_t reached = 0;
 };
 
 void accumulate_structure_stats(HeapStructureStats& dest, const HeapStructureStats& src) {
@@ -169,16 +361,44 @@ void accumulate_metrics(QueueMetrics& dest, const QueueMetrics& src) {
     dest.insert_time_ns += src.insert_time_ns;
     dest.decrease_time_ns += src.decrease_time_ns;
     dest.extract_time_ns += src.extract_time_ns;
+    dest.reset_time_ns += src.reset_time_ns;
+    dest.migration_count += src.migration_count;
+    dest.migration_time_ns += src.migration_time_ns;
+    dest.stale_extract_count += src.stale_extract_count;
+    dest.peak_stale_entries = std::max(dest.peak_stale_entries, src.peak_stale_entries);
+    dest.insert_latency.merge(src.insert_latency);
+    dest.decrease_latency.merge(src.decrease_latency);
+    dest.extract_latency.merge(src.extract_latency);
+}
+
+void accumulate_allocation_stats(AllocationStats& dest, const AllocationStats& src) {
+    dest.allocations += src.allocations;
+    dest.deallocations += src.deallocations;
+    dest.system_allocations += src.system_allocations;
+    dest.max_reserved_bytes = std::max(dest.max_reserved_bytes, src.max_reserved_bytes);
 }
 
 void accumulate_aggregate(AggregateStats& agg, const RunSummary& summary) {
     agg.runs++;
-    agg.total_runtime_ms += summary.elapsed_ms;
-    agg.max_runtime_ms = std::max(agg.max_runtime_ms, summary.elapsed_ms);
+    agg.total_runtime_ns += summary.elapsed_ns;
+    agg.max_runtime_ns = std::max(agg.max_runtime_ns, summary.elapsed_ns);
     agg.total_reachable += summary.reachable_nodes;
     agg.max_reachable = std::max(agg.max_reachable, summary.reachable_nodes);
     accumulate_metrics(agg.total_metrics, summary.metrics);
     accumulate_structure_stats(agg.structure, summary.structure);
+    accumulate_allocation_stats(agg.allocation, summary.allocation);
+}
+
+// Folds one worker's partial aggregate into the total.
+void merge_aggregate(AggregateStats& dest, const AggregateStats& src) {
+    dest.runs += src.runs;
+    dest.total_runtime_ns += src.total_runtime_ns;
+    dest.max_runtime_ns = std::max(dest.max_runtime_ns, src.max_runtime_ns);
+    dest.total_reachable += src.total_reachable;
+    dest.max_reachable = std::max(dest.max_reachable, src.max_reachable);
+    accumulate_metrics(dest.total_metrics, src.total_metrics);
+    accumulate_structure_stats(dest.structure, src.structure);
+    accumulate_allocation_stats(dest.allocation, src.allocation);
 }
 
 std::string format_all_sources_table(const std::vector<AggregateStats>& aggregates,
@@ -198,46 +418,286 @@ std::string format_all_sources_table(const std::vector<AggregateStats>& aggregat
         << std::setw(16) << "AvgReachable"
         << std::setw(18) << "Insert Avg (us)"
         << std::setw(18) << "Extract Avg (us)"
-        << std::setw(18) << "Decrease Avg (us)" << '\n';
-    oss << std::string(150, '-') << '\n';
+        << std::setw(18) << "Decrease Avg (us)"
+        << std::setw(16) << "Reset Avg (us)" << '\n';
+    oss << std::string(166, '-') << '\n';
     oss << std::fixed << std::setprecision(3);
     for (const auto& agg : aggregates) {
         if (agg.runs == 0) {
             continue;
         }
-        double avg_runtime_ms = static_cast<double>(agg.total_runtime_ms) / static_cast<double>(agg.runs);
-        double total_runtime_s = static_cast<double>(agg.total_runtime_ms) / 1000.0;
+        double avg_runtime_ms = static_cast<double>(agg.total_runtime_ns) / 1e6 / static_cast<double>(agg.runs);
+        double max_runtime_ms = static_cast<double>(agg.max_runtime_ns) / 1e6;
+        double total_runtime_s = static_cast<double>(agg.total_runtime_ns) / 1e9;
         double avg_reachable = static_cast<double>(agg.total_reachable) / static_cast<double>(agg.runs);
         double insert_avg = average_us(agg.total_metrics.insert_time_ns, agg.total_metrics.insert_count);
         double extract_avg = average_us(agg.total_metrics.extract_time_ns, agg.total_metrics.extract_count);
         double decrease_avg = average_us(agg.total_metrics.decrease_time_ns, agg.total_metrics.decrease_count);
+        double reset_avg = average_us(agg.total_metrics.reset_time_ns, agg.runs);
         oss << std::left << std::setw(12) << heap_name(agg.heap) << std::right
             << std::setw(12) << agg.runs
             << std::setw(16) << avg_runtime_ms
-            << std::setw(16) << agg.max_runtime_ms
+            << std::setw(16) << max_runtime_ms
             << std::setw(16) << total_runtime_s
             << std::setw(16) << avg_reachable
             << std::setw(18) << insert_avg
             << std::setw(18) << extract_avg
             << std::setw(18) << decrease_avg
+            << std::setw(16) << reset_avg
             << '\n';
     }
     oss.unsetf(std::ios::floatfield);
     return oss.str();
 }
 
-RunSummary execute_run(const Graph& graph, int source, HeapSelection selection, DijkstraResult* out_result) {
-    auto queue = make_queue_adapter(selection);
-    auto start = std::chrono::steady_clock::now();
-    DijkstraResult result = run_dijkstra(graph, source, *queue);
-    auto finish = std::chrono::steady_clock::now();
+// Speedup is against the first row of the same heap, its plain Dijkstra.
+std::string format_query_table(const std::vector<QueryStats>& rows, const std::string& dataset_name,
+                               std::size_t pair_count) {
+    if (rows.empty()) {
+        return {};
+    }
 
-    RunSummary summary;
-    summary.heap = selection;
-    summary.elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(finish - start).count();
+    auto us = [](std::uint64_t ns) { return static_cast<double>(ns) / 1000.0; };
+    std::ostringstream oss;
+    oss << "=== Point-to-Point Queries for " << dataset_name << " (" << pair_count << " random s-t pairs) ===\n";
+    oss << std::left << std::setw(12) << "Heap" << std::setw(16) << "Method" << std::right
+        << std::setw(14) << "AvgSettled"
+        << std::setw(10) << "Settled%"
+        << std::setw(14) << "Avg (us)"
+        << std::setw(14) << "p50 (us)"
+        << std::setw(14) << "p99 (us)"
+        << std::setw(14) << "Max (us)"
+        << std::setw(10) << "Speedup" << '\n';
+    oss << std::string(118, '-') << '\n';
+    oss << std::fixed << std::setprecision(3);
+    const QueryStats* baseline = nullptr;
+    for (const auto& row : rows) {
+        if (!baseline || baseline->heap != row.heap) {
+            baseline = &row;
+        }
+        const double queries = static_cast<double>(std::max<std::size_t>(row.queries, 1));
+        const double speedup =
+            row.total_ns > 0 ? static_cast<double>(baseline->total_ns) / static_cast<double>(row.total_ns) : 0.0;
+        const double settled_pct = baseline->settled_total > 0 ? 100.0 * static_cast<double>(row.settled_total) /
+                                                                   static_cast<double>(baseline->settled_total)
+                                                             : 0.0;
+        oss << std::left << std::setw(12) << heap_name(row.heap) << std::setw(16) << row.method << std::right
+            << std::setw(14) << static_cast<double>(row.settled_total) / queries
+            << std::setw(10) << std::setprecision(1) << settled_pct << std::setprecision(3)
+            << std::setw(14) << average_us(row.total_ns, row.queries)
+            << std::setw(14) << us(row.latency.percentile_ns(0.50))
+            << std::setw(14) << us(row.latency.percentile_ns(0.99))
+            << std::setw(14) << us(row.latency.max_ns())
+            << std::setw(10) << speedup << '\n';
+    }
+    oss.unsetf(std::ios::floatfield);
+    return oss.str();
+}
+
+std::string format_hierarchy_table(const std::vector<HierarchyStats>& rows, std::size_t edge_count) {
+    if (rows.empty()) {
+        return {};
+    }
+
+    std::ostringstream oss;
+    oss << "=== Contraction Hierarchy Preprocessing (" << edge_count << " input edges) ===\n";
+    oss << std::left << std::setw(12) << "Heap" << std::right
+        << std::setw(14) << "Prep(ms)"
+        << std::setw(14) << "Shortcuts"
+        << std::setw(14) << "UpwardArcs"
+        << std::setw(18) << "WitnessSearches" << '\n';
+    oss << std::string(72, '-') << '\n';
+    for (const auto& row : rows) {
+        oss << std::left << std::setw(12) << heap_name(row.heap) << std::right
+            << std::setw(14) << row.prep_ms
+            << std::setw(14) << row.shortcuts
+            << std::setw(14) << row.upward_arcs
+            << std::setw(18) << row.witness_searches << '\n';
+    }
+    return oss.str();
+}
+
+std::string format_customization_table(const std::vector<CustomizationStats>& rows, std::size_t threads) {
+    if (rows.empty()) {
+        return {};
+    }
+
+    std::ostringstream oss;
+    oss << "=== CRP Customization (" << threads << (threads == 1 ? " thread" : " threads") << ") ===\n";
+    oss << std::left << std::setw(12) << "Heap" << std::right
+        << std::setw(16) << "Customize(ms)"
+        << std::setw(16) << "Reload(ms)"
+        << std::setw(18) << "Recustomize(ms)" << '\n';
+    oss << std::string(62, '-') << '\n';
+    oss << std::fixed << std::setprecision(3);
+    for (const auto& row : rows) {
+        oss << std::left << std::setw(12) << heap_name(row.heap) << std::right
+            << std::setw(16) << row.customize_ms
+            << std::setw(16) << row.reload_ms
+            << std::setw(18) << row.recustomize_ms << '\n';
+    }
+    oss.unsetf(std::ios::floatfield);
+    return oss.str();
+}
+
+// Speedup is against the first row of the same heap, its full search.
+std::string format_bounded_table(const std::vector<BoundedStats>& rows, const std::string& dataset_name,
+                                 std::size_t query_count) {
+    if (rows.empty()) {
+        return {};
+    }
+
+    auto us = [](std::uint64_t ns) { return static_cast<double>(ns) / 1000.0; };
+    std::ostringstream oss;
+    oss << "=== Bounded Searches for " << dataset_name << " (" << query_count << " random sources) ===\n";
+    oss << std::left << std::setw(12) << "Heap" << std::setw(14) << "Method" << std::right
+        << std::setw(14) << "AvgSettled"
+        << std::setw(14) << "AvgTouched"
+        << std::setw(14) << "Avg (us)"
+        << std::setw(14) << "p50 (us)"
+        << std::setw(14) << "p99 (us)"
+        << std::setw(10) << "Speedup" << '\n';
+    oss << std::string(106, '-') << '\n';
+    oss << std::fixed << std::setprecision(3);
+    const BoundedStats* baseline = nullptr;
+    for (const auto& row : rows) {
+        if (!baseline || baseline->heap != row.heap) {
+            baseline = &row;
+        }
+        const double queries = static_cast<double>(std::max<std::size_t>(row.queries, 1));
+        const double speedup =
+            row.total_ns > 0 ? static_cast<double>(baseline->total_ns) / static_cast<double>(row.total_ns) : 0.0;
+        oss << std::left << std::setw(12) << heap_name(row.heap) << std::setw(14) << row.method << std::right
+            << std::setw(14) << static_cast<double>(row.settled_total) / queries
+            << std::setw(14) << static_cast<double>(row.touched_total) / queries
+            << std::setw(14) << average_us(row.total_ns, row.queries)
+            << std::setw(14) << us(row.latency.percentile_ns(0.50))
+            << std::setw(14) << us(row.latency.percentile_ns(0.99))
+            << std::setw(10) << speedup << '\n';
+    }
+    oss.unsetf(std::ios::floatfield);
+    return oss.str();
+}
+
+std::string format_multi_source_table(const std::vector<MultiSourceStats>& rows, const std::string& dataset_name,
+                                     HeapSelection selection) {
+    if (rows.empty()) {
+        return {};
+    }
+
+    std::ostringstream oss;
+    oss << "=== Multi-Source Dijkstra for " << dataset_name << " (" << heap_name(selection) << ") ===\n";
+    oss << std::right << std::setw(10) << "Sources"
+        << std::setw(18) << "PerSource(ms)"
+        << std::setw(18) << "MultiSource(ms)"
+        << std::setw(12) << "Speedup"
+        << std::setw(14) << "LargestCell"
+        << std::setw(12) << "Unreached" << '\n';
+    oss << std::string(84, '-') << '\n';
+    oss << std::fixed << std::setprecision(3);
+    for (const auto& row : rows) {
+        oss << std::setw(10) << row.sources
+            << std::setw(18) << static_cast<double>(row.per_source_ns) / 1e6
+            << std::setw(18) << static_cast<double>(row.multi_source_ns) / 1e6
+            << std::setw(12)
+            << (row.multi_source_ns > 0
+                    ? static_cast<double>(row.per_source_ns) / static_cast<double>(row.multi_source_ns)
+                    : 0.0)
+            << std::setw(14) << row.largest_cell
+            << std::setw(12) << row.unreached << '\n';
+    }
+    oss.unsetf(std::ios::floatfield);
+    return oss.str();
+}
+
+// Speedup is against the Dijkstra baseline, scaling against one thread.
+std::string format_delta_stepping_table(const std::vector<DeltaSteppingStats>& rows, long long baseline_ns,
+                                        const std::string& dataset_name, std::size_t source_count, long long delta,
+                                        double light_fraction) {
+    if (rows.empty()) {
+        return {};
+    }
+
+    auto per_run = [](double total, std::size_t runs) { return runs == 0 ? 0.0 : total / static_cast<double>(runs); };
+    std::ostringstream oss;
+    oss << "=== Delta-Stepping for " << dataset_name << " (" << source_count << " sources, delta " << delta << ", "
+        << std::fixed << std::setprecision(1) << 100.0 * light_fraction << "% light edges) ===\n";
+    oss << std::right << std::setw(10) << "Threads"
+        << std::setw(14) << "Avg (ms)"
+        << std::setw(12) << "Speedup"
+        << std::setw(12) << "Scaling"
+        << std::setw(12) << "Buckets"
+        << std::setw(14) << "LightRounds"
+        << std::setw(14) << "Resettled%" << '\n';
+    oss << std::string(88, '-') << '\n';
+    oss << std::setprecision(3);
+    const double dijkstra_ms = per_run(static_cast<double>(baseline_ns) / 1e6, source_count);
+    oss << std::setw(10) << "Dijkstra" << std::setw(14) << dijkstra_ms << std::setw(12) << 1.0 << '\n';
+    const double single_ns = static_cast<double>(rows.front().total_ns);
+    for (const auto& row : rows) {
+        const double total_ns = static_cast<double>(std::max<long long>(row.total_ns, 1));
+        const double reinserts =
+            row.reached == 0 ? 0.0
+                             : 100.0 * (static_cast<double>(row.removals) - static_cast<double>(row.reached)) /
+                                   static_cast<double>(row.reached);
+        oss << std::setw(10) << row.threads
+            << std::setw(14) << per_run(static_cast<double>(row.total_ns) / 1e6, row.runs)
+            << std::setw(12) << static_cast<double>(baseline_ns) / total_ns
+            << std::setw(12) << single_ns / total_ns
+            << std::setw(12) << per_run(static_cast<double>(row.buckets), row.runs)
+            << std::setw(14) << per_run(static_cast<double>(row.light_rounds), row.runs)
+            << std::setw(14) << std::setprecision(1) << reinserts << std::setprecision(3) << '\n';
+    }
+    oss.unsetf(std::ios::floatfield);
+    return oss.str();
+}
+
+using SearchFunction = DijkstraResult (*)(const Graph&, int, DijkstraQueue&);
+
+std::string format_lazy_table(const std::vector<LazyComparison>& rows, const std::string& dataset_name,
+                              std::size_t source_count) {
+    if (rows.empty()) {
+        return {};
+    }
+
+    auto per_run = [](double total, std::size_t runs) { return runs == 0 ? 0.0 : total / static_cast<double>(runs); };
+    std::ostringstream oss;
+    oss << "=== Lazy Insertion vs Decrease-Key for " << dataset_name << " (" << source_count << " sources) ===\n";
+    oss << std::left << std::setw(12) << "Heap" << std::right
+        << std::setw(14) << "Eager(ms)"
+        << std::setw(14) << "Lazy(ms)"
+        << std::setw(14) << "Decr/run"
+        << std::setw(14) << "Ins/run"
+        << std::setw(16) << "Wasted/run"
+        << std::setw(14) << "PeakStale"
+        << std::setw(20) << "Eager Ext Avg (us)"
+        << std::setw(20) << "Lazy Ext Avg (us)" << '\n';
+    oss << std::string(138, '-') << '\n';
+    oss << std::fixed << std::setprecision(3);
+    for (const auto& row : rows) {
+        const QueueMetrics& eager = row.eager.total_metrics;
+        const QueueMetrics& lazy = row.lazy.total_metrics;
+        oss << std::left << std::setw(12) << heap_name(row.heap) << std::right
+            << std::setw(14) << per_run(static_cast<double>(row.eager.total_runtime_ns) / 1e6, row.eager.runs)
+            << std::setw(14) << per_run(static_cast<double>(row.lazy.total_runtime_ns) / 1e6, row.lazy.runs)
+            << std::setw(14) << per_run(static_cast<double>(eager.decrease_count), row.eager.runs)
+            << std::setw(14) << per_run(static_cast<double>(lazy.insert_count), row.lazy.runs)
+            << std::setw(16) << per_run(static_cast<double>(lazy.stale_extract_count), row.lazy.runs)
+            << std::setw(14) << lazy.peak_stale_entries
+            << std::setw(20) << average_us(eager.extract_time_ns, eager.extract_count)
+            << std::setw(20) << average_us(lazy.extract_time_ns, lazy.extract_count)
+            << '\n';
+    }
+    oss.unsetf(std::ios::floatfield);
+    return oss.str();
+}
+
+// Runs on a caller-owned queue so repeated runs reuse its storage.
+// Fills the summary fields that depend only on the finished search.
+void summarize_result(const DijkstraResult& result, RunSummary& summary) {
     summary.metrics = result.metrics;
     summary.structure = result.structure;
-
+    summary.allocation = result.allocation;
     for (std::size_t node = 0; node < result.distances.size(); ++node) {
         long long dist = result.distances[node];
         if (dist >= kInfinity) {
@@ -249,6 +709,24 @@ RunSummary execute_run(const Graph& graph, int source, HeapSelection selection,
             summary.farthest_node = static_cast<int>(node);
         }
     }
+}
+
+RunSummary execute_run(const Graph& graph, int source, DijkstraQueue& queue, HeapSelection selection,
+                       AllocatorPolicy allocator, DijkstraResult* out_result, SearchFunction search = run_dijkstra) {
+    CacheMissCounter cache_counter;
+    auto start = std::chrono::steady_clock::now();
+    cache_counter.Start();
+    DijkstraResult result = search(graph, source, queue);
+    cache_counter.Stop();
+    auto finish = std::chrono::steady_clock::now();
+
+    RunSummary summary;
+    summary.heap = selection;
+    summary.allocator = allocator;
+    summary.elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(finish - start).count();
+    summary.elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(finish - start).count();
+    summary.cache_misses = cache_counter.Misses();
+    summarize_result(result, summary);
 
     if (out_result) {
         *out_result = std::move(result);
@@ -257,6 +735,76 @@ RunSummary execute_run(const Graph& graph, int source, HeapSelection selection,
     return summary;
 }
 
+// Same run into a reused buffer, for sweeps that would otherwise allocate
+// two vertex-sized vectors per source.
+RunSummary execute_run(const Graph& graph, int source, DijkstraQueue& queue, HeapSelection selection,
+                       AllocatorPolicy allocator, DijkstraResult& buffer) {
+    CacheMissCounter cache_counter;
+    auto start = std::chrono::steady_clock::now();
+    cache_counter.Start();
+    run_dijkstra(graph, source, queue, buffer);
+    cache_counter.Stop();
+    auto finish = std::chrono::steady_clock::now();
+
+    RunSummary summary;
+    summary.heap = selection;
+    summary.allocator = allocator;
+    summary.elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(finish - start).count();
+    summary.elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(finish - start).count();
+    summary.cache_misses = cache_counter.Misses();
+    summarize_result(buffer, summary);
+    return summary;
+}
+
+// One batched search, reported as one summary per source so the sweep
+// aggregates stay per source. The batch's time is split evenly across its
+// sources in nanoseconds, and its queue metrics go to the first so totals
+// are not repeated.
+std::vector<RunSummary> execute_batch(const Graph& graph, const int* sources, std::size_t count,
+                                      DijkstraQueue& queue, HeapSelection selection, AllocatorPolicy allocator,
+                                      BatchedResult& buffer) {
+    auto start = std::chrono::steady_clock::now();
+    run_batched_dijkstra(graph, sources, count, queue, buffer);
+    auto finish = std::chrono::steady_clock::now();
+    const long long elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(finish - start).count();
+    const auto share = static_cast<long long>(count);
+
+    std::vector<RunSummary> summaries(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        RunSummary& summary = summaries[i];
+        summary.heap = selection;
+        summary.allocator = allocator;
+        summary.elapsed_ns = elapsed_ns / share + (static_cast<long long>(i) < elapsed_ns % share ? 1 : 0);
+        summary.elapsed_ms = summary.elapsed_ns / 1000000;
+        for (std::size_t node = 0; node < graph.node_count(); ++node) {
+            long long dist = buffer.distances[node * buffer.lanes + i];
+            if (dist >= kInfinity) {
+                continue;
+            }
+            summary.reachable_nodes++;
+            if (dist > summary.farthest_distance) {
+                summary.farthest_distance = dist;
+                summary.farthest_node = static_cast<int>(node);
+            }
+        }
+    }
+    summaries.front().metrics = buffer.metrics;
+    summaries.front().structure = buffer.structure;
+    summaries.front().allocation = buffer.allocation;
+    return summaries;
+}
+
+// Times the run with statistics compiled out, then repeats it with full
+// statistics to fill in the structure report.
+RunSummary execute_run(const Graph& graph, int source, HeapSelection selection, AllocatorPolicy allocator,
+                       DijkstraResult* out_result) {
+    auto timed_queue = make_queue_adapter(selection, allocator, StatsPolicy::kNone);
+    RunSummary summary = execute_run(graph, source, *timed_queue, selection, allocator, out_result);
+    auto stats_queue = make_queue_adapter(selection, allocator, StatsPolicy::kFull);
+    summary.structure = run_dijkstra(graph, source, *stats_queue).structure;
+    return summary;
+}
+
 std::string sanitize_filename_component(const std::string& value) {
     std::string sanitized;
     sanitized.reserve(value.size());
@@ -282,6 +830,65 @@ std::filesystem::path default_workload_path(std::size_t operations) {
     return std::filesystem::path("Results") / oss.str();
 }
 
+std::filesystem::path default_meld_path(std::size_t heap_count, std::size_t heap_size) {
+    std::ostringstream oss;
+    oss << "Meld_heaps" << heap_count << "_size" << heap_size << "_summary.txt";
+    return std::filesystem::path("Results") / oss.str();
+}
+
+std::filesystem::path default_lazy_path(const DatasetOption& dataset, std::size_t start_source, std::size_t count) {
+    std::ostringstream oss;
+    oss << sanitize_filename_component(dataset.name) << "_lazy_start" << start_source << "_count" << count
+        << ".txt";
+    return std::filesystem::path("Results") / oss.str();
+}
+
+std::filesystem::path default_query_path(const DatasetOption& dataset, std::size_t pair_count, std::uint32_t seed) {
+    std::ostringstream oss;
+    oss << sanitize_filename_component(dataset.name) << "_queries" << pair_count << "_seed" << seed << ".txt";
+    return std::filesystem::path("Results") / oss.str();
+}
+
+std::filesystem::path default_overlay_path(const DatasetOption& dataset, std::size_t pair_count, std::uint32_t seed) {
+    std::ostringstream oss;
+    oss << sanitize_filename_component(dataset.name) << "_crp_queries" << pair_count << "_seed" << seed << ".txt";
+    return std::filesystem::path("Results") / oss.str();
+}
+
+std::filesystem::path default_delta_path(const DatasetOption& dataset, std::size_t start_source, std::size_t count) {
+    std::ostringstream oss;
+    oss << sanitize_filename_component(dataset.name) << "_delta_stepping_start" << start_source << "_count" << count
+        << ".txt";
+    return std::filesystem::path("Results") / oss.str();
+}
+
+std::filesystem::path default_bounded_path(const DatasetOption& dataset, std::size_t query_count, std::uint32_t seed) {
+    std::ostringstream oss;
+    oss << sanitize_filename_component(dataset.name) << "_bounded" << query_count << "_seed" << seed << ".txt";
+    return std::filesystem::path("Results") / oss.str();
+}
+
+std::filesystem::path default_multi_source_path(const DatasetOption& dataset, std::uint32_t seed) {
+    std::ostringstream oss;
+    oss << sanitize_filename_component(dataset.name) << "_multi_source_seed" << seed << ".txt";
+    return std::filesystem::path("Results") / oss.str();
+}
+
+std::filesystem::path default_landmark_path(const DatasetOption& dataset, std::size_t count,
+                                            LandmarkSelection selection) {
+    std::ostringstream oss;
+    oss << sanitize_filename_component(dataset.name) << "_landmarks_k" << count << '_'
+        << (selection == LandmarkSelection::kFarthest ? "farthest" : "avoid") << ".bin";
+    return std::filesystem::path("Results") / oss.str();
+}
+
+std::filesystem::path default_hub_label_path(const DatasetOption& dataset, HubOrdering ordering) {
+    std::ostringstream oss;
+    oss << sanitize_filename_component(dataset.name) << "_hub_labels_"
+        << (ordering == HubOrdering::kDegree ? "degree" : "contraction") << ".bin";
+    return std::filesystem::path("Results") / oss.str();
+}
+
 std::filesystem::path default_all_sources_path(const DatasetOption& dataset, std::size_t start_source, std::size_t count) {
     std::ostringstream oss;
     oss << sanitize_filename_component(dataset.name) << "_all_sources_start" << start_source
@@ -380,6 +987,104 @@ std::string format_structure_table(const Collection& items, const std::string& t
     return oss.str();
 }
 
+template <typename Collection, typename LabelAccessor>
+std::string format_allocation_table(const Collection& items, const std::string& title, LabelAccessor label_accessor) {
+    if (items.empty()) {
+        return {};
+    }
+
+    std::ostringstream oss;
+    oss << title << '\n';
+    oss << std::left << std::setw(12) << "Heap" << std::setw(12) << "Allocator" << std::right
+        << std::setw(14) << "Allocs"
+        << std::setw(14) << "Frees"
+        << std::setw(14) << "SysAllocs"
+        << std::setw(16) << "PeakReserved" << '\n';
+    oss << std::string(82, '-') << '\n';
+    for (const auto& item : items) {
+        const auto& stats = item.allocation;
+        oss << std::left << std::setw(12) << label_accessor(item) << std::setw(12) << allocator_name(item.allocator)
+            << std::right
+            << std::setw(14) << stats.allocations
+            << std::setw(14) << stats.deallocations
+            << std::setw(14) << stats.system_allocations
+            << std::setw(16) << stats.max_reserved_bytes
+            << '\n';
+    }
+    return oss.str();
+}
+
+// One line per adaptive run: how often it switched heaps and what that cost.
+template <typename Collection, typename MetricsAccessor>
+std::string format_migration_notes(const Collection& items, MetricsAccessor metrics_accessor) {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(3);
+    for (const auto& item : items) {
+        if (item.heap != HeapSelection::kAdaptive) {
+            continue;
+        }
+        const QueueMetrics& metrics = metrics_accessor(item);
+        oss << "Adaptive queue: " << metrics.migration_count << " migrations, "
+            << static_cast<double>(metrics.migration_time_ns) / 1e6 << " ms migrating\n";
+    }
+    return oss.str();
+}
+
+// One line per run whose queue held duplicates: extracts spent on entries
+// superseded by a later push.
+template <typename Collection, typename MetricsAccessor>
+std::string format_stale_notes(const Collection& items, MetricsAccessor metrics_accessor) {
+    std::ostringstream oss;
+    for (const auto& item : items) {
+        const QueueMetrics& metrics = metrics_accessor(item);
+        if (metrics.stale_extract_count == 0) {
+            continue;
+        }
+        oss << heap_name(item.heap) << ": " << metrics.stale_extract_count << " stale extracts, peak "
+            << metrics.peak_stale_entries << " stale entries queued\n";
+    }
+    return oss.str();
+}
+
+// Tail latencies per op type from the queue's histograms, in microseconds.
+template <typename Collection, typename LabelAccessor, typename MetricsAccessor>
+std::string format_latency_table(const Collection& items, const std::string& title, LabelAccessor label_accessor,
+                                 MetricsAccessor metrics_accessor) {
+    if (items.empty()) {
+        return {};
+    }
+
+    auto us = [](std::uint64_t ns) { return static_cast<double>(ns) / 1000.0; };
+    std::ostringstream oss;
+    oss << title << '\n';
+    oss << std::left << std::setw(12) << "Heap" << std::right
+        << std::setw(14) << "Extract p50"
+        << std::setw(14) << "Extract p99"
+        << std::setw(16) << "Extract p99.9"
+        << std::setw(14) << "Extract max"
+        << std::setw(14) << "Decr p99"
+        << std::setw(14) << "Decr max"
+        << std::setw(14) << "Insert p99"
+        << std::setw(14) << "Insert max" << '\n';
+    oss << std::string(126, '-') << '\n';
+    oss << std::fixed << std::setprecision(3);
+    for (const auto& item : items) {
+        const QueueMetrics& metrics = metrics_accessor(item);
+        oss << std::left << std::setw(12) << label_accessor(item) << std::right
+            << std::setw(14) << us(metrics.extract_latency.percentile_ns(0.50))
+            << std::setw(14) << us(metrics.extract_latency.percentile_ns(0.99))
+            << std::setw(16) << us(metrics.extract_latency.percentile_ns(0.999))
+            << std::setw(14) << us(metrics.extract_latency.max_ns())
+            << std::setw(14) << us(metrics.decrease_latency.percentile_ns(0.99))
+            << std::setw(14) << us(metrics.decrease_latency.max_ns())
+            << std::setw(14) << us(metrics.insert_latency.percentile_ns(0.99))
+            << std::setw(14) << us(metrics.insert_latency.max_ns())
+            << '\n';
+    }
+    oss.unsetf(std::ios::floatfield);
+    return oss.str();
+}
+
 void print_structure_metrics(const HeapStructureStats& stats) {
     std::cout << "Max nodes      : " << stats.max_nodes << std::endl;
     std::cout << "Max bytes      : " << format_bytes_with_mb(stats.max_bytes) << std::endl;
@@ -401,9 +1106,10 @@ std::string format_summary_table(const std::vector<RunSummary>& runs, const std:
         << std::setw(14) << "Decreases"
         << std::setw(20) << "Decrease Avg (us)"
         << std::setw(14) << "Reachable"
+        << std::setw(12) << "Miss/op"
         << '\n';
 
-    oss << std::string(138, '-') << '\n';
+    oss << std::string(150, '-') << '\n';
     oss << std::fixed << std::setprecision(3);
     for (const auto& run : runs) {
         double insert_avg = average_us(run.metrics.insert_time_ns, run.metrics.insert_count);
@@ -418,10 +1124,17 @@ std::string format_summary_table(const std::vector<RunSummary>& runs, const std:
             << std::setw(14) << run.metrics.decrease_count
             << std::setw(20) << decrease_avg
             << std::setw(14) << run.reachable_nodes
+            << std::setw(12) << format_misses_per_op(run.cache_misses, run.metrics)
             << '\n';
     }
     oss.unsetf(std::ios::floatfield);
     std::string report = oss.str();
+    report += format_migration_notes(runs, [](const RunSummary& run) -> const QueueMetrics& { return run.metrics; });
+    report += format_stale_notes(runs, [](const RunSummary& run) -> const QueueMetrics& { return run.metrics; });
+    report += '\n' + format_latency_table(
+                          runs, "=== Per-Op Latency Tails (us) for " + dataset_name + " ===",
+                          [](const RunSummary& run) { return heap_name(run.heap); },
+                          [](const RunSummary& run) -> const QueueMetrics& { return run.metrics; });
     std::string structure_section = format_structure_table(
         runs,
         "=== Structural Metrics for " + dataset_name + " ===",
@@ -429,6 +1142,13 @@ std::string format_summary_table(const std::vector<RunSummary>& runs, const std:
     if (!structure_section.empty()) {
         report += '\n' + structure_section;
     }
+    std::string allocation_section = format_allocation_table(
+        runs,
+        "=== Node Allocations for " + dataset_name + " ===",
+        [](const RunSummary& run) { return heap_name(run.heap); });
+    if (!allocation_section.empty()) {
+        report += '\n' + allocation_section;
+    }
     return report;
 }
 
@@ -447,11 +1167,13 @@ void write_summary_report(const std::string& report, const std::filesystem::path
     }
 }
 
-std::string format_workload_table(const std::vector<WorkloadStats>& workloads, std::size_t operations, const WorkloadMix& mix) {
+std::string format_workload_table(const std::vector<WorkloadStats>& workloads, std::size_t operations,
+                                  const WorkloadMix& mix, WorkloadKeyType key_type) {
     std::ostringstream oss;
     oss << "=== Random PQ Workload Summary (" << operations << " ops) ===\n";
     oss << "Mix: Insert " << mix.insert_pct << "% | Decrease " << mix.decrease_pct
         << "% | Extract " << mix.extract_pct << "%\n";
+    oss << "Key type: " << key_type_name(key_type) << '\n';
     oss << std::left << std::setw(12) << "Heap" << std::right
         << std::setw(14) << "Runtime(ms)"
         << std::setw(14) << "Inserts"
@@ -460,8 +1182,10 @@ std::string format_workload_table(const std::vector<WorkloadStats>& workloads, s
         << std::setw(18) << "Extract Avg (us)"
         << std::setw(14) << "Decreases"
         << std::setw(20) << "Decrease Avg (us)"
+        << std::setw(12) << "NodeBytes"
+        << std::setw(12) << "Miss/op"
         << '\n';
-    oss << std::string(128, '-') << '\n';
+    oss << std::string(152, '-') << '\n';
     oss << std::fixed << std::setprecision(3);
     for (const auto& run : workloads) {
         double insert_avg = average_us(run.metrics.insert_time_ns, run.metrics.insert_count);
@@ -475,10 +1199,19 @@ std::string format_workload_table(const std::vector<WorkloadStats>& workloads, s
             << std::setw(18) << extract_avg
             << std::setw(14) << run.metrics.decrease_count
             << std::setw(20) << decrease_avg
+            << std::setw(12) << run.node_bytes
+            << std::setw(12) << format_misses_per_op(run.cache_misses, run.metrics)
             << '\n';
     }
     oss.unsetf(std::ios::floatfield);
     std::string report = oss.str();
+    report += format_migration_notes(workloads,
+                                     [](const WorkloadStats& run) -> const QueueMetrics& { return run.metrics; });
+    report += '\n' + format_latency_table(
+                          workloads, "=== Per-Op Latency Tails (us) for Random Workload (" + std::to_string(operations) +
+                                         " ops) ===",
+                          [](const WorkloadStats& run) { return heap_name(run.heap); },
+                          [](const WorkloadStats& run) -> const QueueMetrics& { return run.metrics; });
     std::string structure_section = format_structure_table(
         workloads,
         "=== Structural Metrics for Random Workload (" + std::to_string(operations) + " ops) ===",
@@ -486,25 +1219,137 @@ std::string format_workload_table(const std::vector<WorkloadStats>& workloads, s
     if (!structure_section.empty()) {
         report += '\n' + structure_section;
     }
+    std::string allocation_section = format_allocation_table(
+        workloads,
+        "=== Node Allocations for Random Workload (" + std::to_string(operations) + " ops) ===",
+        [](const WorkloadStats& run) { return heap_name(run.heap); });
+    if (!allocation_section.empty()) {
+        report += '\n' + allocation_section;
+    }
     return report;
 }
 
-template <typename HeapType, typename HandleType>
-WorkloadStats run_workload_impl(std::size_t operations, std::uint32_t seed, const WorkloadMix& mix) {
-    using Clock = std::chrono::steady_clock;
-    std::mt19937 rng(seed);
-    HeapType heap;
-    QueueMetrics metrics;
+std::string format_meld_table(const std::vector<MeldWorkloadStats>& workloads) {
+    if (workloads.empty()) {
+        return {};
+    }
+
+    const auto& first = workloads.front();
+    auto us = [](std::uint64_t ns) { return static_cast<double>(ns) / 1000.0; };
+    std::ostringstream oss;
+    oss << "=== Meld Workload Summary (" << first.heap_count << " heaps x " << first.heap_size << " keys) ===\n";
+    oss << std::left << std::setw(12) << "Heap" << std::right
+        << std::setw(14) << "Runtime(ms)"
+        << std::setw(10) << "Melds"
+        << std::setw(16) << "Meld Avg (us)"
+        << std::setw(14) << "Meld p50"
+        << std::setw(14) << "Meld p99"
+        << std::setw(14) << "Meld max"
+        << std::setw(18) << "Insert Avg (us)"
+        << std::setw(18) << "Extract Avg (us)"
+        << '\n';
+    oss << std::string(130, '-') << '\n';
+    oss << std::fixed << std::setprecision(3);
+    for (const auto& run : workloads) {
+        oss << std::left << std::setw(12) << heap_name(run.heap) << std::right
+            << std::setw(14) << run.total_runtime_ms
+            << std::setw(10) << run.melds
+            << std::setw(16) << average_us(run.meld_time_ns, run.melds)
+            << std::setw(14) << us(run.meld_latency.percentile_ns(0.50))
+            << std::setw(14) << us(run.meld_latency.percentile_ns(0.99))
+            << std::setw(14) << us(run.meld_latency.max_ns())
+            << std::setw(18) << average_us(run.metrics.insert_time_ns, run.metrics.insert_count)
+            << std::setw(18) << average_us(run.metrics.extract_time_ns, run.metrics.extract_count)
+            << '\n';
+    }
+    oss.unsetf(std::ios::floatfield);
+    std::string report = oss.str();
+    report += '\n' + format_latency_table(
+                          workloads, "=== Per-Op Latency Tails (us) for Meld Workload ===",
+                          [](const MeldWorkloadStats& run) { return heap_name(run.heap); },
+                          [](const MeldWorkloadStats& run) -> const QueueMetrics& { return run.metrics; });
+    return report;
+}
+
+// Workload target over a heap: keeps each live value's handle.
+template <typename HeapType>
+class HeapWorkloadTarget {
+public:
+    using KeyType = typename HeapType::key_type;
+    static constexpr bool kTimesOwnOps = false;
+
+    bool empty() const { return heap_.is_empty(); }
+
+    void insert(int value, long long key) {
+        if (value >= static_cast<int>(handle_by_value_.size())) {
+            handle_by_value_.resize(static_cast<std::size_t>(value) + 1);
+        }
+        handle_by_value_[value] = heap_.insert(static_cast<KeyType>(key), value);
+    }
+
+    void decrease(int value, long long key) {
+        heap_.decrease_key(handle_by_value_[value], static_cast<KeyType>(key));
+    }
+
+    std::pair<long long, int> extract_min() {
+        auto result = heap_.extract_min();
+        return {static_cast<long long>(result.first), result.second};
+    }
+
+    const HeapType& heap() const { return heap_; }
+
+private:
+    HeapType heap_;
+    std::vector<typename HeapType::handle_type> handle_by_value_;
+};
+
+// Workload target over a DijkstraQueue, which tracks handles per value and
+// times its own operations.
+class QueueWorkloadTarget {
+public:
+    static constexpr bool kTimesOwnOps = true;
+
+    explicit QueueWorkloadTarget(DijkstraQueue& queue) : queue_(queue) { queue_.reset(0); }
+
+    bool empty() const { return queue_.empty(); }
+    void insert(int value, long long key) { queue_.push_or_decrease(value, key); }
+    void decrease(int value, long long key) { queue_.push_or_decrease(value, key); }
+    std::pair<long long, int> extract_min() { return queue_.extract_min(); }
+
+private:
+    DijkstraQueue& queue_;
+};
+
+template <typename Target>
+WorkloadStats run_workload_on(Target& target, std::size_t operations, std::uint32_t seed, const WorkloadMix& mix) {
+    using Clock = std::chrono::steady_clock;
+    std::mt19937 rng(seed);
+    QueueMetrics metrics;
 
-    std::vector<HandleType*> handle_by_value;
     std::vector<long long> key_by_value;
     std::vector<int> active_ids;
     std::vector<int> active_pos;
     int next_value = 0;
 
+    // A target that times its own ops is not timed again around the call.
+    auto now_unless_self_timed = [] {
+        if constexpr (Target::kTimesOwnOps) {
+            return Clock::time_point{};
+        } else {
+            return Clock::now();
+        }
+    };
+    auto elapsed_since = [](Clock::time_point start) -> long long {
+        if constexpr (Target::kTimesOwnOps) {
+            (void)start;
+            return 0;
+        } else {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+        }
+    };
+
     auto ensure_capacity = [&](int value) {
-        if (value >= static_cast<int>(handle_by_value.size())) {
-            handle_by_value.resize(value + 1, nullptr);
+        if (value >= static_cast<int>(key_by_value.size())) {
             key_by_value.resize(value + 1, 0);
             active_pos.resize(value + 1, -1);
         }
@@ -514,13 +1359,15 @@ WorkloadStats run_workload_impl(std::size_t operations, std::uint32_t seed, cons
     const int decrease_threshold = insert_threshold + mix.decrease_pct;
     std::uniform_int_distribution<int> op_dist(0, 99);
     std::uniform_int_distribution<long long> key_dist(1'000, 10'000'000);
+    CacheMissCounter cache_counter;
     auto total_start = Clock::now();
+    cache_counter.Start();
 
     for (std::size_t i = 0; i < operations; ++i) {
         int choice = op_dist(rng);
-        bool force_insert = heap.is_empty();
+        bool force_insert = target.empty();
         bool can_decrease = !active_ids.empty();
-        bool can_extract = !heap.is_empty() && (metrics.extract_count < metrics.insert_count);
+        bool can_extract = !target.empty() && (metrics.extract_count < metrics.insert_count);
 
         enum class PlannedOp { Insert, Decrease, Extract };
         PlannedOp planned = PlannedOp::Extract;
@@ -542,95 +1389,323 @@ WorkloadStats run_workload_impl(std::size_t operations, std::uint32_t seed, cons
             long long key = key_dist(rng);
             int value = next_value++;
             ensure_capacity(value);
-            auto op_start = Clock::now();
-            HandleType* handle = heap.insert(key, value);
-            auto op_end = Clock::now();
+            const auto op_start = now_unless_self_timed();
+            target.insert(value, key);
+            const long long ns = elapsed_since(op_start);
             metrics.insert_count++;
-            metrics.insert_time_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(op_end - op_start).count();
+            metrics.insert_time_ns += ns;
+            metrics.insert_latency.record(ns);
 
-            handle_by_value[value] = handle;
             key_by_value[value] = key;
             active_pos[value] = static_cast<int>(active_ids.size());
             active_ids.push_back(value);
         } else if (planned == PlannedOp::Decrease) {
             std::uniform_int_distribution<std::size_t> idx_dist(0, active_ids.size() - 1);
             int value = active_ids[idx_dist(rng)];
-            HandleType* handle = handle_by_value[value];
-            if (!handle) {
-                continue;
-            }
             long long delta = 1 + static_cast<long long>(rng() % 1000);
             long long new_key = key_by_value[value];
             new_key = new_key > delta ? new_key - delta : 0;
-            auto op_start = Clock::now();
-            heap.decrease_key(handle, new_key);
-            auto op_end = Clock::now();
+            const auto op_start = now_unless_self_timed();
+            target.decrease(value, new_key);
+            const long long ns = elapsed_since(op_start);
             metrics.decrease_count++;
-            metrics.decrease_time_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(op_end - op_start).count();
+            metrics.decrease_time_ns += ns;
+            metrics.decrease_latency.record(ns);
             key_by_value[value] = new_key;
         } else { // Extract
-            auto op_start = Clock::now();
-            auto result = heap.extract_min();
-            auto op_end = Clock::now();
+            const auto op_start = now_unless_self_timed();
+            auto result = target.extract_min();
+            const long long ns = elapsed_since(op_start);
             metrics.extract_count++;
-            metrics.extract_time_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(op_end - op_start).count();
+            metrics.extract_time_ns += ns;
+            metrics.extract_latency.record(ns);
 
             int value = result.second;
-            if (value >= 0 && value < static_cast<int>(handle_by_value.size())) {
-                handle_by_value[value] = nullptr;
-                if (value < static_cast<int>(active_pos.size())) {
-                    int pos = active_pos[value];
-                    if (pos >= 0) {
-                        int last_value = active_ids.back();
-                        active_ids[pos] = last_value;
-                        active_pos[last_value] = pos;
-                        active_ids.pop_back();
-                    }
-                    active_pos[value] = -1;
+            if (value >= 0 && value < static_cast<int>(active_pos.size())) {
+                int pos = active_pos[value];
+                if (pos >= 0) {
+                    int last_value = active_ids.back();
+                    active_ids[pos] = last_value;
+                    active_pos[last_value] = pos;
+                    active_ids.pop_back();
                 }
+                active_pos[value] = -1;
             }
         }
     }
 
+    cache_counter.Stop();
     auto total_end = Clock::now();
 
     WorkloadStats stats;
     stats.operations = operations;
     stats.metrics = metrics;
     stats.total_runtime_ms = std::chrono::duration_cast<std::chrono::milliseconds>(total_end - total_start).count();
-    stats.structure = heap.structure_stats();
+    stats.cache_misses = cache_counter.Misses();
     return stats;
 }
 
-WorkloadStats run_random_workload(std::size_t operations, HeapSelection selection, std::uint32_t seed, const WorkloadMix& mix) {
+template <typename HeapType>
+WorkloadStats run_workload_impl(std::size_t operations, std::uint32_t seed, const WorkloadMix& mix) {
+    HeapWorkloadTarget<HeapType> target;
+    WorkloadStats stats = run_workload_on(target, operations, seed, mix);
+    stats.structure = target.heap().structure_stats();
+    stats.allocation = target.heap().allocation_stats();
+    stats.node_bytes = HeapType::kNodeBytes;
+    return stats;
+}
+
+// The adaptive queue only exists behind DijkstraQueue (int64 keys), so it is
+// driven through that interface. Per-op times are the queue's own, taken
+// inside the adapter as in the Dijkstra runs; migrations are timed apart.
+WorkloadStats run_adaptive_workload(std::size_t operations, std::uint32_t seed, const WorkloadMix& mix,
+                                    AllocatorPolicy allocator, StatsPolicy stats_policy) {
+    auto queue = make_queue_adapter(HeapSelection::kAdaptive, allocator, stats_policy);
+    QueueWorkloadTarget target(*queue);
+    WorkloadStats stats = run_workload_on(target, operations, seed, mix);
+    stats.metrics = queue->metrics();
+    stats.structure = queue->structure_stats();
+    stats.allocation = queue->allocation_stats();
+    // Whichever of its two heaps is active holds the elements.
+    stats.node_bytes =
+        std::max(BinaryHeap<long long, int>::kNodeBytes, IndexedFibonacciHeap<long long, int>::kNodeBytes);
+    return stats;
+}
+
+template <typename HeapType>
+struct HeapTypeTag {
+    using type = HeapType;
+};
+
+// Calls fn(HeapTypeTag<H>{}) with the standalone heap type H behind a
+// selection. The adaptive queue has none and is rejected.
+template <typename Key, typename Alloc, typename Stats, typename Fn>
+decltype(auto) with_heap_type(HeapSelection selection, Fn&& fn) {
+    using Compare = std::less<Key>;
     switch (selection) {
-        case HeapSelection::kBinary: {
-            auto stats = run_workload_impl<BinaryHeap, BinaryHeapNode>(operations, seed, mix);
-            stats.heap = selection;
-            return stats;
+        case HeapSelection::kBinary:
+            return fn(HeapTypeTag<BinaryHeap<Key, int, Compare, Alloc, Stats>>{});
+        case HeapSelection::kFibonacci:
+            return fn(HeapTypeTag<FibonacciHeap<Key, int, Compare, Alloc, Stats>>{});
+        case HeapSelection::kHollow:
+            return fn(HeapTypeTag<HollowHeap<Key, int, Compare, Alloc, Stats>>{});
+        case HeapSelection::kFibonacciIndexed:
+            return fn(HeapTypeTag<IndexedFibonacciHeap<Key, int, Compare, Stats>>{});
+        case HeapSelection::kHollowIndexed:
+            return fn(HeapTypeTag<IndexedHollowHeap<Key, int, Compare, Stats>>{});
+        case HeapSelection::kFlat:
+            return fn(HeapTypeTag<FlatSpillHeap<Key, int, Compare, Alloc, Stats>>{});
+        case HeapSelection::kBHeap:
+            return fn(HeapTypeTag<BHeap<Key, int, Compare, Stats>>{});
+        case HeapSelection::kThin:
+            return fn(HeapTypeTag<ThinHeap<Key, int, Compare, Alloc, Stats>>{});
+        case HeapSelection::kTwoThree:
+            return fn(HeapTypeTag<TwoThreeHeap<Key, int, Compare, Alloc, Stats>>{});
+        case HeapSelection::kFibonacciBounded:
+            return fn(HeapTypeTag<BoundedFibonacciHeap<Key, int, Compare, Alloc, Stats>>{});
+        case HeapSelection::kLeftist:
+            return fn(HeapTypeTag<LeftistHeap<Key, int, Compare, Alloc, Stats>>{});
+        case HeapSelection::kSkew:
+            return fn(HeapTypeTag<SkewHeap<Key, int, Compare, Alloc, Stats>>{});
+        default:
+            throw std::invalid_argument("Unknown heap selection");
+    }
+}
+
+template <typename Key, typename Alloc, typename Stats>
+WorkloadStats run_random_workload_for_key(std::size_t operations, HeapSelection selection, std::uint32_t seed,
+                                          const WorkloadMix& mix) {
+    return with_heap_type<Key, Alloc, Stats>(selection, [&](auto tag) {
+        using HeapType = typename decltype(tag)::type;
+        auto stats = run_workload_impl<HeapType>(operations, seed, mix);
+        stats.heap = selection;
+        return stats;
+    });
+}
+
+template <typename Alloc, typename Stats>
+WorkloadStats run_random_workload_with(std::size_t operations, HeapSelection selection, std::uint32_t seed,
+                                       const WorkloadMix& mix, WorkloadKeyType key_type) {
+    if (key_type == WorkloadKeyType::kUInt32) {
+        return run_random_workload_for_key<std::uint32_t, Alloc, Stats>(operations, selection, seed, mix);
+    }
+    return run_random_workload_for_key<long long, Alloc, Stats>(operations, selection, seed, mix);
+}
+
+template <typename Stats>
+WorkloadStats run_random_workload(std::size_t operations, HeapSelection selection, std::uint32_t seed,
+                                  const WorkloadMix& mix, WorkloadKeyType key_type, AllocatorPolicy allocator) {
+    WorkloadStats stats;
+    if (selection == HeapSelection::kAdaptive) {
+        const StatsPolicy stats_policy = Stats::kEnabled ? StatsPolicy::kFull : StatsPolicy::kNone;
+        stats = run_adaptive_workload(operations, seed, mix, allocator, stats_policy);
+        stats.heap = selection;
+        stats.allocator = allocator;
+        return stats;
+    }
+    switch (allocator) {
+        case AllocatorPolicy::kNewDelete:
+            stats = run_random_workload_with<NewDeleteAllocator, Stats>(operations, selection, seed, mix, key_type);
+            break;
+        case AllocatorPolicy::kPool:
+            stats = run_random_workload_with<PoolAllocator, Stats>(operations, selection, seed, mix, key_type);
+            break;
+        case AllocatorPolicy::kArena:
+            stats = run_random_workload_with<MonotonicArenaAllocator, Stats>(operations, selection, seed, mix, key_type);
+            break;
+        case AllocatorPolicy::kHugePageArena:
+            stats = run_random_workload_with<HugePageArenaAllocator, Stats>(operations, selection, seed, mix, key_type);
+            break;
+        default:
+            throw std::invalid_argument("Unknown allocator policy");
+    }
+    stats.allocator = allocator;
+    return stats;
+}
+
+// Borůvka-style rounds: the live heaps are shuffled and paired, the second
+// of each pair is melded into the first, and each merged heap then extracts
+// its minimum and takes one new key. The last heap is drained and checked
+// for order. Every meld goes through PriorityQueue::merge.
+template <typename HeapType>
+MeldWorkloadStats run_meld_workload_impl(std::size_t heap_count, std::size_t heap_size, std::uint32_t seed) {
+    using Clock = std::chrono::steady_clock;
+    using KeyType = typename HeapType::key_type;
+    auto elapsed_ns = [](Clock::time_point start) {
+        return static_cast<long long>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+    };
+
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<long long> key_dist(1'000, 10'000'000);
+    MeldWorkloadStats stats;
+    stats.heap_count = heap_count;
+    stats.heap_size = heap_size;
+    QueueMetrics& metrics = stats.metrics;
+    int next_value = 0;
+
+    auto timed_insert = [&](HeapType& heap) {
+        const auto key = static_cast<KeyType>(key_dist(rng));
+        const auto op_start = Clock::now();
+        heap.insert(key, next_value++);
+        const long long ns = elapsed_ns(op_start);
+        metrics.insert_count++;
+        metrics.insert_time_ns += ns;
+        metrics.insert_latency.record(ns);
+    };
+    auto timed_extract = [&](HeapType& heap) {
+        const auto op_start = Clock::now();
+        auto result = heap.extract_min();
+        const long long ns = elapsed_ns(op_start);
+        metrics.extract_count++;
+        metrics.extract_time_ns += ns;
+        metrics.extract_latency.record(ns);
+        return result.first;
+    };
+
+    const auto total_start = Clock::now();
+    std::vector<std::unique_ptr<HeapType>> heaps;
+    heaps.reserve(heap_count);
+    for (std::size_t i = 0; i < heap_count; ++i) {
+        heaps.push_back(std::make_unique<HeapType>());
+        for (std::size_t j = 0; j < heap_size; ++j) {
+            timed_insert(*heaps.back());
         }
-        case HeapSelection::kFibonacci: {
-            auto stats = run_workload_impl<FibonacciHeap, FibonacciHeapNode>(operations, seed, mix);
-            stats.heap = selection;
-            return stats;
+    }
+
+    while (heaps.size() > 1) {
+        std::shuffle(heaps.begin(), heaps.end(), rng);
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < heaps.size(); i += 2) {
+            if (i + 1 < heaps.size()) {
+                HeapType& target = *heaps[i];
+                const auto op_start = Clock::now();
+                target.merge(*heaps[i + 1]);
+                const long long ns = elapsed_ns(op_start);
+                stats.melds++;
+                stats.meld_time_ns += ns;
+                stats.meld_latency.record(ns);
+                heaps[i + 1].reset();
+                if (!target.is_empty()) timed_extract(target);
+                timed_insert(target);
+            }
+            heaps[kept++] = std::move(heaps[i]);
         }
-        case HeapSelection::kHollow: {
-            auto stats = run_workload_impl<HollowHeap, HollowHeapNode>(operations, seed, mix);
-            stats.heap = selection;
-            return stats;
+        heaps.resize(kept);
+    }
+
+    if (!heaps.empty()) {
+        HeapType& last = *heaps.front();
+        KeyType previous{};
+        bool first = true;
+        while (!last.is_empty()) {
+            const KeyType key = timed_extract(last);
+            if (!first && key < previous) {
+                throw std::runtime_error("meld workload drained keys out of order");
+            }
+            previous = key;
+            first = false;
         }
+    }
+    stats.total_runtime_ms =
+        std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - total_start).count();
+    return stats;
+}
+
+template <typename Alloc>
+MeldWorkloadStats run_meld_workload_with(HeapSelection selection, std::size_t heap_count, std::size_t heap_size,
+                                         std::uint32_t seed) {
+    return with_heap_type<long long, Alloc, NoStats>(selection, [&](auto tag) {
+        using HeapType = typename decltype(tag)::type;
+        return run_meld_workload_impl<HeapType>(heap_count, heap_size, seed);
+    });
+}
+
+MeldWorkloadStats run_meld_workload(HeapSelection selection, std::size_t heap_count, std::size_t heap_size,
+                                    std::uint32_t seed, AllocatorPolicy allocator) {
+    MeldWorkloadStats stats;
+    switch (allocator) {
+        case AllocatorPolicy::kNewDelete:
+            stats = run_meld_workload_with<NewDeleteAllocator>(selection, heap_count, heap_size, seed);
+            break;
+        case AllocatorPolicy::kPool:
+            stats = run_meld_workload_with<PoolAllocator>(selection, heap_count, heap_size, seed);
+            break;
+        case AllocatorPolicy::kArena:
+            stats = run_meld_workload_with<MonotonicArenaAllocator>(selection, heap_count, heap_size, seed);
+            break;
+        case AllocatorPolicy::kHugePageArena:
+            stats = run_meld_workload_with<HugePageArenaAllocator>(selection, heap_count, heap_size, seed);
+            break;
         default:
-            throw std::invalid_argument("Unknown heap selection");
+            throw std::invalid_argument("Unknown allocator policy");
+    }
+    stats.heap = selection;
+    stats.allocator = allocator;
+    return stats;
+}
+
+AllocatorPolicy prompt_allocator_policy() {
+    std::cout << "Select node allocator:" << std::endl;
+    std::cout << "  [1] new/delete per node" << std::endl;
+    std::cout << "  [2] Size-class pool" << std::endl;
+    std::cout << "  [3] Monotonic arena" << std::endl;
+    std::cout << "  [4] Huge-page arena" << std::endl;
+    int choice = read_int_with_default("Allocator [default: 1]: ", 1);
+    if (choice < 1 || choice > 4) {
+        std::cout << "Invalid selection. Using new/delete." << std::endl;
+        choice = 1;
     }
+    return static_cast<AllocatorPolicy>(choice);
 }
 } // namespace
 
 int main(int argc, char** argv) try {
     const std::filesystem::path exe_dir = detect_exe_directory(argv);
     const std::vector<DatasetOption> datasets = {
-        {"Chongqing road network", "Data/Chongqing.road-d"},
-        {"Hong Kong road network", "Data/Hongkong.road-d"},
-        {"Shanghai road network", "Data/Shanghai.road-d"},
+        {"Chongqing road network", "Data/Chongqing.road-d", "Data/Chongqing.co"},
+        {"Hong Kong road network", "Data/Hongkong.road-d", "Data/Hongkong.co"},
+        {"Shanghai road network", "Data/Shanghai.road-d", "Data/Shanghai.co"},
     };
 
     print_section_header("Dataset Selection");
@@ -664,6 +1739,14 @@ int main(int argc, char** argv) try {
     std::cout << "File      : " << dataset_path << "\n";
     std::cout << "Nodes     : " << graph.node_count() << "\n";
     std::cout << "Edges     : " << graph.edge_count() << std::endl;
+    const auto coordinates_path = resolve_dataset_path(dataset.coordinates_path, exe_dir);
+    if (coordinates_path.empty()) {
+        std::cout << "Coords    : none (" << dataset.coordinates_path << " not found; A* disabled)" << std::endl;
+    } else if (!graph.load_coordinates(coordinates_path.string(), CoordinateSystem::kLonLatDegrees, &load_error)) {
+        std::cout << "Coords    : ignored (" << load_error << ")" << std::endl;
+    } else {
+        std::cout << "Coords    : " << coordinates_path << std::endl;
+    }
 
     int source = read_int_with_default("Enter source vertex id [default: 0]: ", 0);
     if (source < 0 || static_cast<std::size_t>(source) >= graph.node_count()) {
@@ -677,14 +1760,22 @@ int main(int argc, char** argv) try {
     std::cout << "  [2] Run all heaps and produce summary" << std::endl;
     std::cout << "  [3] Random PQ workload benchmark" << std::endl;
     std::cout << "  [4] Run Dijkstra from every node" << std::endl;
+    std::cout << "  [5] Meld-heavy heap workload" << std::endl;
+    std::cout << "  [6] Lazy-insertion Dijkstra vs decrease-key" << std::endl;
+    std::cout << "  [7] Point-to-point queries on random s-t pairs" << std::endl;
+    std::cout << "  [8] Customizable route planning (CRP)" << std::endl;
+    std::cout << "  [9] Parallel delta-stepping vs Dijkstra" << std::endl;
+    std::cout << "  [10] Bounded searches (isochrones, targets, k-nearest)" << std::endl;
+    std::cout << "  [11] Multi-source Dijkstra vs one run per source" << std::endl;
     int mode_choice = read_int_with_default("Mode [default: 1]: ", 1);
 
     if (mode_choice == 2) {
         print_section_header("Batch Comparison (All Heaps)");
+        const AllocatorPolicy allocator = prompt_allocator_policy();
         std::vector<RunSummary> summaries;
-        for (HeapSelection selection : {HeapSelection::kBinary, HeapSelection::kFibonacci, HeapSelection::kHollow}) {
+        for (HeapSelection selection : all_heap_selections()) {
             std::cout << "  • Running " << heap_name(selection) << " heap..." << std::flush;
-            RunSummary summary = execute_run(graph, source, selection, nullptr);
+            RunSummary summary = execute_run(graph, source, selection, allocator, nullptr);
             std::cout << " done (" << summary.elapsed_ms << " ms)." << std::endl;
             summaries.push_back(summary);
         }
@@ -723,6 +1814,11 @@ int main(int argc, char** argv) try {
             mix = WorkloadMix{};
         }
 
+        int key_choice = read_int_with_default("Key type [1] int64, [2] uint32 [default: 1]: ", 1);
+        WorkloadKeyType key_type = key_choice == 2 ? WorkloadKeyType::kUInt32 : WorkloadKeyType::kInt64;
+
+        const AllocatorPolicy allocator = prompt_allocator_policy();
+
         bool run_all = prompt_yes_no("Benchmark all heaps? [Y/n]: ", true);
 
         std::vector<WorkloadStats> workloads;
@@ -730,8 +1826,14 @@ int main(int argc, char** argv) try {
         const std::uint32_t seed = rd();
 
         auto run_for_selection = [&](HeapSelection selection) {
+            // Without decrease-key it only runs in the Dijkstra modes.
+            if (selection == HeapSelection::kStdPriorityQueue) return;
             std::cout << "  • Running " << heap_name(selection) << " workload..." << std::flush;
-            WorkloadStats stats = run_random_workload(op_count, selection, seed, mix);
+            // Timed with statistics compiled out; the same seed replays the
+            // identical sequence with full statistics for the structure table.
+            WorkloadStats stats = run_random_workload<NoStats>(op_count, selection, seed, mix, key_type, allocator);
+            stats.structure =
+                run_random_workload<FullStats>(op_count, selection, seed, mix, key_type, allocator).structure;
             std::cout << " done (" << stats.total_runtime_ms << " ms)." << std::endl;
             workloads.push_back(stats);
         };
@@ -740,22 +1842,15 @@ int main(int argc, char** argv) try {
         std::cout << "Operations : " << op_count << "\n";
         std::cout << "Mix        : insert " << mix.insert_pct << "%, decrease "
               << mix.decrease_pct << "%, extract " << mix.extract_pct << "%" << std::endl;
+        std::cout << "Key type   : " << key_type_name(key_type) << std::endl;
+        std::cout << "Allocator  : " << allocator_name(allocator) << std::endl;
 
         if (run_all) {
-            for (HeapSelection selection : {HeapSelection::kBinary, HeapSelection::kFibonacci, HeapSelection::kHollow}) {
+            for (HeapSelection selection : all_heap_selections()) {
                 run_for_selection(selection);
             }
         } else {
-            std::cout << "Select heap implementation:" << std::endl;
-            std::cout << "  [1] Binary Heap" << std::endl;
-            std::cout << "  [2] Fibonacci Heap" << std::endl;
-            std::cout << "  [3] Hollow Heap" << std::endl;
-            int heap_choice = read_int_with_default("Choice [default: 3]: ", 3);
-            if (heap_choice < 1 || heap_choice > 3) {
-                std::cout << "Invalid selection. Using Hollow Heap." << std::endl;
-                heap_choice = 3;
-            }
-            run_for_selection(static_cast<HeapSelection>(heap_choice));
+            run_for_selection(prompt_heap_selection());
         }
 
         auto default_path = default_workload_path(op_count);
@@ -764,7 +1859,7 @@ int main(int argc, char** argv) try {
             default_path.string());
         std::filesystem::path out_path(out_path_input);
 
-        std::string report = format_workload_table(workloads, op_count, mix);
+        std::string report = format_workload_table(workloads, op_count, mix, key_type);
         std::cout << '\n' << report << std::endl;
         write_summary_report(report, out_path);
         std::cout << "Summary written to " << out_path << std::endl;
@@ -805,47 +1900,140 @@ int main(int argc, char** argv) try {
             return 0;
         }
 
+        const AllocatorPolicy allocator = prompt_allocator_policy();
         bool run_all_heaps = prompt_yes_no("Run all heap implementations? [Y/n]: ", true);
+        bool collect_structure = prompt_yes_no(
+            "Collect structural peaks in a second full-stats pass? [y/N]: ", false);
+        const int hardware_threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        int thread_input = read_int_with_default(
+            "Worker threads [default: " + std::to_string(hardware_threads) + "]: ", hardware_threads);
+        const auto threads = static_cast<std::size_t>(std::max(1, thread_input));
+        int batch_input = read_int_with_default(
+            "Sources per SIMD batch (1 = one search each, up to 16) [default: 1]: ", 1);
+        const auto batch = static_cast<std::size_t>(std::clamp(batch_input, 1, static_cast<int>(kMaxBatchSources)));
+        const std::size_t batch_count = (sources_to_run + batch - 1) / batch;
         std::cout << "Running Dijkstra from " << sources_to_run << " sources per heap (starting at vertex "
-              << start_source << "). This may take a while." << std::endl;
+              << start_source << ") on " << threads << " thread(s). This may take a while." << std::endl;
+        if (batch > 1) {
+            std::cout << "Batching " << batch << " sources per search ("
+                      << (batched_search_uses_simd() ? "AVX2" : "scalar") << " lane updates)." << std::endl;
+        }
 
         std::vector<AggregateStats> aggregates;
+        std::ostringstream sweep_notes;
+        // Each worker keeps its own queue, result buffer and partial
+        // aggregate; the partials are merged once the sweep is over.
         auto run_for_selection = [&](HeapSelection selection) {
+            // The batched search re-queues scanned vertices, which the
+            // adaptive queue's push cannot take; it runs one search per source.
+            const bool batched = batch > 1 && selection != HeapSelection::kAdaptive;
             print_subsection_header(heap_name(selection) + std::string(" Heap"));
+            if (batch > 1 && !batched) {
+                std::cout << "Batched search needs push(); running one search per source." << std::endl;
+            }
             std::cout << "Beginning all-sources pass..." << std::endl;
             AggregateStats agg;
             agg.heap = selection;
-            std::size_t progress_step = std::max<std::size_t>(1, sources_to_run / 10);
-            for (std::size_t offset = 0; offset < sources_to_run; ++offset) {
-                int source_vertex = static_cast<int>(start_source + offset);
-                RunSummary summary = execute_run(graph, source_vertex, selection, nullptr);
-                accumulate_aggregate(agg, summary);
-                if ((offset + 1) % progress_step == 0 || offset + 1 == sources_to_run) {
-                    std::cout << "  • Completed " << (offset + 1) << "/" << sources_to_run
-                              << " sources\r" << std::flush;
-                }
+            agg.allocator = allocator;
+            std::vector<AggregateStats> partials(threads, agg);
+            std::vector<std::unique_ptr<DijkstraQueue>> queues;
+            std::vector<DijkstraResult> buffers(threads);
+            for (std::size_t t = 0; t < threads; ++t) {
+                queues.push_back(make_queue_adapter(selection, allocator, StatsPolicy::kNone));
+            }
+            auto report_progress = [&](std::size_t completed) {
+                std::cout << "  • Completed " << completed << "/" << sources_to_run << " sources\r" << std::flush;
+            };
+            std::vector<BatchedResult> batch_buffers(batched ? threads : 0);
+            std::atomic<std::size_t> batch_scans{0};
+            const auto sweep_start = std::chrono::steady_clock::now();
+            if (batched) {
+                run_work_stealing(
+                    batch_count, threads,
+                    [&](std::size_t worker, std::size_t index) {
+                        const std::size_t first = index * batch;
+                        const std::size_t count = std::min(batch, sources_to_run - first);
+                        int sources[kMaxBatchSources];
+                        for (std::size_t i = 0; i < count; ++i) {
+                            sources[i] = static_cast<int>(start_source + first + i);
+                        }
+                        for (const auto& summary : execute_batch(graph, sources, count, *queues[worker], selection,
+                                                                 allocator, batch_buffers[worker])) {
+                            accumulate_aggregate(partials[worker], summary);
+                        }
+                        batch_scans.fetch_add(batch_buffers[worker].scans, std::memory_order_relaxed);
+                    },
+                    [&](std::size_t completed) { report_progress(std::min(completed * batch, sources_to_run)); });
+            } else {
+                run_work_stealing(
+                    sources_to_run, threads,
+                    [&](std::size_t worker, std::size_t offset) {
+                        int source_vertex = static_cast<int>(start_source + offset);
+                        accumulate_aggregate(partials[worker], execute_run(graph, source_vertex, *queues[worker],
+                                                                           selection, allocator, buffers[worker]));
+                    },
+                    report_progress);
+            }
+            const auto sweep_end = std::chrono::steady_clock::now();
+            for (const auto& partial : partials) {
+                merge_aggregate(agg, partial);
             }
             std::cout << std::string(50, ' ') << "\r";
             std::cout << "  Completed " << sources_to_run << " sources for " << heap_name(selection) << "."
                       << std::endl;
+            if (collect_structure) {
+                std::cout << "Collecting structural peaks..." << std::endl;
+                std::vector<HeapStructureStats> peaks(threads);
+                for (std::size_t t = 0; t < threads; ++t) {
+                    queues[t] = make_queue_adapter(selection, allocator, StatsPolicy::kFull);
+                }
+                if (batched) {
+                    run_work_stealing(batch_count, threads, [&](std::size_t worker, std::size_t index) {
+                        const std::size_t first = index * batch;
+                        const std::size_t count = std::min(batch, sources_to_run - first);
+                        int sources[kMaxBatchSources];
+                        for (std::size_t i = 0; i < count; ++i) {
+                            sources[i] = static_cast<int>(start_source + first + i);
+                        }
+                        run_batched_dijkstra(graph, sources, count, *queues[worker], batch_buffers[worker]);
+                        accumulate_structure_stats(peaks[worker], batch_buffers[worker].structure);
+                    });
+                } else {
+                    run_work_stealing(sources_to_run, threads, [&](std::size_t worker, std::size_t offset) {
+                        int source_vertex = static_cast<int>(start_source + offset);
+                        run_dijkstra(graph, source_vertex, *queues[worker], buffers[worker]);
+                        accumulate_structure_stats(peaks[worker], buffers[worker].structure);
+                    });
+                }
+                for (const auto& peak : peaks) {
+                    accumulate_structure_stats(agg.structure, peak);
+                }
+            }
+            const double wall_s = std::chrono::duration<double>(sweep_end - sweep_start).count();
+            sweep_notes << std::fixed << std::setprecision(3) << heap_name(agg.heap) << ": " << wall_s
+                        << " s wall on " << threads << " thread(s), "
+                        << (wall_s > 0.0 ? static_cast<double>(sources_to_run) / wall_s : 0.0)
+                        << " sources/s, summed run time " << static_cast<double>(agg.total_runtime_ns) / 1e9
+                        << " s (" << (wall_s > 0.0 ? static_cast<double>(agg.total_runtime_ns) / 1e9 / wall_s : 0.0)
+                        << "x).\n";
+            if (batch > 1 && !batched) {
+                sweep_notes << "  Not batched: the batched search needs push(), so one search per source.\n";
+            }
+            if (batched) {
+                sweep_notes << "  " << batch << "-source batches: "
+                            << static_cast<double>(batch_scans.load())
+                                   / static_cast<double>(sources_to_run * graph.node_count())
+                            << " vertex scans per source and vertex (1.000 one source at a time).\n";
+            }
             aggregates.push_back(agg);
         };
 
         if (run_all_heaps) {
-            for (HeapSelection selection : {HeapSelection::kBinary, HeapSelection::kFibonacci, HeapSelection::kHollow}) {
+            for (HeapSelection selection : all_heap_selections()) {
                 run_for_selection(selection);
             }
         } else {
-            std::cout << "Select heap implementation:" << std::endl;
-            std::cout << "  [1] Binary Heap" << std::endl;
-            std::cout << "  [2] Fibonacci Heap" << std::endl;
-            std::cout << "  [3] Hollow Heap" << std::endl;
-            int heap_choice = read_int_with_default("Choice [default: 3]: ", 3);
-            if (heap_choice < 1 || heap_choice > 3) {
-                std::cout << "Invalid selection. Using Hollow Heap." << std::endl;
-                heap_choice = 3;
-            }
-            run_for_selection(static_cast<HeapSelection>(heap_choice));
+            run_for_selection(prompt_heap_selection());
         }
 
         auto default_path = default_all_sources_path(dataset, start_source, sources_to_run);
@@ -855,13 +2043,32 @@ int main(int argc, char** argv) try {
         std::filesystem::path out_path(out_path_input);
 
         std::string report = format_all_sources_table(aggregates, dataset.name, sources_to_run);
-        std::string structure_section = format_structure_table(
-            aggregates,
-            "=== Structural Peaks for " + dataset.name + " (all-sources) ===",
-            [](const AggregateStats& agg) { return heap_name(agg.heap); });
+        report += sweep_notes.str();
+        report += format_migration_notes(
+            aggregates, [](const AggregateStats& agg) -> const QueueMetrics& { return agg.total_metrics; });
+        report += format_stale_notes(
+            aggregates, [](const AggregateStats& agg) -> const QueueMetrics& { return agg.total_metrics; });
+        report += '\n' + format_latency_table(
+                              aggregates, "=== Per-Op Latency Tails (us) for " + dataset.name + " (all-sources) ===",
+                              [](const AggregateStats& agg) { return heap_name(agg.heap); },
+                              [](const AggregateStats& agg) -> const QueueMetrics& { return agg.total_metrics; });
+        std::string structure_section;
+        if (collect_structure) {
+            structure_section = format_structure_table(
+                aggregates,
+                "=== Structural Peaks for " + dataset.name + " (all-sources) ===",
+                [](const AggregateStats& agg) { return heap_name(agg.heap); });
+        }
         if (!structure_section.empty()) {
             report += '\n' + structure_section;
         }
+        std::string allocation_section = format_allocation_table(
+            aggregates,
+            "=== Node Allocations for " + dataset.name + " (all-sources totals) ===",
+            [](const AggregateStats& agg) { return heap_name(agg.heap); });
+        if (!allocation_section.empty()) {
+            report += '\n' + allocation_section;
+        }
 
         std::cout << '\n' << report << std::endl;
         write_summary_report(report, out_path);
@@ -869,22 +2076,857 @@ int main(int argc, char** argv) try {
         return 0;
     }
 
-    std::cout << "Select heap implementation:" << std::endl;
-    std::cout << "  [1] Binary Heap" << std::endl;
-    std::cout << "  [2] Fibonacci Heap" << std::endl;
-    std::cout << "  [3] Hollow Heap" << std::endl;
-    int heap_choice = read_int_with_default("Choice [default: 3]: ", 3);
-    if (heap_choice < 1 || heap_choice > 3) {
-        std::cout << "Invalid selection. Using Hollow Heap." << std::endl;
-        heap_choice = 3;
+    if (mode_choice == 5) {
+        print_section_header("Meld-Heavy Workload");
+        int heap_count_input = read_int_with_default("Number of heaps [default: 10000]: ", 10000);
+        int heap_size_input = read_int_with_default("Keys per heap [default: 16]: ", 16);
+        if (heap_count_input < 2) heap_count_input = 2;
+        if (heap_size_input < 1) heap_size_input = 1;
+        const auto heap_count = static_cast<std::size_t>(heap_count_input);
+        const auto heap_size = static_cast<std::size_t>(heap_size_input);
+        const AllocatorPolicy allocator = prompt_allocator_policy();
+        bool run_all = prompt_yes_no("Benchmark all heaps? [Y/n]: ", true);
+
+        std::random_device rd;
+        const std::uint32_t seed = rd();
+        std::vector<MeldWorkloadStats> workloads;
+        auto run_for_selection = [&](HeapSelection selection) {
+            // The adaptive queue and std::priority_queue only exist behind
+            // DijkstraQueue, which has no meld.
+            if (selection == HeapSelection::kAdaptive || selection == HeapSelection::kStdPriorityQueue) return;
+            std::cout << "  • Running " << heap_name(selection) << " melds..." << std::flush;
+            MeldWorkloadStats stats = run_meld_workload(selection, heap_count, heap_size, seed, allocator);
+            std::cout << " done (" << stats.total_runtime_ms << " ms)." << std::endl;
+            workloads.push_back(stats);
+        };
+
+        if (run_all) {
+            for (HeapSelection selection : all_heap_selections()) {
+                run_for_selection(selection);
+            }
+        } else {
+            run_for_selection(prompt_heap_selection());
+        }
+
+        auto default_path = default_meld_path(heap_count, heap_size);
+        std::string out_path_input = read_line_with_default(
+            "Enter meld summary file path [default: " + default_path.string() + "]: ",
+            default_path.string());
+        std::filesystem::path out_path(out_path_input);
+
+        std::string report = format_meld_table(workloads);
+        std::cout << '\n' << report << std::endl;
+        write_summary_report(report, out_path);
+        std::cout << "Summary written to " << out_path << std::endl;
+        return 0;
+    }
+
+    if (mode_choice == 6) {
+        print_section_header("Lazy-Insertion Dijkstra");
+        int count_input = read_int_with_default("Sources per heap, from the chosen source on [default: 20]: ", 20);
+        if (count_input < 1) count_input = 1;
+        const std::size_t source_count = std::min(static_cast<std::size_t>(count_input), graph.node_count());
+        const AllocatorPolicy allocator = prompt_allocator_policy();
+        bool run_all = prompt_yes_no("Run all heap implementations? [Y/n]: ", true);
+
+        std::vector<LazyComparison> rows;
+        auto run_for_selection = [&](HeapSelection selection) {
+            std::cout << "  • Running " << heap_name(selection) << " eager and lazy..." << std::flush;
+            LazyComparison row;
+            row.heap = selection;
+            row.eager.heap = row.lazy.heap = selection;
+            auto queue = make_queue_adapter(selection, allocator, StatsPolicy::kNone);
+            for (std::size_t offset = 0; offset < source_count; ++offset) {
+                const int vertex = static_cast<int>((static_cast<std::size_t>(source) + offset) % graph.node_count());
+                accumulate_aggregate(row.eager, execute_run(graph, vertex, *queue, selection, allocator, nullptr));
+                accumulate_aggregate(row.lazy, execute_run(graph, vertex, *queue, selection, allocator, nullptr,
+                                                           run_lazy_dijkstra));
+            }
+            std::cout << " done." << std::endl;
+            rows.push_back(row);
+        };
+
+        if (run_all) {
+            for (HeapSelection selection : all_heap_selections()) {
+                run_for_selection(selection);
+            }
+        } else {
+            run_for_selection(prompt_heap_selection());
+        }
+
+        auto default_path = default_lazy_path(dataset, static_cast<std::size_t>(source), source_count);
+        std::string out_path_input = read_line_with_default(
+            "Enter lazy-insertion summary file path [default: " + default_path.string() + "]: ",
+            default_path.string());
+        std::filesystem::path out_path(out_path_input);
+
+        std::string report = format_lazy_table(rows, dataset.name, source_count);
+        std::cout << '\n' << report << std::endl;
+        write_summary_report(report, out_path);
+        std::cout << "Summary written to " << out_path << std::endl;
+        return 0;
     }
 
-    HeapSelection selection = static_cast<HeapSelection>(heap_choice);
+    if (mode_choice == 7) {
+        print_section_header("Point-to-Point Queries");
+        int pair_input = read_int_with_default("Random s-t pairs [default: 200]: ", 200);
+        if (pair_input < 1) pair_input = 1;
+        const auto seed = static_cast<std::uint32_t>(read_int_with_default("Random seed [default: 1]: ", 1));
+        int landmark_input = read_int_with_default("Landmarks for ALT [0 = skip, default: 16]: ", 16);
+        if (landmark_input < 0) landmark_input = 0;
+        LandmarkSelection landmark_selection = LandmarkSelection::kAvoid;
+        if (landmark_input > 0) {
+            const int selection_input =
+                read_int_with_default("Landmark selection [1] farthest, [2] avoid [default: 2]: ", 2);
+            if (selection_input == 1) landmark_selection = LandmarkSelection::kFarthest;
+        }
+        const bool build_hierarchy = prompt_yes_no("Build contraction hierarchies? [Y/n]: ", true);
+        const int hub_input =
+            read_int_with_default("Hub labels [0] skip, [1] degree order, [2] contraction order [default: 2]: ", 2);
+        int region_input = read_int_with_default("Arc-flag regions [0 = skip, default: 32]: ", 32);
+        region_input = std::clamp(region_input, 0, static_cast<int>(ArcFlags::kMaxRegions));
+        PartitionMethod partition = PartitionMethod::kBfsGrown;
+        if (region_input > 0 &&
+            read_int_with_default("Partition [1] BFS-grown, [2] inertial [default: 1]: ", 1) == 2) {
+            if (graph.has_coordinates()) {
+                partition = PartitionMethod::kInertial;
+            } else {
+                std::cout << "No coordinates for an inertial partition. Using BFS-grown regions." << std::endl;
+            }
+        }
+        const AllocatorPolicy allocator = prompt_allocator_policy();
+        bool run_all = prompt_yes_no("Run all heap implementations? [Y/n]: ", true);
+
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> vertex_dist(0, static_cast<int>(graph.node_count()) - 1);
+        std::vector<std::pair<int, int>> pairs(static_cast<std::size_t>(pair_input));
+        for (auto& pair : pairs) {
+            pair = {vertex_dist(rng), vertex_dist(rng)};
+        }
+
+        LandmarkTable landmarks;
+        std::string landmark_note;
+        if (landmark_input > 0) {
+            const auto table_path =
+                default_landmark_path(dataset, static_cast<std::size_t>(landmark_input), landmark_selection);
+            std::ostringstream note;
+            std::error_code ec;
+            if (std::filesystem::exists(table_path, ec)) {
+                try {
+                    landmarks = LandmarkTable::load(table_path.string(), graph);
+                    note << "loaded from " << table_path.string();
+                } catch (const std::exception& ex) {
+                    std::cout << "Ignoring landmark file: " << ex.what() << std::endl;
+                    landmarks = LandmarkTable();
+                }
+            }
+            if (landmarks.empty()) {
+                std::cout << "Building " << landmark_input << " landmarks..." << std::flush;
+                auto queue = make_queue_adapter(HeapSelection::kBinary, allocator, StatsPolicy::kNone);
+                const auto start = std::chrono::steady_clock::now();
+                landmarks = LandmarkTable::build(graph, static_cast<std::size_t>(landmark_input), landmark_selection,
+                                                 *queue, seed);
+                const auto end = std::chrono::steady_clock::now();
+                std::cout << " done." << std::endl;
+                note << "built in " << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+                     << " ms";
+                std::filesystem::create_directories(table_path.parent_path(), ec);
+                try {
+                    landmarks.save(table_path.string());
+                    note << ", saved to " << table_path.string();
+                } catch (const std::exception& ex) {
+                    std::cout << "Landmark table not saved: " << ex.what() << std::endl;
+                }
+            }
+            std::ostringstream line;
+            line << "ALT: " << landmarks.size() << ' '
+                 << (landmarks.selection() == LandmarkSelection::kFarthest ? "farthest" : "avoid")
+                 << " landmarks (" << kActiveLandmarks << " active per query), " << std::fixed
+                 << std::setprecision(1) << static_cast<double>(landmarks.table_bytes()) / (1024.0 * 1024.0)
+                 << " MB table, " << note.str() << ".\n";
+            landmark_note = line.str();
+        }
+
+        HubLabels hub_labels;
+        std::string hub_note;
+        if (hub_input == 1 || hub_input == 2) {
+            const HubOrdering ordering = hub_input == 1 ? HubOrdering::kDegree : HubOrdering::kContraction;
+            const auto label_path = default_hub_label_path(dataset, ordering);
+            std::ostringstream note;
+            std::error_code ec;
+            if (std::filesystem::exists(label_path, ec)) {
+                try {
+                    hub_labels = HubLabels::load(label_path.string(), graph);
+                    note << "loaded from " << label_path.string();
+                } catch (const std::exception& ex) {
+                    std::cout << "Ignoring hub label file: " << ex.what() << std::endl;
+                    hub_labels = HubLabels();
+                }
+            }
+            if (hub_labels.empty()) {
+                std::cout << "Building hub labels..." << std::flush;
+                auto queue = make_queue_adapter(HeapSelection::kBinary, allocator, StatsPolicy::kNone);
+                const auto start = std::chrono::steady_clock::now();
+                hub_labels = HubLabels::build(graph, ordering, *queue);
+                const auto end = std::chrono::steady_clock::now();
+                std::cout << " done." << std::endl;
+                note << "built in " << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+                     << " ms";
+                std::filesystem::create_directories(label_path.parent_path(), ec);
+                try {
+                    hub_labels.save(label_path.string());
+                    note << ", saved to " << label_path.string();
+                } catch (const std::exception& ex) {
+                    std::cout << "Hub labels not saved: " << ex.what() << std::endl;
+                }
+            }
+            const double vertices = static_cast<double>(graph.node_count());
+            std::ostringstream line;
+            line << "Hub labels: " << (hub_labels.ordering() == HubOrdering::kDegree ? "degree" : "contraction")
+                 << " order, " << std::fixed << std::setprecision(1)
+                 << static_cast<double>(hub_labels.out_entries()) / vertices << " out + "
+                 << static_cast<double>(hub_labels.in_entries()) / vertices << " in entries per vertex, "
+                 << static_cast<double>(hub_labels.label_bytes()) / (1024.0 * 1024.0) << " MB, " << note.str()
+                 << ".\n";
+            hub_note = line.str();
+        }
+
+        ArcFlags arc_flags;
+        std::string arc_flag_note;
+        if (region_input > 0) {
+            std::cout << "Computing arc flags..." << std::flush;
+            auto queue = make_queue_adapter(HeapSelection::kBinary, allocator, StatsPolicy::kNone);
+            const auto start = std::chrono::steady_clock::now();
+            arc_flags = ArcFlags::build(graph, static_cast<std::size_t>(region_input), partition, *queue, seed);
+            const auto end = std::chrono::steady_clock::now();
+            std::cout << " done." << std::endl;
+            std::ostringstream line;
+            line << "Arc flags: " << arc_flags.region_count() << ' '
+                 << (partition == PartitionMethod::kInertial ? "inertial" : "BFS-grown") << " regions, "
+                 << arc_flags.boundary_count() << " boundary vertices, " << std::fixed << std::setprecision(1)
+                 << 100.0 * arc_flags.flag_density() << "% of flags set, built in "
+                 << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms.\n";
+            arc_flag_note = line.str();
+        }
+
+        std::vector<QueryStats> rows;
+        std::vector<HierarchyStats> hierarchy_rows;
+        auto run_for_selection = [&](HeapSelection selection) {
+            std::cout << "  • Running " << heap_name(selection) << " queries..." << std::flush;
+            auto queue_fwd = make_queue_adapter(selection, allocator, StatsPolicy::kNone);
+            auto queue_bwd = make_queue_adapter(selection, allocator, StatsPolicy::kNone);
+            ContractionHierarchy hierarchy;
+            if (build_hierarchy) {
+                const auto start = std::chrono::steady_clock::now();
+                hierarchy = ContractionHierarchy::build(graph, *queue_fwd);
+                const auto end = std::chrono::steady_clock::now();
+                HierarchyStats prep;
+                prep.heap = selection;
+                prep.prep_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+                prep.shortcuts = hierarchy.build_stats().shortcuts;
+                prep.upward_arcs = hierarchy.upward_arc_count();
+                prep.witness_searches = hierarchy.build_stats().witness_searches;
+                hierarchy_rows.push_back(prep);
+            }
+            QueryStats unidirectional;
+            unidirectional.heap = selection;
+            unidirectional.method = "Dijkstra";
+            QueryStats bidirectional;
+            bidirectional.heap = selection;
+            bidirectional.method = "Bidirectional";
+            QueryStats astar;
+            astar.heap = selection;
+            astar.method = "A*";
+            QueryStats alt;
+            alt.heap = selection;
+            alt.method = "ALT";
+            QueryStats contracted;
+            contracted.heap = selection;
+            contracted.method = "CH";
+            QueryStats labeled;
+            labeled.heap = selection;
+            labeled.method = "Hub labels";
+            QueryStats flagged;
+            flagged.heap = selection;
+            flagged.method = "Arc flags";
+            auto record = [](QueryStats& stats, const PointToPointResult& query, long long ns) {
+                stats.queries++;
+                stats.settled_total += query.settled;
+                stats.total_ns += ns;
+                stats.latency.record(ns);
+            };
+            for (const auto& [s, t] : pairs) {
+                auto start = std::chrono::steady_clock::now();
+                PointToPointResult uni = run_point_to_point(graph, s, t, *queue_fwd);
+                auto mid = std::chrono::steady_clock::now();
+                PointToPointResult bi = run_bidirectional(graph, s, t, *queue_fwd, *queue_bwd);
+                auto end = std::chrono::steady_clock::now();
+                if (uni.distance != bi.distance) {
+                    throw std::runtime_error("bidirectional distance mismatch for " + std::to_string(s) + " -> " +
+                                             std::to_string(t));
+                }
+                record(unidirectional, uni, std::chrono::duration_cast<std::chrono::nanoseconds>(mid - start).count());
+                record(bidirectional, bi, std::chrono::duration_cast<std::chrono::nanoseconds>(end - mid).count());
+                if (graph.has_coordinates()) {
+                    start = std::chrono::steady_clock::now();
+                    PointToPointResult goal = run_astar(graph, s, t, *queue_fwd);
+                    end = std::chrono::steady_clock::now();
+                    if (goal.distance != uni.distance) {
+                        throw std::runtime_error("A* distance mismatch for " + std::to_string(s) + " -> " +
+                                                 std::to_string(t));
+                    }
+                    record(astar, goal, std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+                }
+                if (!landmarks.empty()) {
+                    start = std::chrono::steady_clock::now();
+                    PointToPointResult guided = run_alt(graph, landmarks, s, t, *queue_fwd);
+                    end = std::chrono::steady_clock::now();
+                    if (guided.distance != uni.distance) {
+                        throw std::runtime_error("ALT distance mismatch for " + std::to_string(s) + " -> " +
+                                                 std::to_string(t));
+                    }
+                    record(alt, guided, std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+                }
+                if (build_hierarchy) {
+                    start = std::chrono::steady_clock::now();
+                    PointToPointResult upward = hierarchy.query(s, t, *queue_fwd, *queue_bwd);
+                    end = std::chrono::steady_clock::now();
+                    if (upward.distance != uni.distance) {
+                        throw std::runtime_error("CH distance mismatch for " + std::to_string(s) + " -> " +
+                                                 std::to_string(t));
+                    }
+                    record(contracted, upward,
+                           std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+                }
+                if (!hub_labels.empty()) {
+                    // Distance only: labels keep no paths and settle nothing.
+                    PointToPointResult lookup;
+                    start = std::chrono::steady_clock::now();
+                    lookup.distance = hub_labels.distance(s, t);
+                    end = std::chrono::steady_clock::now();
+                    if (lookup.distance != uni.distance) {
+                        throw std::runtime_error("hub label distance mismatch for " + std::to_string(s) + " -> " +
+                                                 std::to_string(t));
+                    }
+                    record(labeled, lookup, std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+                }
+                if (arc_flags.node_count() > 0) {
+                    start = std::chrono::steady_clock::now();
+                    PointToPointResult pruned = arc_flags.query(s, t, *queue_fwd);
+                    end = std::chrono::steady_clock::now();
+                    if (pruned.distance != uni.distance) {
+                        throw std::runtime_error("arc-flag distance mismatch for " + std::to_string(s) + " -> " +
+                                                 std::to_string(t));
+                    }
+                    record(flagged, pruned, std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+                }
+            }
+            std::cout << " done." << std::endl;
+            rows.push_back(unidirectional);
+            rows.push_back(bidirectional);
+            if (astar.queries > 0) rows.push_back(astar);
+            if (alt.queries > 0) rows.push_back(alt);
+            if (contracted.queries > 0) rows.push_back(contracted);
+            if (labeled.queries > 0) rows.push_back(labeled);
+            if (flagged.queries > 0) rows.push_back(flagged);
+        };
+
+        if (run_all) {
+            for (HeapSelection selection : all_heap_selections()) {
+                run_for_selection(selection);
+            }
+        } else {
+            run_for_selection(prompt_heap_selection());
+        }
+
+        auto default_path = default_query_path(dataset, pairs.size(), seed);
+        std::string out_path_input = read_line_with_default(
+            "Enter query summary file path [default: " + default_path.string() + "]: ",
+            default_path.string());
+        std::filesystem::path out_path(out_path_input);
+
+        std::string report = format_query_table(rows, dataset.name, pairs.size()) + landmark_note + hub_note + arc_flag_note +
+                             format_hierarchy_table(hierarchy_rows, graph.edge_count());
+        std::cout << '\n' << report << std::endl;
+        write_summary_report(report, out_path);
+        std::cout << "Summary written to " << out_path << std::endl;
+        return 0;
+    }
+
+    if (mode_choice == 8) {
+        print_section_header("Customizable Route Planning");
+        int pair_input = read_int_with_default("Random s-t pairs [default: 200]: ", 200);
+        if (pair_input < 1) pair_input = 1;
+        const auto seed = static_cast<std::uint32_t>(read_int_with_default("Random seed [default: 1]: ", 1));
+        const int hardware_threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        int thread_input = read_int_with_default(
+            "Customization threads [default: " + std::to_string(hardware_threads) + "]: ", hardware_threads);
+        if (thread_input < 1) thread_input = 1;
+        const AllocatorPolicy allocator = prompt_allocator_policy();
+        bool run_all = prompt_yes_no("Run all heap implementations? [Y/n]: ", true);
+
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> vertex_dist(0, static_cast<int>(graph.node_count()) - 1);
+        std::vector<std::pair<int, int>> pairs(static_cast<std::size_t>(pair_input));
+        for (auto& pair : pairs) {
+            pair = {vertex_dist(rng), vertex_dist(rng)};
+        }
+
+        // Cells of about 2^7, 2^10 and 2^13 vertices.
+        const std::vector<std::size_t> cell_sizes{std::size_t{1} << 7, std::size_t{1} << 10, std::size_t{1} << 13};
+        std::cout << "Partitioning..." << std::flush;
+        const auto partition_start = std::chrono::steady_clock::now();
+        MultilevelOverlay overlay = MultilevelOverlay::build(graph, cell_sizes, seed);
+        const auto partition_end = std::chrono::steady_clock::now();
+        std::cout << " done." << std::endl;
+        std::ostringstream overlay_note;
+        overlay_note << "Overlay: " << overlay.level_count() << " levels, cells";
+        for (std::size_t level = 0; level < overlay.level_count(); ++level) {
+            overlay_note << (level == 0 ? " " : "/") << overlay.cell_count(level);
+        }
+        overlay_note << ", boundary vertices";
+        for (std::size_t level = 0; level < overlay.level_count(); ++level) {
+            overlay_note << (level == 0 ? " " : "/") << overlay.boundary_count(level);
+        }
+        overlay_note << ", " << overlay.clique_entries() << " clique entries (" << std::fixed << std::setprecision(1)
+                     << static_cast<double>(overlay.clique_entries() * sizeof(long long)) / (1024.0 * 1024.0)
+                     << " MB), partitioned in "
+                     << std::chrono::duration_cast<std::chrono::milliseconds>(partition_end - partition_start).count()
+                     << " ms.\n";
+
+        // The reload scales every weight by a factor in [0.8, 1.2], drawn
+        // in edge order so each heap sees the same new weights.
+        auto reload_weights = [&](Graph& target) {
+            std::mt19937 weight_rng(seed);
+            std::uniform_real_distribution<double> factor(0.8, 1.2);
+            target.reweight([&](int, const GraphEdge& edge) {
+                return static_cast<long long>(std::llround(static_cast<double>(edge.weight) * factor(weight_rng)));
+            });
+        };
+        auto elapsed_ms = [](std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) {
+            return std::chrono::duration<double, std::milli>(end - start).count();
+        };
+
+        std::vector<QueryStats> rows;
+        std::vector<CustomizationStats> customization_rows;
+        auto run_for_selection = [&](HeapSelection selection) {
+            std::cout << "  • Running " << heap_name(selection) << "..." << std::flush;
+            auto queue_fwd = make_queue_adapter(selection, allocator, StatsPolicy::kNone);
+            auto queue_bwd = make_queue_adapter(selection, allocator, StatsPolicy::kNone);
+            CustomizationStats phases;
+            phases.heap = selection;
+            auto start = std::chrono::steady_clock::now();
+            overlay.customize(graph, selection, allocator, static_cast<std::size_t>(thread_input));
+            auto end = std::chrono::steady_clock::now();
+            phases.customize_ms = elapsed_ms(start, end);
+
+            QueryStats unidirectional;
+            unidirectional.heap = selection;
+            unidirectional.method = "Dijkstra";
+            QueryStats bidirectional;
+            bidirectional.heap = selection;
+            bidirectional.method = "Bidirectional";
+            QueryStats overlaid;
+            overlaid.heap = selection;
+            overlaid.method = "CRP";
+            QueryStats reloaded;
+            reloaded.heap = selection;
+            reloaded.method = "CRP reloaded";
+            auto record = [](QueryStats& stats, const PointToPointResult& query, long long ns) {
+                stats.queries++;
+                stats.settled_total += query.settled;
+                stats.total_ns += ns;
+                stats.latency.record(ns);
+            };
+            auto nanoseconds = [](std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to) {
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count();
+            };
+            for (const auto& [s, t] : pairs) {
+                start = std::chrono::steady_clock::now();
+                PointToPointResult uni = run_point_to_point(graph, s, t, *queue_fwd);
+                auto mid = std::chrono::steady_clock::now();
+                PointToPointResult bi = run_bidirectional(graph, s, t, *queue_fwd, *queue_bwd);
+                end = std::chrono::steady_clock::now();
+                record(unidirectional, uni, nanoseconds(start, mid));
+                record(bidirectional, bi, nanoseconds(mid, end));
+                start = std::chrono::steady_clock::now();
+                PointToPointResult multilevel = overlay.query(graph, s, t, *queue_fwd, *queue_bwd);
+                end = std::chrono::steady_clock::now();
+                if (bi.distance != uni.distance || multilevel.distance != uni.distance) {
+                    throw std::runtime_error("CRP distance mismatch for " + std::to_string(s) + " -> " +
+                                             std::to_string(t));
+                }
+                record(overlaid, multilevel, nanoseconds(start, end));
+            }
+
+            Graph live = graph;
+            start = std::chrono::steady_clock::now();
+            reload_weights(live);
+            end = std::chrono::steady_clock::now();
+            phases.reload_ms = elapsed_ms(start, end);
+            start = std::chrono::steady_clock::now();
+            overlay.customize(live, selection, allocator, static_cast<std::size_t>(thread_input));
+            end = std::chrono::steady_clock::now();
+            phases.recustomize_ms = elapsed_ms(start, end);
+            for (const auto& [s, t] : pairs) {
+                start = std::chrono::steady_clock::now();
+                PointToPointResult multilevel = overlay.query(live, s, t, *queue_fwd, *queue_bwd);
+                end = std::chrono::steady_clock::now();
+                if (multilevel.distance != run_point_to_point(live, s, t, *queue_fwd).distance) {
+                    throw std::runtime_error("reloaded CRP distance mismatch for " + std::to_string(s) + " -> " +
+                                             std::to_string(t));
+                }
+                record(reloaded, multilevel, nanoseconds(start, end));
+            }
+            std::cout << " done." << std::endl;
+            rows.push_back(unidirectional);
+            rows.push_back(bidirectional);
+            rows.push_back(overlaid);
+            rows.push_back(reloaded);
+            customization_rows.push_back(phases);
+        };
+
+        if (run_all) {
+            for (HeapSelection selection : all_heap_selections()) {
+                run_for_selection(selection);
+            }
+        } else {
+            run_for_selection(prompt_heap_selection());
+        }
+
+        auto default_path = default_overlay_path(dataset, pairs.size(), seed);
+        std::string out_path_input = read_line_with_default(
+            "Enter CRP summary file path [default: " + default_path.string() + "]: ", default_path.string());
+        std::filesystem::path out_path(out_path_input);
+
+        std::string report = format_query_table(rows, dataset.name, pairs.size()) + overlay_note.str() +
+                             format_customization_table(customization_rows, static_cast<std::size_t>(thread_input));
+        std::cout << '\n' << report << std::endl;
+        write_summary_report(report, out_path);
+        std::cout << "Summary written to " << out_path << std::endl;
+        return 0;
+    }
+
+    if (mode_choice == 9) {
+        print_section_header("Parallel Delta-Stepping");
+        int count_input = read_int_with_default("Sources, from the chosen source on [default: 20]: ", 20);
+        if (count_input < 1) count_input = 1;
+        const std::size_t source_count = std::min(static_cast<std::size_t>(count_input), graph.node_count());
+        const int hardware_threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        int thread_input = read_int_with_default(
+            "Most threads to try [default: " + std::to_string(hardware_threads) + "]: ", hardware_threads);
+        if (thread_input < 1) thread_input = 1;
+        const auto delta_input = static_cast<long long>(std::max(
+            0, read_int_with_default("Bucket width delta [0 = from the weights, default: 0]: ", 0)));
+
+        const DeltaStepping engine = DeltaStepping::build(graph, delta_input);
+        std::vector<int> sources(source_count);
+        for (std::size_t offset = 0; offset < source_count; ++offset) {
+            sources[offset] = static_cast<int>((static_cast<std::size_t>(source) + offset) % graph.node_count());
+        }
+
+        // Baseline distances double as the reference every run must match.
+        std::cout << "  • Running Dijkstra (Binary)..." << std::flush;
+        auto queue = make_queue_adapter(HeapSelection::kBinary, AllocatorPolicy::kNewDelete, StatsPolicy::kNone);
+        std::vector<std::vector<long long>> reference;
+        long long baseline_ns = 0;
+        for (int vertex : sources) {
+            const auto start = std::chrono::steady_clock::now();
+            DijkstraResult run = run_dijkstra(graph, vertex, *queue);
+            const auto end = std::chrono::steady_clock::now();
+            baseline_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+            reference.push_back(std::move(run.distances));
+        }
+        std::cout << " done." << std::endl;
+
+        std::vector<std::size_t> thread_counts;
+        for (std::size_t threads = 1; threads < static_cast<std::size_t>(thread_input); threads *= 2) {
+            thread_counts.push_back(threads);
+        }
+        thread_counts.push_back(static_cast<std::size_t>(thread_input));
+
+        std::vector<DeltaSteppingStats> rows;
+        for (std::size_t threads : thread_counts) {
+            std::cout << "  • Running delta-stepping on " << threads << " thread(s)..." << std::flush;
+            DeltaSteppingStats row;
+            row.threads = threads;
+            for (std::size_t i = 0; i < sources.size(); ++i) {
+                DeltaStepping::RunStats stats;
+                const auto start = std::chrono::steady_clock::now();
+                DijkstraResult run = engine.run(sources[i], threads, &stats);
+                const auto end = std::chrono::steady_clock::now();
+                if (run.distances != reference[i]) {
+                    throw std::runtime_error("delta-stepping distance mismatch from " + std::to_string(sources[i]));
+                }
+                row.runs++;
+                row.total_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+                row.buckets += stats.buckets;
+                row.light_rounds += stats.light_rounds;
+                row.removals += run.metrics.extract_count - run.metrics.stale_extract_count;
+                row.reached += static_cast<std::size_t>(std::count_if(
+                    run.distances.begin(), run.distances.end(), [](long long d) { return d < kInfinity; }));
+            }
+            std::cout << " done." << std::endl;
+            rows.push_back(row);
+        }
+
+        auto default_path = default_delta_path(dataset, static_cast<std::size_t>(source), source_count);
+        std::string out_path_input = read_line_with_default(
+            "Enter delta-stepping summary file path [default: " + default_path.string() + "]: ",
+            default_path.string());
+        std::filesystem::path out_path(out_path_input);
+
+        const double light_fraction =
+            graph.edge_count() == 0 ? 0.0
+                                    : static_cast<double>(engine.light_edge_count()) /
+                                          static_cast<double>(graph.edge_count());
+        std::string report = format_delta_stepping_table(rows, baseline_ns, dataset.name, source_count,
+                                                         engine.delta(), light_fraction);
+        std::cout << '\n' << report << std::endl;
+        write_summary_report(report, out_path);
+        std::cout << "Summary written to " << out_path << std::endl;
+        return 0;
+    }
+
+    if (mode_choice == 10) {
+        print_section_header("Bounded Searches");
+        int query_input = read_int_with_default("Random sources [default: 200]: ", 200);
+        if (query_input < 1) query_input = 1;
+        const auto seed = static_cast<std::uint32_t>(read_int_with_default("Random seed [default: 1]: ", 1));
+        const auto radius = static_cast<long long>(
+            std::max(0, read_int_with_default("Isochrone radius in weight units [default: 2000]: ", 2000)));
+        const auto nearest = static_cast<std::size_t>(
+            std::max(1, read_int_with_default("Nearest vertices for k-nearest [default: 100]: ", 100)));
+        const auto target_count = static_cast<std::size_t>(
+            std::max(1, read_int_with_default("Targets per query, drawn inside the isochrone [default: 8]: ", 8)));
+        const AllocatorPolicy allocator = prompt_allocator_policy();
+        bool run_all = prompt_yes_no("Run all heap implementations? [Y/n]: ", true);
+
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> vertex_dist(0, static_cast<int>(graph.node_count()) - 1);
+        std::vector<int> sources(static_cast<std::size_t>(query_input));
+        for (auto& vertex : sources) {
+            vertex = vertex_dist(rng);
+        }
+
+        // Full searches give the reference answers and each source's targets.
+        std::cout << "Computing reference distances..." << std::flush;
+        std::vector<std::vector<long long>> reference;
+        std::vector<std::vector<int>> targets(sources.size());
+        {
+            auto queue = make_queue_adapter(HeapSelection::kBinary, allocator, StatsPolicy::kNone);
+            for (std::size_t i = 0; i < sources.size(); ++i) {
+                DijkstraResult full = run_dijkstra(graph, sources[i], *queue);
+                std::vector<int> inside;
+                for (std::size_t v = 0; v < graph.node_count(); ++v) {
+                    if (full.distances[v] <= radius) inside.push_back(static_cast<int>(v));
+                }
+                std::shuffle(inside.begin(), inside.end(), rng);
+                inside.resize(std::min(inside.size(), target_count));
+                targets[i] = std::move(inside);
+                reference.push_back(std::move(full.distances));
+            }
+        }
+        std::cout << " done." << std::endl;
+
+        auto check = [&](const BoundedResult& bounded, std::size_t i, std::size_t expected, const char* rule) {
+            bool ok = expected == 0 || bounded.vertices.size() == expected;
+            for (std::size_t j = 0; ok && j < bounded.vertices.size(); ++j) {
+                ok = bounded.distances[j] == reference[i][static_cast<std::size_t>(bounded.vertices[j])];
+            }
+            if (!ok) {
+                throw std::runtime_error(std::string(rule) + " search mismatch from " + std::to_string(sources[i]));
+            }
+        };
+
+        BoundedSearch search(graph);
+        std::vector<BoundedStats> rows;
+        auto run_for_selection = [&](HeapSelection selection) {
+            std::cout << "  • Running " << heap_name(selection) << " searches..." << std::flush;
+            auto queue = make_queue_adapter(selection, allocator, StatsPolicy::kNone);
+            BoundedStats full_stats;
+            full_stats.heap = selection;
+            full_stats.method = "Full Dijkstra";
+            BoundedStats radius_stats;
+            radius_stats.heap = selection;
+            radius_stats.method = "Isochrone";
+            BoundedStats target_stats;
+            target_stats.heap = selection;
+            target_stats.method = "Targets";
+            BoundedStats nearest_stats;
+            nearest_stats.heap = selection;
+            nearest_stats.method = "k-nearest";
+            auto record = [](BoundedStats& stats, std::size_t settled, std::size_t touched, long long ns) {
+                stats.queries++;
+                stats.settled_total += settled;
+                stats.touched_total += touched;
+                stats.total_ns += ns;
+                stats.latency.record(ns);
+            };
+            auto nanoseconds = [](std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to) {
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count();
+            };
+            for (std::size_t i = 0; i < sources.size(); ++i) {
+                const auto& distances = reference[i];
+                auto start = std::chrono::steady_clock::now();
+                DijkstraResult full = run_dijkstra(graph, sources[i], *queue);
+                auto end = std::chrono::steady_clock::now();
+                const auto reached = static_cast<std::size_t>(
+                    std::count_if(full.distances.begin(), full.distances.end(), [](long long d) { return d < kInfinity; }));
+                record(full_stats, reached, reached, nanoseconds(start, end));
+
+                SearchBounds isochrone;
+                isochrone.radius = radius;
+                start = std::chrono::steady_clock::now();
+                BoundedResult bounded = search.run(sources[i], isochrone, *queue);
+                end = std::chrono::steady_clock::now();
+                check(bounded, i,
+                      static_cast<std::size_t>(std::count_if(distances.begin(), distances.end(),
+                                                             [&](long long d) { return d <= radius; })),
+                      "isochrone");
+                record(radius_stats, bounded.vertices.size(), bounded.touched, nanoseconds(start, end));
+
+                SearchBounds many;
+                many.targets = targets[i];
+                start = std::chrono::steady_clock::now();
+                bounded = search.run(sources[i], many, *queue);
+                end = std::chrono::steady_clock::now();
+                check(bounded, i, 0, "target");
+                for (int target : targets[i]) {
+                    if (std::find(bounded.vertices.begin(), bounded.vertices.end(), target) == bounded.vertices.end()) {
+                        throw std::runtime_error("target search missed " + std::to_string(target));
+                    }
+                }
+                record(target_stats, bounded.vertices.size(), bounded.touched, nanoseconds(start, end));
+
+                SearchBounds closest;
+                closest.nearest = nearest;
+                start = std::chrono::steady_clock::now();
+                bounded = search.run(sources[i], closest, *queue);
+                end = std::chrono::steady_clock::now();
+                check(bounded, i, std::min(nearest, reached), "k-nearest");
+                record(nearest_stats, bounded.vertices.size(), bounded.touched, nanoseconds(start, end));
+            }
+            std::cout << " done." << std::endl;
+            rows.push_back(full_stats);
+            rows.push_back(radius_stats);
+            rows.push_back(target_stats);
+            rows.push_back(nearest_stats);
+        };
+
+        if (run_all) {
+            for (HeapSelection selection : all_heap_selections()) {
+                run_for_selection(selection);
+            }
+        } else {
+            run_for_selection(prompt_heap_selection());
+        }
+
+        auto default_path = default_bounded_path(dataset, sources.size(), seed);
+        std::string out_path_input = read_line_with_default(
+            "Enter bounded-search summary file path [default: " + default_path.string() + "]: ",
+            default_path.string());
+        std::filesystem::path out_path(out_path_input);
+
+        std::ostringstream settings;
+        settings << "Radius " << radius << ", " << target_count << " targets inside it, k = " << nearest << ".\n";
+        std::string report = format_bounded_table(rows, dataset.name, sources.size()) + settings.str();
+        std::cout << '\n' << report << std::endl;
+        write_summary_report(report, out_path);
+        std::cout << "Summary written to " << out_path << std::endl;
+        return 0;
+    }
+
+    if (mode_choice == 11) {
+        print_section_header("Multi-Source Dijkstra");
+        const auto seed = static_cast<std::uint32_t>(read_int_with_default("Random seed [default: 1]: ", 1));
+        const int max_offset =
+            std::max(0, read_int_with_default("Largest random source offset [default: 300]: ", 300));
+        const HeapSelection selection = prompt_heap_selection();
+        const AllocatorPolicy allocator = prompt_allocator_policy();
+        auto queue = make_queue_adapter(selection, allocator, StatsPolicy::kNone);
+
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> vertex_dist(0, static_cast<int>(graph.node_count()) - 1);
+        std::uniform_int_distribution<int> offset_dist(0, max_offset);
+        std::vector<MultiSourceStats> rows;
+        for (std::size_t count : {std::size_t{10}, std::size_t{100}, std::size_t{1000}}) {
+            std::vector<SearchSource> sources(std::min(count, graph.node_count()));
+            for (auto& depot : sources) {
+                depot.vertex = vertex_dist(rng);
+                depot.offset = offset_dist(rng);
+            }
+            std::cout << "  • " << sources.size() << " sources: one search..." << std::flush;
+            MultiSourceStats row;
+            row.sources = sources.size();
+            std::vector<int> owners;
+            auto start = std::chrono::steady_clock::now();
+            DijkstraResult multi = run_multi_source_dijkstra(graph, sources, *queue, &owners);
+            auto end = std::chrono::steady_clock::now();
+            row.multi_source_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+            // The per-source sweep is timed with its merge, as callers do it.
+            // Each owner must be a source achieving the minimum.
+            std::cout << " one per source..." << std::flush;
+            std::vector<long long> nearest(graph.node_count(), kInfinity);
+            std::vector<char> owner_checked(graph.node_count(), 0);
+            for (std::size_t i = 0; i < sources.size(); ++i) {
+                start = std::chrono::steady_clock::now();
+                DijkstraResult single = run_dijkstra(graph, sources[i].vertex, *queue);
+                for (std::size_t v = 0; v < graph.node_count(); ++v) {
+                    if (single.distances[v] < kInfinity) {
+                        nearest[v] = std::min(nearest[v], single.distances[v] + sources[i].offset);
+                    }
+                }
+                end = std::chrono::steady_clock::now();
+                row.per_source_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+                for (std::size_t v = 0; v < graph.node_count(); ++v) {
+                    if (owners[v] == static_cast<int>(i) && single.distances[v] < kInfinity &&
+                        single.distances[v] + sources[i].offset == multi.distances[v]) {
+                        owner_checked[v] = 1;
+                    }
+                }
+            }
+            std::vector<std::size_t> cell_sizes(sources.size(), 0);
+            for (std::size_t v = 0; v < graph.node_count(); ++v) {
+                if (nearest[v] != multi.distances[v] || (owners[v] >= 0) != (owner_checked[v] != 0)) {
+                    throw std::runtime_error("multi-source mismatch at vertex " + std::to_string(v));
+                }
+                if (owners[v] < 0) {
+                    row.unreached++;
+                } else {
+                    cell_sizes[static_cast<std::size_t>(owners[v])]++;
+                }
+            }
+            row.largest_cell = *std::max_element(cell_sizes.begin(), cell_sizes.end());
+            std::cout << " done." << std::endl;
+            rows.push_back(row);
+        }
+
+        auto default_path = default_multi_source_path(dataset, seed);
+        std::string out_path_input = read_line_with_default(
+            "Enter multi-source summary file path [default: " + default_path.string() + "]: ",
+            default_path.string());
+        std::filesystem::path out_path(out_path_input);
+
+        std::ostringstream settings;
+        settings << "Random sources with offsets in [0, " << max_offset
+                 << "]; per-source times include merging by minimum.\n";
+        std::string report = format_multi_source_table(rows, dataset.name, selection) + settings.str();
+        std::cout << '\n' << report << std::endl;
+        write_summary_report(report, out_path);
+        std::cout << "Summary written to " << out_path << std::endl;
+        return 0;
+    }
+
+    HeapSelection selection = prompt_heap_selection();
+    const AllocatorPolicy allocator = prompt_allocator_policy();
     DijkstraResult result;
-    RunSummary summary = execute_run(graph, source, selection, &result);
+    RunSummary summary = execute_run(graph, source, selection, allocator, &result);
 
     print_section_header("Run Summary");
     std::cout << "Heap type      : " << heap_name(selection) << std::endl;
+    std::cout << "Allocator      : " << allocator_name(allocator) << std::endl;
     std::cout << "Source vertex  : " << source << std::endl;
     std::cout << "Reachable nodes: " << summary.reachable_nodes << " / " << graph.node_count() << std::endl;
     if (summary.farthest_node >= 0) {
@@ -900,11 +2942,17 @@ int main(int argc, char** argv) try {
               << " avg " << average_us(metrics.decrease_time_ns, metrics.decrease_count) << " us" << std::endl;
     std::cout << "Extract ops  : " << metrics.extract_count
               << " avg " << average_us(metrics.extract_time_ns, metrics.extract_count) << " us" << std::endl;
+    if (selection == HeapSelection::kAdaptive) {
+        std::cout << "Migrations   : " << metrics.migration_count << " ("
+                  << average_us(metrics.migration_time_ns, 1) << " us)" << std::endl;
+    }
 
     std::cout << "(Dijkstra already processed the full dataset; the next prompt only controls how many results to display.)" << std::endl;
 
     print_subsection_header("Structural Metrics");
     print_structure_metrics(summary.structure);
+    std::cout << "Node allocs    : " << summary.allocation.allocations
+              << " (system " << summary.allocation.system_allocations << ")" << std::endl;
 
     std::cout.unsetf(std::ios::floatfield);
     std::cout << std::setprecision(6);